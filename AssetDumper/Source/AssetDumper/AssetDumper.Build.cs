@@ -69,5 +69,10 @@ public class AssetDumper : ModuleRules
 	        PrivateDependencyModuleNames.Add("SML");
 	        PublicDefinitions.Add("METHOD_PATCHING_SUPPORTED=1");
         }
+
+        //Serializers are hot paths of both dumping and generation, so they are only built unoptimized when explicitly requested
+        if (Environment.GetEnvironmentVariable("ASSET_DUMPER_DEBUG_SERIALIZERS") == "1") {
+	        PublicDefinitions.Add("ASSET_DUMPER_DEBUG_SERIALIZERS=1");
+        }
     }
 }
@@ -1,5 +1,6 @@
 #include "AssetDumperModule.h"
 #include "Toolkit/AssetDumping/AssetDumperCommands.h"
+#include "Toolkit/PropertySerializer.h"
 
 #if METHOD_PATCHING_SUPPORTED
 #include "Patching/NativeHookManager.h"
@@ -9,6 +10,7 @@ DEFINE_LOG_CATEGORY(LogAssetDumper)
 
 void FAssetDumperModule::StartupModule() {
 	UE_LOG(LogAssetDumper, Log, TEXT("Starting up asset dumper plugin"));
+	FStructSerializationPlanCache::Get().Initialize();
 	
 	if (!GIsEditor) {
 		EnableGlobalStaticMeshCPUAccess();
@@ -22,6 +24,7 @@ void FAssetDumperModule::StartupModule() {
 }
 
 void FAssetDumperModule::ShutdownModule() {
+	FStructSerializationPlanCache::Get().Shutdown();
 }
 
 void FAssetDumperModule::EnableGlobalStaticMeshCPUAccess() {
@@ -0,0 +1,46 @@
+#include "Toolkit/AssetDumping/AssetDumpBlobStore.h"
+#include "AssetDumperModule.h"
+#include "HAL/FileManager.h"
+
+FAssetDumpBlobStore::FAssetDumpBlobStore(const FString& RootDirectory) {
+	this->RootDirectory = RootDirectory;
+}
+
+FString FAssetDumpBlobStore::MakeBlobFileName(const FString& ContentHash, const FString& Extension) {
+	//Split blobs into the sub directories by the first hash byte, so we do not end up with a single huge directory
+	const FString BlobFileName = FString::Printf(TEXT("%s.%s"), *ContentHash, *Extension);
+	return FPaths::Combine(ASSET_DUMP_BLOB_DIRECTORY_NAME, ContentHash.Left(2), BlobFileName);
+}
+
+FString FAssetDumpBlobStore::StoreBlobData(const FString& ContentHash, const FString& Extension, const TArray64<uint8>& Data) {
+	const FString BlobFileName = MakeBlobFileName(ContentHash, Extension);
+
+	if (ClaimBlob(BlobFileName)) {
+		//Write into temporary file first, so interrupted dump never leaves a partially written blob behind
+		const FString BlobFilePath = FPaths::Combine(RootDirectory, BlobFileName);
+		const FString TempFilePath = BlobFilePath + TEXT(".tmp");
+		
+		checkf(FFileHelper::SaveArrayToFile(Data, *TempFilePath), TEXT("Failed to write blob file %s"), *TempFilePath);
+		checkf(IFileManager::Get().Move(*BlobFilePath, *TempFilePath), TEXT("Failed to move blob file %s into the blob store"), *BlobFilePath);
+	}
+	return BlobFileName;
+}
+
+bool FAssetDumpBlobStore::ClaimBlob(const FString& BlobFileName) {
+	bool bAlreadyStored;
+	this->StoredBlobsCriticalSection.Lock();
+	this->StoredBlobFileNames.Add(BlobFileName, &bAlreadyStored);
+	this->StoredBlobsCriticalSection.Unlock();
+
+	//Blobs written by the previous dumps into the same directory can be reused too
+	if (!bAlreadyStored && FPlatformFileManager::Get().GetPlatformFile().FileExists(*FPaths::Combine(RootDirectory, BlobFileName))) {
+		bAlreadyStored = true;
+	}
+
+	if (bAlreadyStored) {
+		this->BlobsDeduplicated.Increment();
+		return false;
+	}
+	this->BlobsWritten.Increment();
+	return true;
+}
@@ -78,10 +78,13 @@ FText SAssetDumpConsoleWidget::GetProgressBarText() const {
 				FText::FromString(FString::FromInt(AssetDumpProcessor->GetPackagesProcessed())),
 				FText::FromString(FString::FromInt(AssetDumpProcessor->GetPackagesSkipped())));
 		} else {
-			ProgressBarDisplayText = FText::Format(LOCTEXT("AssetDumping_DumpInProgress", "Dumping in progress: {0}% ({1}/{2})"),
+			const FAssetDumpMemoryStats& MemoryStats = AssetDumpProcessor->GetMemoryStats();
+			ProgressBarDisplayText = FText::Format(LOCTEXT("AssetDumping_DumpInProgress", "Dumping in progress: {0}% ({1}/{2}), memory used: {3}MB/{4}MB"),
 				FText::FromString(FString::FromInt(FMath::RoundToInt(AssetDumpProcessor->GetProgressPct() * 100))),
 				FText::FromString(FString::FromInt(AssetDumpProcessor->GetPackagesSkipped() + AssetDumpProcessor->GetPackagesProcessed())),
-				FText::FromString(FString::FromInt(AssetDumpProcessor->GetTotalPackages())));
+				FText::FromString(FString::FromInt(AssetDumpProcessor->GetTotalPackages())),
+				FText::FromString(FString::FromInt(MemoryStats.UsedPhysicalMemory / (1024 * 1024))),
+				FText::FromString(FString::FromInt(MemoryStats.MemoryBudget / (1024 * 1024))));
 		}
 	}
 	return ProgressBarDisplayText;
@@ -0,0 +1,248 @@
+#include "Toolkit/AssetDumping/AssetDumpManifest.h"
+#include "AssetDumperModule.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Util/JsonFileWriter.h"
+
+#define ASSET_DUMP_MANIFEST_VERSION 2
+
+/** Returns parent path of the provided package path, e.g /Game/Path -> /Game, /Game -> / */
+FString GetParentPackagePath(const FString& PackagePath) {
+	int32 LastSlashIndex;
+	if (PackagePath.FindLastChar(TEXT('/'), LastSlashIndex) && LastSlashIndex > 0) {
+		return PackagePath.Left(LastSlashIndex);
+	}
+	return TEXT("/");
+}
+
+FAssetDumpManifestEntry::FAssetDumpManifestEntry() : DumpFileSize(0), SerializerVersion(0) {
+}
+
+FAssetDumpManifest::FAssetDumpManifest() : bPathIndicesDirty(true) {
+}
+
+void FAssetDumpManifest::AddEntry(const FAssetDumpManifestEntry& Entry) {
+	this->Entries.Add(Entry.PackageName, Entry);
+	this->bPathIndicesDirty = true;
+}
+
+void FAssetDumpManifest::RemoveEntry(FName PackageName) {
+	if (Entries.Remove(PackageName)) {
+		this->bPathIndicesDirty = true;
+	}
+}
+
+void FAssetDumpManifest::GetPathContents(const FString& PackagePath, TArray<FString>& OutChildPaths, TArray<FName>& OutPackageNames) {
+	if (bPathIndicesDirty) {
+		RebuildPathIndices();
+	}
+
+	const TSet<FString>* ChildPaths = ChildPackagePaths.Find(PackagePath);
+	if (ChildPaths != NULL) {
+		OutChildPaths.Append(ChildPaths->Array());
+	}
+	const TArray<FName>* Packages = PackagesInPath.Find(PackagePath);
+	if (Packages != NULL) {
+		OutPackageNames.Append(*Packages);
+	}
+}
+
+void FAssetDumpManifest::RebuildPathIndices() {
+	this->ChildPackagePaths.Empty();
+	this->PackagesInPath.Empty();
+
+	for (const TPair<FName, FAssetDumpManifestEntry>& Pair : Entries) {
+		FString CurrentPath = GetParentPackagePath(Pair.Key.ToString());
+		PackagesInPath.FindOrAdd(CurrentPath).Add(Pair.Key);
+
+		//Register path in all of it's parents, stopping as soon as we find one that is already registered
+		while (CurrentPath != TEXT("/")) {
+			const FString ParentPath = GetParentPackagePath(CurrentPath);
+			TSet<FString>& ParentChildPaths = ChildPackagePaths.FindOrAdd(ParentPath);
+
+			if (ParentChildPaths.Contains(CurrentPath)) {
+				break;
+			}
+			ParentChildPaths.Add(CurrentPath);
+			CurrentPath = ParentPath;
+		}
+	}
+
+	//Sort packages so listing order is stable between runs
+	for (TPair<FString, TArray<FName>>& Pair : PackagesInPath) {
+		Pair.Value.Sort([](const FName& A, const FName& B) { return A.LexicalLess(B); });
+	}
+	this->bPathIndicesDirty = false;
+}
+
+FString FAssetDumpManifest::GetDumpFilePath(const FString& RootDirectory, const FAssetDumpManifestEntry& Entry) {
+	FString PackagePath = FPackageName::GetLongPackagePath(Entry.PackageName.ToString());
+	PackagePath.RemoveAt(0);
+	return FPaths::Combine(RootDirectory, PackagePath, Entry.DumpFileName);
+}
+
+FString FAssetDumpManifest::GetManifestFilePath(const FString& RootDirectory) {
+	return FPaths::Combine(RootDirectory, ASSET_DUMP_MANIFEST_FILE_NAME);
+}
+
+FString FAssetDumpManifest::GetCheckpointFilePath(const FString& RootDirectory) {
+	return FPaths::Combine(RootDirectory, ASSET_DUMP_MANIFEST_CHECKPOINT_FILE_NAME);
+}
+
+TSharedPtr<FAssetDumpManifest> FAssetDumpManifest::LoadFromDirectory(const FString& RootDirectory, bool bAllowCheckpoint) {
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString ManifestFilePath = GetManifestFilePath(RootDirectory);
+	
+	if (PlatformFile.FileExists(*ManifestFilePath)) {
+		return LoadFromFile(ManifestFilePath);
+	}
+
+	const FString CheckpointFilePath = GetCheckpointFilePath(RootDirectory);
+	if (bAllowCheckpoint && PlatformFile.FileExists(*CheckpointFilePath)) {
+		return LoadFromFile(CheckpointFilePath);
+	}
+	return NULL;
+}
+
+TSharedPtr<FAssetDumpManifest> FAssetDumpManifest::LoadFromFile(const FString& ManifestFilePath) {
+	FString ManifestFileContents;
+	if (!FFileHelper::LoadFileToString(ManifestFileContents, *ManifestFilePath)) {
+		UE_LOG(LogAssetDumper, Error, TEXT("Failed to load asset dump manifest %s"), *ManifestFilePath);
+		return NULL;
+	}
+
+	TSharedPtr<FJsonObject> RootObject;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(ManifestFileContents), RootObject)) {
+		UE_LOG(LogAssetDumper, Error, TEXT("Failed to parse asset dump manifest %s: invalid json"), *ManifestFilePath);
+		return NULL;
+	}
+	ManifestFileContents.Empty();
+
+	const int32 ManifestVersion = RootObject->GetIntegerField(TEXT("ManifestVersion"));
+	if (ManifestVersion > ASSET_DUMP_MANIFEST_VERSION) {
+		UE_LOG(LogAssetDumper, Warning, TEXT("Ignoring asset dump manifest %s of unsupported version %d"), *ManifestFilePath, ManifestVersion);
+		return NULL;
+	}
+
+	const TSharedPtr<FAssetDumpManifest> Manifest = MakeShareable(new FAssetDumpManifest());
+
+	for (const TSharedPtr<FJsonValue>& PackageValue : RootObject->GetArrayField(TEXT("Packages"))) {
+		const TSharedPtr<FJsonObject> PackageObject = PackageValue->AsObject();
+		FAssetDumpManifestEntry Entry;
+
+		Entry.PackageName = *PackageObject->GetStringField(TEXT("PackageName"));
+		Entry.AssetClass = *PackageObject->GetStringField(TEXT("AssetClass"));
+		Entry.DumpFileName = PackageObject->GetStringField(TEXT("DumpFile"));
+		Entry.DumpFileSize = (int64) PackageObject->GetNumberField(TEXT("DumpFileSize"));
+		Entry.DumpFileHash = PackageObject->GetStringField(TEXT("DumpFileHash"));
+
+		for (const TSharedPtr<FJsonValue>& SideFileValue : PackageObject->GetArrayField(TEXT("SideFiles"))) {
+			Entry.SideFiles.Add(SideFileValue->AsString());
+		}
+		const TArray<TSharedPtr<FJsonValue>>* BlobFileValues;
+		if (PackageObject->TryGetArrayField(TEXT("BlobFiles"), BlobFileValues)) {
+			for (const TSharedPtr<FJsonValue>& BlobFileValue : *BlobFileValues) {
+				Entry.BlobFiles.Add(BlobFileValue->AsString());
+			}
+		}
+		for (const TSharedPtr<FJsonValue>& ReferencedPackageValue : PackageObject->GetArrayField(TEXT("ReferencedPackages"))) {
+			Entry.ReferencedPackages.Add(*ReferencedPackageValue->AsString());
+		}
+
+		//Manifests written before version 2 have no cooked package hashes, so entries will never be considered up to date
+		PackageObject->TryGetStringField(TEXT("CookedPackageHash"), Entry.CookedPackageHash);
+		PackageObject->TryGetNumberField(TEXT("SerializerVersion"), Entry.SerializerVersion);
+		Manifest->Entries.Add(Entry.PackageName, Entry);
+	}
+
+	UE_LOG(LogAssetDumper, Log, TEXT("Loaded asset dump manifest %s with %d packages"), *ManifestFilePath, Manifest->Entries.Num());
+	return Manifest;
+}
+
+bool FAssetDumpManifest::SaveToDirectory(const FString& RootDirectory) const {
+	return SaveToFile(GetManifestFilePath(RootDirectory));
+}
+
+bool FAssetDumpManifest::SaveCheckpointToDirectory(const FString& RootDirectory) const {
+	return SaveToFile(GetCheckpointFilePath(RootDirectory));
+}
+
+bool FAssetDumpManifest::SaveToFile(const FString& ManifestFilePath) const {
+	const TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*ManifestFilePath));
+	if (!FileWriter.IsValid()) {
+		UE_LOG(LogAssetDumper, Error, TEXT("Failed to open asset dump manifest %s for writing"), *ManifestFilePath);
+		return false;
+	}
+
+	//Write packages sorted by name so manifests of the same dump can be compared
+	TArray<FName> PackageNames;
+	Entries.GenerateKeyArray(PackageNames);
+	PackageNames.Sort([](const FName& A, const FName& B) { return A.LexicalLess(B); });
+
+	const TSharedRef<FJsonFileWriter> Writer = FJsonFileWriterFactory::Create(FileWriter.Get());
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("ManifestVersion"), ASSET_DUMP_MANIFEST_VERSION);
+	Writer->WriteArrayStart(TEXT("Packages"));
+
+	for (const FName& PackageName : PackageNames) {
+		const FAssetDumpManifestEntry& Entry = Entries.FindChecked(PackageName);
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("PackageName"), Entry.PackageName.ToString());
+		Writer->WriteValue(TEXT("AssetClass"), Entry.AssetClass.ToString());
+		Writer->WriteValue(TEXT("DumpFile"), Entry.DumpFileName);
+		Writer->WriteValue(TEXT("DumpFileSize"), (double) Entry.DumpFileSize);
+		Writer->WriteValue(TEXT("DumpFileHash"), Entry.DumpFileHash);
+		Writer->WriteValue(TEXT("CookedPackageHash"), Entry.CookedPackageHash);
+		Writer->WriteValue(TEXT("SerializerVersion"), Entry.SerializerVersion);
+
+		Writer->WriteArrayStart(TEXT("SideFiles"));
+		for (const FString& SideFile : Entry.SideFiles) {
+			Writer->WriteValue(SideFile);
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteArrayStart(TEXT("BlobFiles"));
+		for (const FString& BlobFile : Entry.BlobFiles) {
+			Writer->WriteValue(BlobFile);
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteArrayStart(TEXT("ReferencedPackages"));
+		for (const FName& ReferencedPackage : Entry.ReferencedPackages) {
+			Writer->WriteValue(ReferencedPackage.ToString());
+		}
+		Writer->WriteArrayEnd();
+		Writer->WriteObjectEnd();
+	}
+
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	if (!FileWriter->Close()) {
+		UE_LOG(LogAssetDumper, Error, TEXT("Failed to write asset dump manifest %s"), *ManifestFilePath);
+		return false;
+	}
+	UE_LOG(LogAssetDumper, Display, TEXT("Written asset dump manifest with %d packages to %s"), Entries.Num(), *ManifestFilePath);
+	return true;
+}
+
+void FAssetDumpManifest::DeleteFromDirectory(const FString& RootDirectory) {
+	const FString ManifestFilePath = GetManifestFilePath(RootDirectory);
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	if (PlatformFile.FileExists(*ManifestFilePath)) {
+		PlatformFile.DeleteFile(*ManifestFilePath);
+	}
+}
+
+void FAssetDumpManifest::DeleteCheckpointFromDirectory(const FString& RootDirectory) {
+	const FString CheckpointFilePath = GetCheckpointFilePath(RootDirectory);
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	if (PlatformFile.FileExists(*CheckpointFilePath)) {
+		PlatformFile.DeleteFile(*CheckpointFilePath);
+	}
+}
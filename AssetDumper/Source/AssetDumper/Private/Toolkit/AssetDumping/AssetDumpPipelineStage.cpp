@@ -0,0 +1,83 @@
+#include "Toolkit/AssetDumping/AssetDumpPipelineStage.h"
+#include "Async/Async.h"
+
+FAssetDumpPipelineStage::FAssetDumpPipelineStage(const FString& StageName, int32 MaxWorkers, int32 MaxQueuedPackages, bool bForceSingleThread, FStageFunction StageFunction) {
+	this->StageName = StageName;
+	//Single threaded stages process packages in the thread feeding them, so more than one worker would only nest calls
+	this->MaxWorkers = bForceSingleThread ? 1 : FMath::Max(MaxWorkers, 1);
+	this->MaxQueuedPackages = MaxQueuedPackages;
+	this->bForceSingleThread = bForceSingleThread;
+	this->StageFunction = StageFunction;
+	this->NextStage = NULL;
+	this->PreviousStage = NULL;
+	this->ActiveWorkers = 0;
+}
+
+FAssetDumpPipelineStage::~FAssetDumpPipelineStage() {
+	//Workers reference the stage directly, so it should never be destroyed while they are running
+	checkf(PackagesInStage.GetValue() == 0, TEXT("Asset dump pipeline stage %s destroyed with %d packages still in it"), *StageName, PackagesInStage.GetValue());
+}
+
+void FAssetDumpPipelineStage::SetOutput(FAssetDumpPipelineStage* InNextStage, FStageFunction InOnPackageProcessed) {
+	this->NextStage = InNextStage;
+	this->OnPackageProcessed = InOnPackageProcessed;
+	if (NextStage != NULL) {
+		NextStage->PreviousStage = this;
+	}
+}
+
+void FAssetDumpPipelineStage::EnqueuePackage(FPendingPackageData&& PackageData) {
+	this->PackagesInStage.Increment();
+	
+	this->QueueCriticalSection.Lock();
+	this->QueuedPackages.Add(MoveTemp(PackageData));
+	this->QueueCriticalSection.Unlock();
+
+	StartWorkers();
+}
+
+void FAssetDumpPipelineStage::StartWorkers() {
+	while (true) {
+		this->QueueCriticalSection.Lock();
+		
+		//Do not start processing packages when next stage is full, they will be picked up once it has space again
+		if (QueuedPackages.Num() == 0 || ActiveWorkers >= MaxWorkers || (NextStage != NULL && !NextStage->CanAcceptPackage())) {
+			this->QueueCriticalSection.Unlock();
+			return;
+		}
+		FPendingPackageData PackageData = MoveTemp(QueuedPackages[0]);
+		QueuedPackages.RemoveAt(0, 1, false);
+		this->ActiveWorkers++;
+		
+		this->QueueCriticalSection.Unlock();
+
+		//Single threaded dumping processes packages right in the thread pushing them into the stage
+		if (bForceSingleThread) {
+			ProcessPackage(PackageData);
+			continue;
+		}
+		Async(EAsyncExecution::ThreadPool, [this, PackageData = MoveTemp(PackageData)]() mutable {
+			ProcessPackage(PackageData);
+		});
+	}
+}
+
+void FAssetDumpPipelineStage::ProcessPackage(FPendingPackageData& PackageData) {
+	StageFunction(PackageData);
+
+	//Package data is moved out, so no references to the package will remain in the worker once we are done
+	OnPackageProcessed(PackageData);
+	
+	this->QueueCriticalSection.Lock();
+	this->ActiveWorkers--;
+	this->QueueCriticalSection.Unlock();
+
+	//Worker slot has been freed, so we can take the next package now, and previous stage can push more packages into us
+	StartWorkers();
+	if (PreviousStage != NULL) {
+		PreviousStage->StartWorkers();
+	}
+
+	//Stage is considered empty once this is decremented, so nothing should touch it afterwards, as it might be destroyed already
+	this->PackagesInStage.Decrement();
+}
@@ -1,12 +1,78 @@
 #include "Toolkit/AssetDumping/AssetDumpProcessor.h"
+#include "Async/Async.h"
 #include "Async/ParallelFor.h"
 #include "Toolkit/AssetDumping/AssetTypeSerializer.h"
 #include "Toolkit/AssetDumping/SerializationContext.h"
+#include "Toolkit/AssetDumping/AssetDumpManifest.h"
+#include "Toolkit/AssetDumping/AssetDumpBlobStore.h"
+#include "Toolkit/AssetDumping/AssetDumpPipelineStage.h"
+#include "Toolkit/AssetTypes/FbxMeshExporter.h"
 #include "AssetDumperModule.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "Misc/SecureHash.h"
 
 using FInlinePackageArray = TArray<FPendingPackageData, TInlineAllocator<16>>;
 
 #define DEFAULT_PACKAGES_TO_PROCESS_PER_TICK 16
+#define DEFAULT_MAX_WRITE_WORKERS 4
+#define MANIFEST_CHECKPOINT_INTERVAL 60.0f
+#define COOKED_PACKAGE_HASH_BUFFER_SIZE 65536
+#define DEFAULT_MEMORY_BUDGET_PHYSICAL_MEMORY_FRACTION 0.75
+//Fractions of the memory budget at which throttling starts and garbage collection is performed
+#define MEMORY_BUDGET_THROTTLE_THRESHOLD 0.6f
+#define MEMORY_BUDGET_GARBAGE_COLLECTION_THRESHOLD 0.85f
+//Fraction of the memory budget usage has to grow by since the last garbage collection before another one is performed
+#define MEMORY_BUDGET_GARBAGE_COLLECTION_HYSTERESIS 0.05f
+
+DECLARE_STATS_GROUP(TEXT("AssetDumper"), STATGROUP_AssetDumper, STATCAT_Advanced);
+DECLARE_MEMORY_STAT(TEXT("Memory Budget"), STAT_AssetDumper_MemoryBudget, STATGROUP_AssetDumper);
+DECLARE_MEMORY_STAT(TEXT("Used Physical Memory"), STAT_AssetDumper_UsedPhysicalMemory, STATGROUP_AssetDumper);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Packages In Memory"), STAT_AssetDumper_PackagesInMemory, STATGROUP_AssetDumper);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Max Load Requests In Fly"), STAT_AssetDumper_MaxLoadRequestsInFly, STATGROUP_AssetDumper);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Max Packages Processed Per Tick"), STAT_AssetDumper_MaxPackagesPerTick, STATGROUP_AssetDumper);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Garbage Collections"), STAT_AssetDumper_GarbageCollections, STATGROUP_AssetDumper);
+
+/** Hashes contents of all of the files the cooked package consists of. Returns empty string if package files cannot be found */
+FString ComputeCookedPackageHash(FName PackageName) {
+	FString PackageFilename;
+	if (!FPackageName::DoesPackageExist(PackageName.ToString(), NULL, &PackageFilename)) {
+		return TEXT("");
+	}
+
+	//Cooked packages are split into header, exports and bulk data files, change in any of them means package has changed
+	const FString PackageFilenames[] = {
+		PackageFilename,
+		FPaths::ChangeExtension(PackageFilename, TEXT("uexp")),
+		FPaths::ChangeExtension(PackageFilename, TEXT("ubulk"))
+	};
+	
+	FMD5 HashState;
+	TArray<uint8> Buffer;
+	Buffer.SetNumUninitialized(COOKED_PACKAGE_HASH_BUFFER_SIZE);
+	
+	for (const FString& Filename : PackageFilenames) {
+		const TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*Filename, FILEREAD_Silent));
+		if (!FileReader.IsValid()) {
+			continue;
+		}
+		
+		//Include file size into the hash so contents shifting between files is not missed
+		int64 BytesRemaining = FileReader->TotalSize();
+		HashState.Update((const uint8*) &BytesRemaining, sizeof(BytesRemaining));
+		
+		while (BytesRemaining > 0) {
+			const int64 BytesToRead = FMath::Min<int64>(BytesRemaining, Buffer.Num());
+			FileReader->Serialize(Buffer.GetData(), BytesToRead);
+			HashState.Update(Buffer.GetData(), BytesToRead);
+			BytesRemaining -= BytesToRead;
+		}
+	}
+
+	FMD5Hash ResultHash;
+	ResultHash.Set(HashState);
+	return LexToString(ResultHash);
+}
 
 FAssetDumpSettings::FAssetDumpSettings() :
 		RootDumpDirectory(GetDefaultRootDumpDirectory()),
@@ -14,7 +80,26 @@ FAssetDumpSettings::FAssetDumpSettings() :
         bForceSingleThread(false),
         bOverwriteExistingAssets(true),
 		bExitOnFinish(false),
-		GarbageCollectionInterval(10.0f) {
+		GarbageCollectionInterval(2.0f),
+		MemoryBudgetMB(0),
+		DumpFileFormat(EAssetDumpFileFormat::Json),
+		bUseBlobStore(true),
+		MaxEncodeWorkers(FPlatformMisc::NumberOfWorkerThreadsToSpawn()),
+		MaxWriteWorkers(DEFAULT_MAX_WRITE_WORKERS),
+		PayloadHashAlgorithm(FPayloadHasher::GetDefaultAlgorithm()) {
+}
+
+FAssetDumpMemoryStats::FAssetDumpMemoryStats() :
+		MemoryBudget(0),
+		UsedPhysicalMemory(0),
+		PeakUsedPhysicalMemory(0),
+		PackagesInMemory(0),
+		PeakPackagesInMemory(0),
+		GarbageCollections(0),
+		GarbageCollectionSeconds(0.0),
+		ThrottledTicks(0),
+		CurrentMaxLoadRequestsInFly(0),
+		CurrentMaxPackagesToProcessInOneTick(0) {
 }
 
 FString FAssetDumpSettings::GetDefaultRootDumpDirectory() {
@@ -47,7 +132,10 @@ FAssetDumpProcessor::~FAssetDumpProcessor() {
 	}
 	
 	this->LoadedPackages.Empty();
+	this->WrittenPackages.Empty();
 	this->AssetDataByPackageName.Empty();
+	this->CookedPackageHashes.Empty();
+	this->PendingPackageHashes.Empty();
 	this->PackagesToLoad.Empty();
 }
 
@@ -68,23 +156,68 @@ TSharedRef<FAssetDumpProcessor> FAssetDumpProcessor::StartAssetDump(const FAsset
 }
 
 void FAssetDumpProcessor::Tick(float DeltaTime) {
-	this->TimeSinceGarbageCollection += DeltaTime;
+	UpdateMemoryBudget(DeltaTime);
 
-	//Collect garbage if we exceeded GC interval
-	if (TimeSinceGarbageCollection >= Settings.GarbageCollectionInterval) {
-		UE_LOG(LogAssetDumper, Log, TEXT("Forcing garbage collection (GC interval exceeded)"));
-		this->TimeSinceGarbageCollection = 0.0f;
-		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	//Periodically write manifest checkpoint, so interrupted dumps can be resumed incrementally
+	this->TimeSinceManifestCheckpoint += DeltaTime;
+	if (TimeSinceManifestCheckpoint >= MANIFEST_CHECKPOINT_INTERVAL) {
+		this->TimeSinceManifestCheckpoint = 0.0f;
+		
+		this->DumpManifestCriticalSection.Lock();
+		this->DumpManifest->SaveCheckpointToDirectory(Settings.RootDumpDirectory);
+		this->DumpManifestCriticalSection.Unlock();
+	}
+	
+	//Start hashing cooked files of the upcoming packages ahead of loading them, hashes are only needed before loading when unchanged packages can be skipped
+	//Otherwise hash is computed by the encode stage, so it never stalls loading nor the game thread
+	while (!Settings.bOverwriteExistingAssets &&
+			PendingPackageHashes.Num() < MaxPendingPackageHashes &&
+			CurrentPackageToLoadIndex < PackagesToLoad.Num()) {
+		
+		FPendingPackageHash& PendingPackageHash = PendingPackageHashes.AddDefaulted_GetRef();
+		PendingPackageHash.AssetData = &PackagesToLoad[CurrentPackageToLoadIndex++];
+		
+		const FName PackageName = PendingPackageHash.AssetData->PackageName;
+		if (Settings.bForceSingleThread) {
+			PendingPackageHash.CookedPackageHash = MakeFulfilledPromise<FString>(ComputeCookedPackageHash(PackageName)).GetFuture();
+		} else {
+			PendingPackageHash.CookedPackageHash = Async(EAsyncExecution::ThreadPool, [PackageName]() {
+				return ComputeCookedPackageHash(PackageName);
+			});
+		}
 	}
 	
 	//Load packages as long as we have space in queue + packages to process
 	while (PackageLoadRequestsInFlyCounter.GetValue() < MaxLoadRequestsInFly &&
-			PackagesWaitingForProcessing.GetValue() < MaxPackagesInProcessQueue	&&
-			CurrentPackageToLoadIndex < PackagesToLoad.Num()) {
+			PackagesWaitingForProcessing.GetValue() < MaxPackagesInProcessQueue) {
+		
+		FAssetData* AssetDataToLoadNext;
+		FString CookedPackageHash;
+		
+		if (Settings.bOverwriteExistingAssets) {
+			if (CurrentPackageToLoadIndex >= PackagesToLoad.Num()) {
+				break;
+			}
+			AssetDataToLoadNext = &PackagesToLoad[CurrentPackageToLoadIndex++];
+		} else {
+			//Packages are loaded in order, so wait for the hash of the next one to be ready even if later ones are done already
+			if (PendingPackageHashes.Num() == 0 || !PendingPackageHashes[0].CookedPackageHash.IsReady()) {
+				break;
+			}
+			AssetDataToLoadNext = PendingPackageHashes[0].AssetData;
+			CookedPackageHash = PendingPackageHashes[0].CookedPackageHash.Get();
+			PendingPackageHashes.RemoveAt(0, 1, false);
+			
+			if (IsPackageDumpUpToDate(*AssetDataToLoadNext, CookedPackageHash)) {
+				UE_LOG(LogAssetDumper, Display, TEXT("Skipping dumping asset %s, dump is up to date"), *AssetDataToLoadNext->PackageName.ToString());
+				this->PackagesSkipped.Increment();
+				continue;
+			}
+		}
 		
 		//Associate package data with the package name (so we can find it later in async load request handler and increment counter)
-		FAssetData* AssetDataToLoadNext = &PackagesToLoad[CurrentPackageToLoadIndex++];
 		this->AssetDataByPackageName.Add(AssetDataToLoadNext->PackageName, AssetDataToLoadNext);
+		this->CookedPackageHashes.Add(AssetDataToLoadNext->PackageName, CookedPackageHash);
 		PackageLoadRequestsInFlyCounter.Increment();
 
 		//Start actual async loading of the asset, use our function as handler
@@ -95,10 +228,10 @@ void FAssetDumpProcessor::Tick(float DeltaTime) {
 	FInlinePackageArray PackagesToProcessThisTick;
 	PackagesToProcessThisTick.Reserve(MaxPackagesToProcessInOneTick);
 
-	//Lock packages array and copy elements from it
+	//Lock packages array and copy elements from it, taking no more packages than encode stage can accept
 	this->LoadedPackagesCriticalSection.Lock();
 	
-	const int32 ElementsToCopy = FMath::Min(LoadedPackages.Num(), MaxPackagesToProcessInOneTick);
+	const int32 ElementsToCopy = FMath::Min3(LoadedPackages.Num(), MaxPackagesToProcessInOneTick, EncodeStage->GetFreeSpace());
 	PackagesToProcessThisTick.Append(LoadedPackages.GetData(), ElementsToCopy);
 	LoadedPackages.RemoveAt(0, ElementsToCopy, false);
 	PackagesWaitingForProcessing.Subtract(ElementsToCopy);	
@@ -132,12 +265,43 @@ void FAssetDumpProcessor::Tick(float DeltaTime) {
 		}
 	}
 
+	//Packages are serialized now, so we can release asset objects and hand packages over to the pipeline
+	for (FPendingPackageData& PackageData : PackagesToProcessThisTick) {
+		PackageData.AssetObject->RemoveFromRoot();
+		EncodeStage->EnqueuePackage(MoveTemp(PackageData));
+	}
+	
+	//Stages only pull packages from their queues when next stage has space, so make sure stalled ones are resumed
+	WriteStage->StartWorkers();
+	EncodeStage->StartWorkers();
+
+	//Record packages that went through the whole pipeline
+	FinishWrittenPackages();
+	
 	if (CurrentPackageToLoadIndex >= PackagesToLoad.Num() &&
+		PendingPackageHashes.Num() == 0 &&
 		PackageLoadRequestsInFlyCounter.GetValue() == 0 &&
-		PackagesWaitingForProcessing.GetValue() == 0) {
+		PackagesWaitingForProcessing.GetValue() == 0 &&
+		IsPipelineEmpty()) {
 		UE_LOG(LogAssetDumper, Display, TEXT("Asset dumping finished successfully"));
 		this->bHasFinishedDumping = true;
 
+		//Write manifest now that all of the packages have been dumped
+		DumpManifest->SaveToDirectory(Settings.RootDumpDirectory);
+		FAssetDumpManifest::DeleteCheckpointFromDirectory(Settings.RootDumpDirectory);
+
+		UE_LOG(LogAssetDumper, Display, TEXT("Memory: peak %lluMB of %lluMB budget, peak %d packages in memory, %d garbage collections taking %.2fs, throttled for %d ticks"),
+			MemoryStats.PeakUsedPhysicalMemory / (1024 * 1024), MemoryStats.MemoryBudget / (1024 * 1024), MemoryStats.PeakPackagesInMemory,
+			MemoryStats.GarbageCollections, MemoryStats.GarbageCollectionSeconds, MemoryStats.ThrottledTicks);
+
+		const FFbxExportPoolStats FbxPoolStats = FFbxMeshExporter::GetExportPoolStats();
+		UE_LOG(LogAssetDumper, Display, TEXT("FBX exports: %d reused pooled managers, %d created new ones taking %.2fs"),
+			FbxPoolStats.PoolHits, FbxPoolStats.PoolMisses, FbxPoolStats.ManagerCreationSeconds);
+
+		if (BlobStore.IsValid()) {
+			UE_LOG(LogAssetDumper, Display, TEXT("Written %d blob files, %d identical side files have been deduplicated"), BlobStore->GetBlobsWritten(), BlobStore->GetBlobsDeduplicated());
+		}
+
 		//If we were requested to exit on finish, do it now
 		if (Settings.bExitOnFinish) {
 			UE_LOG(LogAssetDumper, Display, TEXT("Exiting because bExitOnFinish was set to true in asset dumper settings..."));
@@ -185,14 +349,114 @@ void FAssetDumpProcessor::OnPackageLoaded(const FName& PackageName, UPackage* Lo
 void FAssetDumpProcessor::PerformAssetDumpForPackage(const FPendingPackageData& PackageData) {
 	UE_LOG(LogAssetDumper, Display, TEXT("Serializing asset %s"), *PackageData.Package->GetName());
 
-	//Serialize asset, finalize serialization, save data into file
+	//Serialize asset and collect the data that needs UObjects, encoding and writing is done by the pipeline later
 	PackageData.Serializer->SerializeAsset(PackageData.SerializationContext.ToSharedRef());
-	PackageData.SerializationContext->Finalize();
+	PackageData.SerializationContext->FinishSerialization();
+}
 
-	//Unroot object now, we have processed it already and do not need to keep it in memory anymore
-	PackageData.AssetObject->RemoveFromRoot();
+void FAssetDumpProcessor::FinishWrittenPackages() {
+	TArray<FPendingPackageData> PackagesToFinish;
+	
+	this->WrittenPackagesCriticalSection.Lock();
+	PackagesToFinish = MoveTemp(WrittenPackages);
+	this->WrittenPackagesCriticalSection.Unlock();
+
+	//Serialization contexts are released here too, because they need to clean up their UObjects on the game thread
+	for (const FPendingPackageData& PackageData : PackagesToFinish) {
+		FAssetDumpManifestEntry ManifestEntry;
+		PackageData.SerializationContext->CreateManifestEntry(ManifestEntry);
+		ManifestEntry.CookedPackageHash = PackageData.CookedPackageHash;
+		ManifestEntry.SerializerVersion = PackageData.Serializer->GetSerializerVersion();
 	
-	this->PackagesProcessed.Increment();
+		this->DumpManifestCriticalSection.Lock();
+		this->DumpManifest->AddEntry(ManifestEntry);
+		this->DumpManifestCriticalSection.Unlock();
+	
+		this->PackagesProcessed.Increment();
+	}
+}
+
+bool FAssetDumpProcessor::IsPipelineEmpty() {
+	//Packages move to the next stage before leaving the previous one, so stages need to be checked in their order
+	if (EncodeStage->GetPackagesInStage() != 0 || WriteStage->GetPackagesInStage() != 0) {
+		return false;
+	}
+	FScopeLock ScopeLock(&WrittenPackagesCriticalSection);
+	return WrittenPackages.Num() == 0;
+}
+
+void FAssetDumpProcessor::UpdateMemoryBudget(float DeltaTime) {
+	this->TimeSinceGarbageCollection += DeltaTime;
+	this->TimeSinceMemoryTrim += DeltaTime;
+	
+	const int32 PackagesInMemory = PackageLoadRequestsInFlyCounter.GetValue() + PackagesWaitingForProcessing.GetValue();
+	MemoryStats.PackagesInMemory = PackagesInMemory;
+	MemoryStats.PeakPackagesInMemory = FMath::Max(MemoryStats.PeakPackagesInMemory, PackagesInMemory);
+	
+	MemoryStats.UsedPhysicalMemory = FPlatformMemory::GetStats().UsedPhysical;
+	float MemoryBudgetUsage = MemoryStats.UsedPhysicalMemory / (double) MemoryStats.MemoryBudget;
+
+	//Allocator keeps freed pages cached instead of returning them to the OS, so used physical memory stays high after packages are freed
+	//Trim them before trusting the reading that would throttle us, otherwise a single high reading would keep loading throttled for the rest of the dump
+	if (MemoryBudgetUsage >= MEMORY_BUDGET_THROTTLE_THRESHOLD && TimeSinceMemoryTrim >= Settings.GarbageCollectionInterval) {
+		this->TimeSinceMemoryTrim = 0.0f;
+		FMemory::Trim();
+		
+		MemoryStats.UsedPhysicalMemory = FPlatformMemory::GetStats().UsedPhysical;
+		MemoryBudgetUsage = MemoryStats.UsedPhysicalMemory / (double) MemoryStats.MemoryBudget;
+	}
+
+	//Unreferenced packages are only freed by the garbage collector, so collect garbage once we are close to the budget
+	//Memory that garbage collection has not been able to free is not going to be freed by the next one either,
+	//so only collect again once usage has grown noticeably since the last collection
+	const uint64 GarbageCollectionHysteresis = (uint64) (MemoryStats.MemoryBudget * MEMORY_BUDGET_GARBAGE_COLLECTION_HYSTERESIS);
+	if (MemoryBudgetUsage >= MEMORY_BUDGET_GARBAGE_COLLECTION_THRESHOLD && TimeSinceGarbageCollection >= Settings.GarbageCollectionInterval &&
+		MemoryStats.UsedPhysicalMemory >= UsedPhysicalMemoryAfterGarbageCollection + GarbageCollectionHysteresis) {
+		UE_LOG(LogAssetDumper, Log, TEXT("Forcing garbage collection (%.1f%% of the memory budget used)"), MemoryBudgetUsage * 100.0f);
+		this->TimeSinceGarbageCollection = 0.0f;
+		
+		const double GarbageCollectionStartTime = FPlatformTime::Seconds();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		FMemory::Trim();
+		this->TimeSinceMemoryTrim = 0.0f;
+		MemoryStats.GarbageCollectionSeconds += FPlatformTime::Seconds() - GarbageCollectionStartTime;
+		MemoryStats.GarbageCollections++;
+		INC_DWORD_STAT(STAT_AssetDumper_GarbageCollections);
+
+		MemoryStats.UsedPhysicalMemory = FPlatformMemory::GetStats().UsedPhysical;
+		MemoryBudgetUsage = MemoryStats.UsedPhysicalMemory / (double) MemoryStats.MemoryBudget;
+		this->UsedPhysicalMemoryAfterGarbageCollection = MemoryStats.UsedPhysicalMemory;
+	}
+	//Baseline follows memory usage down, so collection is not held back after memory has been freed by other means
+	this->UsedPhysicalMemoryAfterGarbageCollection = FMath::Min(UsedPhysicalMemoryAfterGarbageCollection, MemoryStats.UsedPhysicalMemory);
+	MemoryStats.PeakUsedPhysicalMemory = FMath::Max(MemoryStats.PeakUsedPhysicalMemory, MemoryStats.UsedPhysicalMemory);
+
+	//Scale limits down linearly as we get closer to the budget, but always process at least one package per tick, since processing frees memory
+	const float ThrottleAlpha = FMath::Clamp((MemoryBudgetUsage - MEMORY_BUDGET_THROTTLE_THRESHOLD) / (1.0f - MEMORY_BUDGET_THROTTLE_THRESHOLD), 0.0f, 1.0f);
+	this->MaxPackagesToProcessInOneTick = FMath::Max(FMath::RoundToInt(FMath::Lerp((float) BaseMaxPackagesToProcessInOneTick, 1.0f, ThrottleAlpha)), 1);
+	this->MaxLoadRequestsInFly = FMath::Max(FMath::RoundToInt(FMath::Lerp((float) BaseMaxLoadRequestsInFly, 1.0f, ThrottleAlpha)), 1);
+
+	//Stop loading new packages when we are over the budget, unless nothing that could free memory is left in flight
+	if (MemoryBudgetUsage >= 1.0f) {
+		const bool bHasPackagesInFlight = PackagesInMemory > 0 || !IsPipelineEmpty();
+		this->MaxLoadRequestsInFly = bHasPackagesInFlight ? 0 : 1;
+		
+		if (!bHasPackagesInFlight && !bReportedMemoryBudgetExceeded) {
+			UE_LOG(LogAssetDumper, Warning, TEXT("Memory budget of %lluMB is exceeded without any packages being processed, it is likely too low"), MemoryStats.MemoryBudget / (1024 * 1024));
+			this->bReportedMemoryBudgetExceeded = true;
+		}
+	}
+	if (ThrottleAlpha > 0.0f) {
+		MemoryStats.ThrottledTicks++;
+	}
+	MemoryStats.CurrentMaxLoadRequestsInFly = MaxLoadRequestsInFly;
+	MemoryStats.CurrentMaxPackagesToProcessInOneTick = MaxPackagesToProcessInOneTick;
+
+	SET_MEMORY_STAT(STAT_AssetDumper_MemoryBudget, MemoryStats.MemoryBudget);
+	SET_MEMORY_STAT(STAT_AssetDumper_UsedPhysicalMemory, MemoryStats.UsedPhysicalMemory);
+	SET_DWORD_STAT(STAT_AssetDumper_PackagesInMemory, PackagesInMemory);
+	SET_DWORD_STAT(STAT_AssetDumper_MaxLoadRequestsInFly, MaxLoadRequestsInFly);
+	SET_DWORD_STAT(STAT_AssetDumper_MaxPackagesPerTick, MaxPackagesToProcessInOneTick);
 }
 
 bool FAssetDumpProcessor::IsTickable() const {
@@ -219,35 +483,105 @@ bool FAssetDumpProcessor::CreatePackageData(UPackage* Package, FPendingPackageDa
 	UObject* AssetObject = FSerializationContext::GetAssetObjectFromPackage(Package, *AssetData);
 	checkf(AssetObject, TEXT("Failed to find asset object '%s' inside of the package '%s'"), *AssetData->AssetName.ToString(), *Package->GetPathName());
 
-	const TSharedPtr<FSerializationContext> Context = MakeShareable(new FSerializationContext(Settings.RootDumpDirectory, *AssetData, AssetObject));
-	
-	//Check for existing asset files
-	if (!Settings.bOverwriteExistingAssets) {
-		const FString AssetOutputFile = Context->GetDumpFilePath(TEXT(""), TEXT("json"));
-		
-		//Skip dumping when we have a dump file already and are not allowed to overwrite assets
-		if (FPlatformFileManager::Get().GetPlatformFile().FileExists(*AssetOutputFile)) {
-			UE_LOG(LogAssetDumper, Display, TEXT("Skipping dumping asset %s, dump file is already present and overwriting is not allowed"), *Package->GetName());
-			return false;
-		}
-	}
+	const TSharedPtr<FSerializationContext> Context = MakeShareable(new FSerializationContext(Settings.RootDumpDirectory, *AssetData, AssetObject, Settings.DumpFileFormat, BlobStore, Settings.PayloadHashAlgorithm));
 
 	PendingPackageData.Package = Package;
 	PendingPackageData.AssetObject = AssetObject;
 	PendingPackageData.SerializationContext = Context;
 	PendingPackageData.Serializer = Serializer;
+	PendingPackageData.CookedPackageHash = CookedPackageHashes.FindRef(Package->GetFName());
 	return true;
 }
 
+bool FAssetDumpProcessor::IsPackageDumpUpToDate(const FAssetData& AssetData, const FString& CookedPackageHash) const {
+	//Packages without hash cannot be checked for changes, so always dump them
+	if (Settings.bOverwriteExistingAssets || CookedPackageHash.IsEmpty()) {
+		return false;
+	}
+	
+	const FAssetDumpManifestEntry* ManifestEntry = DumpManifest->FindEntry(AssetData.PackageName);
+	if (ManifestEntry == NULL || ManifestEntry->CookedPackageHash != CookedPackageHash) {
+		return false;
+	}
+
+	//Serializer that is missing will be reported once package is loaded
+	const UAssetTypeSerializer* Serializer = UAssetTypeSerializer::FindSerializerForAssetClass(AssetData.AssetClass);
+	if (Serializer == NULL || ManifestEntry->SerializerVersion != Serializer->GetSerializerVersion()) {
+		return false;
+	}
+
+	//Dump format might have changed since the last dump, or dump file might have been deleted
+	if (FPaths::GetExtension(ManifestEntry->DumpFileName) != FSerializationContext::GetDumpFileExtension(Settings.DumpFileFormat)) {
+		return false;
+	}
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	for (const FString& BlobFile : ManifestEntry->BlobFiles) {
+		if (!PlatformFile.FileExists(*FPaths::Combine(Settings.RootDumpDirectory, BlobFile))) {
+			return false;
+		}
+	}
+	return PlatformFile.FileExists(*FAssetDumpManifest::GetDumpFilePath(Settings.RootDumpDirectory, *ManifestEntry));
+}
+
 void FAssetDumpProcessor::InitializeAssetDump() {
 	this->TimeSinceGarbageCollection = 0.0f;
+	this->TimeSinceMemoryTrim = 0.0f;
+	this->UsedPhysicalMemoryAfterGarbageCollection = 0;
+	this->TimeSinceManifestCheckpoint = 0.0f;
 	this->CurrentPackageToLoadIndex = 0;
 	this->bHasFinishedDumping = false;
 	this->PackagesTotal = PackagesToLoad.Num();
 
-	this->MaxPackagesToProcessInOneTick = Settings.MaxPackagesToProcessInOneTick;
-	this->MaxLoadRequestsInFly = Settings.MaxPackagesToProcessInOneTick;
+	this->BaseMaxPackagesToProcessInOneTick = Settings.MaxPackagesToProcessInOneTick;
+	this->BaseMaxLoadRequestsInFly = Settings.MaxPackagesToProcessInOneTick;
+	this->MaxPackagesToProcessInOneTick = BaseMaxPackagesToProcessInOneTick;
+	this->MaxLoadRequestsInFly = BaseMaxLoadRequestsInFly;
 	this->MaxPackagesInProcessQueue = Settings.MaxPackagesToProcessInOneTick * 2;
+	this->MaxPendingPackageHashes = Settings.MaxPackagesToProcessInOneTick * 2;
+	this->bReportedMemoryBudgetExceeded = false;
+
+	if (Settings.MemoryBudgetMB > 0) {
+		MemoryStats.MemoryBudget = Settings.MemoryBudgetMB * 1024ull * 1024ull;
+	} else {
+		MemoryStats.MemoryBudget = (uint64) (FPlatformMemory::GetConstants().TotalPhysical * DEFAULT_MEMORY_BUDGET_PHYSICAL_MEMORY_FRACTION);
+	}
+
+	//Keep entries of the packages dumped previously, but remove manifest file until we finish,
+	//so interrupted dump will not leave a manifest that is missing packages present on the disk
+	//Checkpoint of the interrupted dump is used when there is no complete manifest, so incremental dump can resume it
+	this->DumpManifest = FAssetDumpManifest::LoadFromDirectory(Settings.RootDumpDirectory, true);
+	if (!DumpManifest.IsValid()) {
+		this->DumpManifest = MakeShareable(new FAssetDumpManifest());
+	}
+	FAssetDumpManifest::DeleteFromDirectory(Settings.RootDumpDirectory);
+
+	if (Settings.bUseBlobStore) {
+		this->BlobStore = MakeShareable(new FAssetDumpBlobStore(Settings.RootDumpDirectory));
+	}
+
+	//Setup pipeline stages processing serialized packages. Encoding side files is CPU bound and writing is IO bound,
+	//so they have separate worker limits, and both apply backpressure to serialization through their queue sizes
+	//Asset dump file itself is streamed to disk by the write stage, so it is never held in memory as a whole
+	this->EncodeStage = MakeUnique<FAssetDumpPipelineStage>(TEXT("Encode"), Settings.MaxEncodeWorkers, MaxPackagesInProcessQueue, Settings.bForceSingleThread,
+		[](FPendingPackageData& PackageData) {
+			//Packages dumped without the up to date check have not been hashed before loading
+			if (PackageData.CookedPackageHash.IsEmpty()) {
+				PackageData.CookedPackageHash = ComputeCookedPackageHash(PackageData.SerializationContext->GetAssetData().PackageName);
+			}
+			PackageData.SerializationContext->EncodeDumpFiles();
+	});
+	this->WriteStage = MakeUnique<FAssetDumpPipelineStage>(TEXT("Write"), Settings.MaxWriteWorkers, MaxPackagesInProcessQueue, Settings.bForceSingleThread,
+		[](FPendingPackageData& PackageData) {
+			PackageData.SerializationContext->WriteDumpFiles();
+	});
+	
+	this->EncodeStage->SetOutput(WriteStage.Get(), [this](FPendingPackageData& PackageData) {
+		WriteStage->EnqueuePackage(MoveTemp(PackageData));
+	});
+	this->WriteStage->SetOutput(NULL, [this](FPendingPackageData& PackageData) {
+		FScopeLock ScopeLock(&WrittenPackagesCriticalSection);
+		this->WrittenPackages.Add(MoveTemp(PackageData));
+	});
 	
 	UE_LOG(LogAssetDumper, Display, TEXT("Starting asset dump of %d packages..."), PackagesTotal);
 }
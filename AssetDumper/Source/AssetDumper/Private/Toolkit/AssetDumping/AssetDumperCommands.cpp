@@ -5,6 +5,7 @@
 #include "Toolkit/AssetDumping/AssetRegistryViewWidget.h"
 #include "Toolkit/AssetDumping/AssetTypeSerializer.h"
 #include "Util/GameEditorHelper.h"
+#include "Util/PayloadHasher.h"
 
 #define LOCTEXT_NAMESPACE "AssetDumper"
 
@@ -84,8 +85,22 @@ void FAssetDumperCommands::DumpAllGameAssets(const FString& Params) {
 	
 	FAssetDumpSettings DumpSettings{};
 	FParse::Value(*Params, TEXT("PackagesPerTick="), DumpSettings.MaxPackagesToProcessInOneTick);
+	FParse::Value(*Params, TEXT("EncodeWorkers="), DumpSettings.MaxEncodeWorkers);
+	FParse::Value(*Params, TEXT("WriteWorkers="), DumpSettings.MaxWriteWorkers);
+	FParse::Value(*Params, TEXT("MemoryBudgetMB="), DumpSettings.MemoryBudgetMB);
 	DumpSettings.bForceSingleThread = !FParse::Param(*Params, TEXT("MultiThreaded"));
 	DumpSettings.bExitOnFinish = FParse::Param(*Params, TEXT("ExitOnFinish"));
+	DumpSettings.bOverwriteExistingAssets = !FParse::Param(*Params, TEXT("Incremental"));
+	DumpSettings.bUseBlobStore = !FParse::Param(*Params, TEXT("NoBlobStore"));
+	if (FParse::Param(*Params, TEXT("BinaryDumpFormat"))) {
+		DumpSettings.DumpFileFormat = EAssetDumpFileFormat::BinaryJson;
+	}
+	{
+		FString PayloadHashAlgorithmName;
+		if (FParse::Value(*Params, TEXT("PayloadHash="), PayloadHashAlgorithmName)) {
+			checkf(FPayloadHasher::FindAlgorithmByName(PayloadHashAlgorithmName, DumpSettings.PayloadHashAlgorithm), TEXT("Unknown payload hash algorithm %s"), *PayloadHashAlgorithmName);
+		}
+	}
 
 	{
 		FString OverrideDumpRootPath;
@@ -122,7 +122,7 @@ TSharedRef<SWidget> SAssetDumperWidget::CreateSettingsCategory() {
         ]
         +SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).VAlign(VAlign_Center)[
         	SNew(SCheckBox)
-        	.ToolTipText(LOCTEXT("AssetDumper_Settings_RegenerateAssets_Tooltip", "When checked, assets that have been dumped before will be overwritten. Otherwise, they are ignored."))
+        	.ToolTipText(LOCTEXT("AssetDumper_Settings_RegenerateAssets_Tooltip", "When checked, assets that have been dumped before will be overwritten. Otherwise, only assets that have changed since the last dump will be dumped again."))
         	.IsChecked_Lambda([this]() {
         		return AssetDumpSettings.bOverwriteExistingAssets ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
         	})
@@ -147,6 +147,23 @@ TSharedRef<SWidget> SAssetDumperWidget::CreateSettingsCategory() {
                 AssetDumpSettings.bForceSingleThread = NewState == ECheckBoxState::Checked;
             })
         ]
+    ]
+	+SVerticalBox::Slot().Padding(FMargin(5.0f, 2.0f)).AutoHeight()[
+        SNew(SHorizontalBox)
+        +SHorizontalBox::Slot().HAlign(HAlign_Left).VAlign(VAlign_Center).Padding(FMargin(0.0f, 0.0f, 2.0f, 0.0f)).AutoWidth()[
+            SNew(STextBlock)
+            .Text(LOCTEXT("AssetDumper_Settings_BinaryDumpFormat", "Write Binary Dump Files"))
+        ]
+        +SHorizontalBox::Slot().AutoWidth().HAlign(HAlign_Left).VAlign(VAlign_Center)[
+            SNew(SCheckBox)
+            .ToolTipText(LOCTEXT("AssetDumper_Settings_BinaryDumpFormat_Tooltip", "When checked, asset dump files are written in the compact binary format instead of json. They are much faster to generate assets from, but are not human readable."))
+            .IsChecked_Lambda([this]() {
+                return AssetDumpSettings.DumpFileFormat == EAssetDumpFileFormat::BinaryJson ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+            })
+            .OnCheckStateChanged_Lambda([this](ECheckBoxState NewState){
+                AssetDumpSettings.DumpFileFormat = NewState == ECheckBoxState::Checked ? EAssetDumpFileFormat::BinaryJson : EAssetDumpFileFormat::Json;
+            })
+        ]
     ]
 	+SVerticalBox::Slot().Padding(FMargin(5.0f, 2.0f)).AutoHeight()[
         SNew(SHorizontalBox)
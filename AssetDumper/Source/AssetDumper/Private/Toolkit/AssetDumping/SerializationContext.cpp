@@ -1,6 +1,12 @@
 #include "Toolkit/AssetDumping/SerializationContext.h"
 #include "Toolkit/ObjectHierarchySerializer.h"
 #include "Toolkit/PropertySerializer.h"
+#include "Util/JsonFileWriter.h"
+#include "Util/BinaryJsonSerializer.h"
+#include "Util/HashingArchiveProxy.h"
+#include "Toolkit/AssetDumping/AssetDumpManifest.h"
+#include "Toolkit/AssetDumping/AssetDumpBlobStore.h"
+#include "HAL/FileManager.h"
 
 UObject* ResolveBlueprintClassAsset(UPackage* Package, const FAssetData& AssetData) {
 	FString GeneratedClassExportedPath;
@@ -22,8 +28,12 @@ UObject* ResolveGenericAsset(UPackage* Package, const FAssetData& AssetData) {
 	return FindObjectFast<UObject>(Package, *AssetData.AssetName.ToString());
 }
 
-FSerializationContext::FSerializationContext(const FString& RootOutputDirectory, const FAssetData& AssetData, UObject* AssetObject) {
+FSerializationContext::FSerializationContext(const FString& RootOutputDirectory, const FAssetData& AssetData, UObject* AssetObject, EAssetDumpFileFormat DumpFileFormat, TSharedPtr<FAssetDumpBlobStore> BlobStore, EPayloadHashAlgorithm PayloadHashAlgorithm) {
 	this->AssetSerializedData = MakeShareable(new FJsonObject());
+	this->DumpFileFormat = DumpFileFormat;
+	this->BlobStore = BlobStore;
+	this->PayloadHashAlgorithm = PayloadHashAlgorithm;
+	this->DumpFileSize = 0;
 	this->PropertySerializer = NewObject<UPropertySerializer>();
 	this->ObjectHierarchySerializer = NewObject<UObjectHierarchySerializer>();
 	this->ObjectHierarchySerializer->SetPropertySerializer(PropertySerializer);
@@ -64,19 +74,167 @@ UObject* FSerializationContext::GetAssetObjectFromPackage(UPackage* Package, con
 	return ResolveGenericAsset(Package, AssetData);
 }
 
-void FSerializationContext::Finalize() const {
-	TSharedRef<FJsonObject> RootObject = MakeShareable(new FJsonObject());
-	RootObject->SetStringField(TEXT("AssetClass"), AssetData.AssetClass.ToString());
-	RootObject->SetStringField(TEXT("AssetPackage"), Package->GetName());
-	RootObject->SetStringField(TEXT("AssetName"), AssetData.AssetName.ToString());
+FString FSerializationContext::GetDumpFileExtension(EAssetDumpFileFormat DumpFileFormat) {
+	return DumpFileFormat == EAssetDumpFileFormat::BinaryJson ? BINARY_JSON_FILE_EXTENSION : TEXT("json");
+}
+
+void FSerializationContext::StoreDumpFileData(const FString& Postfix, const FString& Extension, TFunction<void(TArray64<uint8>& OutData)> DataEncoder) const {
+	FPendingDumpFile& PendingDumpFile = PendingDumpFiles.AddDefaulted_GetRef();
+	PendingDumpFile.Postfix = Postfix;
+	PendingDumpFile.Extension = Extension;
+	PendingDumpFile.DataEncoder = MoveTemp(DataEncoder);
+}
+
+void FSerializationContext::StoreDumpFileData(const FString& Postfix, const FString& Extension, TArray64<uint8>&& Data) const {
+	FPendingDumpFile& PendingDumpFile = PendingDumpFiles.AddDefaulted_GetRef();
+	PendingDumpFile.Postfix = Postfix;
+	PendingDumpFile.Extension = Extension;
+	PendingDumpFile.Data = MoveTemp(Data);
+}
+
+void FSerializationContext::FinishSerialization() {
+	ObjectHierarchySerializer->CollectImportedPackages(ReferencedPackageNames);
+}
+
+void FSerializationContext::EncodeDumpFiles() {
+	//Side files need to be encoded first, because their blob file names are written into the asset dump file
+	for (FPendingDumpFile& PendingDumpFile : PendingDumpFiles) {
+		//Files stored with the already encoded data have no encoder
+		if (PendingDumpFile.DataEncoder) {
+			PendingDumpFile.DataEncoder(PendingDumpFile.Data);
+			PendingDumpFile.DataEncoder = NULL;
+		}
+
+		if (BlobStore.IsValid()) {
+			PendingDumpFile.ContentHash = FPayloadHasher::HashPayload(PendingDumpFile.Data, PayloadHashAlgorithm);
+			const FString BlobFileName = FAssetDumpBlobStore::MakeBlobFileName(PendingDumpFile.ContentHash, PendingDumpFile.Extension);
+			this->BlobFileNames.Add(MakeDumpFileName(PendingDumpFile.Postfix, PendingDumpFile.Extension), BlobFileName);
+		}
+	}
+}
+
+void FSerializationContext::WriteDumpFiles() {
+	for (const FPendingDumpFile& PendingDumpFile : PendingDumpFiles) {
+		if (BlobStore.IsValid()) {
+			BlobStore->StoreBlobData(PendingDumpFile.ContentHash, PendingDumpFile.Extension, PendingDumpFile.Data);
+		} else {
+			const FString OutputFilename = GetDumpFilePath(PendingDumpFile.Postfix, PendingDumpFile.Extension);
+			checkf(FFileHelper::SaveArrayToFile(PendingDumpFile.Data, *OutputFilename), TEXT("Failed to write dump file %s"), *OutputFilename);
+		}
+	}
+	this->PendingDumpFiles.Empty();
+	
+	//Asset dump file is streamed directly to disk, so it never has to be held in memory as a whole
+	const FString OutputFilename = GetAssetDumpFilePath();
+	const TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*OutputFilename));
+	checkf(FileWriter.IsValid(), TEXT("Failed to open dump file %s for writing"), *OutputFilename);
+
+	//Hash file contents as we write them, so manifest does not need to read dump file again
+	FHashingArchiveProxy HashingWriter(*FileWriter);
 	
-	RootObject->SetObjectField(TEXT("AssetSerializedData"), AssetSerializedData);
-	RootObject->SetArrayField(TEXT("ObjectHierarchy"), ObjectHierarchySerializer->FinalizeSerialization());
+	if (DumpFileFormat == EAssetDumpFileFormat::BinaryJson) {
+		WriteBinaryDumpFile(HashingWriter);
+	} else {
+		WriteJsonDumpFile(HashingWriter);
+	}
+
+	this->DumpFileSize = HashingWriter.GetBytesWritten();
+	this->DumpFileHash = HashingWriter.FinalizeHash();
+	checkf(FileWriter->Close(), TEXT("Failed to write dump file %s"), *OutputFilename);
+
+	//Dump file of the other format left by the previous dump would otherwise be picked up by the asset generator instead of this one
+	const EAssetDumpFileFormat OtherDumpFileFormat = DumpFileFormat == EAssetDumpFileFormat::BinaryJson ? EAssetDumpFileFormat::Json : EAssetDumpFileFormat::BinaryJson;
+	//Path is built directly instead of through GetDumpFilePath, so deleted file is not listed among the side files
+	const FString OtherFormatFilename = FPaths::Combine(PackageBaseDirectory, MakeDumpFileName(TEXT(""), GetDumpFileExtension(OtherDumpFileFormat)));
+	IFileManager::Get().Delete(*OtherFormatFilename, false, false, true);
+}
 
-	FString ResultString;
-	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-	FJsonSerializer::Serialize(RootObject, Writer);
+void FSerializationContext::CreateManifestEntry(FAssetDumpManifestEntry& OutManifestEntry) const {
+	OutManifestEntry.PackageName = AssetData.PackageName;
+	OutManifestEntry.AssetClass = AssetData.AssetClass;
+	OutManifestEntry.DumpFileName = MakeDumpFileName(TEXT(""), GetDumpFileExtension(DumpFileFormat));
+	OutManifestEntry.DumpFileSize = DumpFileSize;
+	OutManifestEntry.DumpFileHash = DumpFileHash;
+	OutManifestEntry.SideFiles = SideFileNames;
+	BlobFileNames.GenerateValueArray(OutManifestEntry.BlobFiles);
+
+	OutManifestEntry.ReferencedPackages = ReferencedPackageNames;
+}
+
+FString FSerializationContext::MakeDumpFileName(const FString& Postfix, const FString& Extension) const {
+	FString Filename = FPackageName::GetShortName(GetPackageName());
+		
+	//TODO can we even have multiple assets in one package? what should be the treatment for that case?
+	//We cannot really specify that information inside of the filename because we can lookup entire package by request,
+	//and not just a single asset object, and iterating files to find exact json name is too expensive for massive dumping
+	//As far as I'm aware, package can only contain one asset, because usually it only contains one top level object,
+	//and only top level objects are considered to be assets (so f.e. font-embedded textures do not represent separate assets)
+	//Filename.AppendChar('-').Append(GetAssetName());
+		
+	if (Postfix.Len() > 0) {
+		Filename.AppendChar('-').Append(Postfix);
+	}
+	if (Extension.Len() > 0) {
+		if (Extension[0] != '.')
+			Filename.AppendChar('.');
+		Filename.Append(Extension);
+	}
+	return Filename;
+}
+
+void FSerializationContext::WriteJsonDumpFile(FArchive& FileWriter) {
+	//Stream resulting json directly into the archive instead of building the whole document string first
+	const TSharedRef<FJsonFileWriter> Writer = FJsonFileWriterFactory::Create(&FileWriter);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("AssetClass"), AssetData.AssetClass.ToString());
+	Writer->WriteValue(TEXT("AssetPackage"), AssetData.PackageName.ToString());
+	Writer->WriteValue(TEXT("AssetName"), AssetData.AssetName.ToString());
+	Writer->WriteValue(TEXT("PayloadHashAlgorithm"), FPayloadHasher::GetAlgorithmName(PayloadHashAlgorithm));
+
+	FJsonSerializer::Serialize(MakeShareable(new FJsonValueObject(AssetSerializedData)), TEXT("AssetSerializedData"), Writer, false);
+	this->AssetSerializedData.Reset();
+
+	//Side files stored in the blob store are resolved through this map by the asset generator
+	if (BlobFileNames.Num()) {
+		Writer->WriteObjectStart(TEXT("BlobFiles"));
+		for (const TPair<FString, FString>& Pair : BlobFileNames) {
+			Writer->WriteValue(Pair.Key, Pair.Value);
+		}
+		Writer->WriteObjectEnd();
+	}
+	
+	ObjectHierarchySerializer->FinalizeSerialization(Writer, TEXT("ObjectHierarchy"));
+	Writer->WriteObjectEnd();
+	Writer->Close();
+}
+
+void FSerializationContext::WriteBinaryDumpFile(FArchive& FileWriter) {
+	//Layout matches the json one, AssetClass should always go first so it can be read without reading the whole file
+	FBinaryJsonWriter Writer(FileWriter);
+	Writer.WriteObjectStart();
+	Writer.WriteIdentifier(TEXT("AssetClass"));
+	Writer.WriteString(AssetData.AssetClass.ToString());
+	Writer.WriteIdentifier(TEXT("AssetPackage"));
+	Writer.WriteString(AssetData.PackageName.ToString());
+	Writer.WriteIdentifier(TEXT("AssetName"));
+	Writer.WriteString(AssetData.AssetName.ToString());
+	Writer.WriteIdentifier(TEXT("PayloadHashAlgorithm"));
+	Writer.WriteString(FPayloadHasher::GetAlgorithmName(PayloadHashAlgorithm));
+
+	Writer.WriteIdentifier(TEXT("AssetSerializedData"));
+	Writer.WriteObject(AssetSerializedData.ToSharedRef());
+	this->AssetSerializedData.Reset();
+
+	if (BlobFileNames.Num()) {
+		Writer.WriteIdentifier(TEXT("BlobFiles"));
+		Writer.WriteObjectStart();
+		for (const TPair<FString, FString>& Pair : BlobFileNames) {
+			Writer.WriteIdentifier(Pair.Key);
+			Writer.WriteString(Pair.Value);
+		}
+		Writer.WriteEnd();
+	}
 
-	const FString OutputFilename = GetDumpFilePath(TEXT(""), TEXT("json"));
-	check(FFileHelper::SaveStringToFile(ResultString, *OutputFilename));
+	ObjectHierarchySerializer->FinalizeSerialization(Writer, TEXT("ObjectHierarchy"));
+	Writer.WriteEnd();
 }
@@ -23,14 +23,14 @@ void UAnimationSequenceAssetSerializer::SerializeAsset(TSharedRef<FSerialization
 	Data->SetNumberField(TEXT("SequenceLength"), Asset->SequenceLength);
 
     //Serialize animation data
-    const FString OutFbxFileName = Context->GetDumpFilePath(TEXT(""), TEXT("fbx"));
+    TArray64<uint8> FbxFileData;
     FString OutErrorMessage;
-    const bool bSuccess = FFbxMeshExporter::ExportAnimSequenceIntoFbxFile(Asset, OutFbxFileName, false, &OutErrorMessage);
+    const bool bSuccess = FFbxMeshExporter::ExportAnimSequenceIntoFbxData(Asset, FbxFileData, false, &OutErrorMessage);
     checkf(bSuccess, TEXT("Failed to export anim sequence %s: %s"), *Asset->GetPathName(), *OutErrorMessage);
 
 	//Serialize exported model hash to avoid reading it during generation pass
-	const FMD5Hash ModelFileHash = FMD5Hash::HashFile(*OutFbxFileName);
-	Data->SetStringField(TEXT("ModelFileHash"), LexToString(ModelFileHash));
+	Data->SetStringField(TEXT("ModelFileHash"), FFbxMeshExporter::ComputeFbxFileHash(FbxFileData));
+	Context->StoreDumpFileData(TEXT(""), TEXT("fbx"), MoveTemp(FbxFileData));
 	
     END_ASSET_SERIALIZATION
 }
@@ -38,7 +38,3 @@ void UAnimationSequenceAssetSerializer::SerializeAsset(TSharedRef<FSerialization
 FName UAnimationSequenceAssetSerializer::GetAssetClass() const {
     return UAnimSequence::StaticClass()->GetFName();
 }
-
-bool UAnimationSequenceAssetSerializer::SupportsParallelDumping() const {
-	return false;
-}
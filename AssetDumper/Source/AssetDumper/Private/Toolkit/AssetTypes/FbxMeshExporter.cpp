@@ -1,4 +1,5 @@
 #include "Toolkit/AssetTypes/FbxMeshExporter.h"
+#include "AssetDumperModule.h"
 #include "AnimEncoding.h"
 #include "Rendering/SkeletalMeshLODRenderData.h"
 #include "Rendering/SkeletalMeshRenderData.h"
@@ -6,6 +7,9 @@
 #include "Toolkit/AssetTypes/FbxDataConverter.h"
 #include "Engine/SkeletalMesh.h"
 #include "Engine/StaticMesh.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/ThreadSingleton.h"
+#include "Misc/SecureHash.h"
 
 FString GetNameForUVChannel(uint32 Index) {
     if (Index == 0) {
@@ -33,11 +37,10 @@ FbxManager* AllocateFbxManagerForExport() {
 	return FbxManager;
 }
 
-FbxScene* CreateFbxSceneForFbxManager(FbxManager* FbxManager) {
-	FbxScene* Scene = FbxScene::Create(FbxManager, "");
-	
+void SetupFbxSceneForExport(FbxScene* Scene) {
 	// create scene info
-	FbxDocumentInfo* SceneInfo = FbxDocumentInfo::Create(FbxManager, "SceneInfo");
+	//Allocate scene info inside of the scene so it is destroyed together with it
+	FbxDocumentInfo* SceneInfo = FbxDocumentInfo::Create(Scene, "SceneInfo");
 	SceneInfo->mTitle = "SML FBX Exporter";
 	SceneInfo->mComment = "All rights of exported game assets belong to CoffeeStain Studios. Do not redistribute.";
 	
@@ -50,11 +53,137 @@ FbxScene* CreateFbxSceneForFbxManager(FbxManager* FbxManager) {
 	Scene->GetGlobalSettings().SetOriginalUpAxis(UnrealZUp);
 	Scene->GetGlobalSettings().SetSystemUnit(FbxSystemUnit::cm);
 	Scene->GetGlobalSettings().SetTimeMode(FbxTime::eDefaultMode);
-	
-	return Scene;
 }
 
-bool ExportFbxSceneToFileByPath(const FString& OutFileName, FbxScene* Scene, bool bExportAsText, FString* OutErrorMessage) {
+/** Guards creation and destruction of the fbx managers, since they register themselves in the FBX SDK global state */
+FCriticalSection GFbxManagerLifetimeCriticalSection;
+/** Total time spent creating fbx managers, guarded by the lifetime critical section */
+double GFbxManagerCreationSeconds = 0.0;
+FThreadSafeCounter GFbxManagerPoolHits;
+FThreadSafeCounter GFbxManagerPoolMisses;
+
+/**
+ * Pool of the fbx managers and scenes used by the exports, with one entry per thread
+ * Managers are not thread safe, but separate managers can be used concurrently, so each thread
+ * allocates it's own one once and reuses it for all of the exports, only clearing the scene between them
+ */
+class FThreadFbxManager : public TThreadSingleton<FThreadFbxManager> {
+private:
+	FbxManager* Manager;
+	FbxScene* Scene;
+	bool bHasBeenUsed;
+public:
+	FThreadFbxManager() : Scene(NULL), bHasBeenUsed(false) {
+		FScopeLock ScopeLock(&GFbxManagerLifetimeCriticalSection);
+		const double StartTime = FPlatformTime::Seconds();
+		
+		this->Manager = AllocateFbxManagerForExport();
+		GFbxManagerCreationSeconds += FPlatformTime::Seconds() - StartTime;
+	}
+
+	virtual ~FThreadFbxManager() {
+		FScopeLock ScopeLock(&GFbxManagerLifetimeCriticalSection);
+		this->Manager->Destroy();
+	}
+
+	/** Returns empty scene set up for the export. Scene should be released once export is done */
+	FbxScene* AcquireExportScene() {
+		if (bHasBeenUsed) {
+			GFbxManagerPoolHits.Increment();
+		} else {
+			GFbxManagerPoolMisses.Increment();
+			this->bHasBeenUsed = true;
+		}
+		
+		if (Scene == NULL) {
+			this->Scene = FbxScene::Create(Manager, "");
+		}
+		SetupFbxSceneForExport(Scene);
+		return Scene;
+	}
+
+	/** Destroys all of the objects allocated inside of the scene and restores it's default settings, so it can be reused by the next export */
+	void ReleaseExportScene() {
+		this->Scene->Clear();
+	}
+};
+
+/**
+ * Fbx stream writing exported file into the memory buffer
+ * Binary fbx writer seeks back to patch offsets of the already written data, so buffer supports random access
+ */
+class FMemoryFbxStream : public FbxStream {
+private:
+	TArray64<uint8>& Data;
+	int64 Position;
+	int32 WriterID;
+	EState State;
+	bool bExceededMaxSize;
+public:
+	FMemoryFbxStream(TArray64<uint8>& Data, int32 WriterID) : Data(Data), Position(0), WriterID(WriterID), State(eClosed), bExceededMaxSize(false) {
+	}
+
+	/** FBX SDK tracks stream positions as long, which is 32 bit on Win64, so files past that size cannot be written correctly */
+	FORCEINLINE static int64 GetMaxStreamSize() { return (int64) LONG_MAX; }
+	FORCEINLINE bool HasExceededMaxSize() const { return bExceededMaxSize; }
+
+	virtual EState GetState() override { return State; }
+
+	virtual bool Open(void* pStreamData) override {
+		this->Data.Reset();
+		this->Position = 0;
+		this->State = eOpen;
+		this->bExceededMaxSize = false;
+		return true;
+	}
+
+	virtual bool Close() override {
+		this->State = eClosed;
+		return true;
+	}
+
+	virtual bool Flush() override { return true; }
+
+	virtual int Write(const void* pData, int pSize) override {
+		if (Position + pSize > GetMaxStreamSize()) {
+			this->bExceededMaxSize = true;
+			return 0;
+		}
+		if (Position + pSize > Data.Num()) {
+			Data.SetNumUninitialized(Position + pSize, false);
+		}
+		FMemory::Memcpy(Data.GetData() + Position, pData, pSize);
+		this->Position += pSize;
+		return pSize;
+	}
+
+	virtual int Read(void* pData, int pSize) const override {
+		const int32 BytesRead = (int32) FMath::Clamp(Data.Num() - Position, (int64) 0, (int64) pSize);
+		FMemory::Memcpy(pData, Data.GetData() + Position, BytesRead);
+		const_cast<FMemoryFbxStream*>(this)->Position += BytesRead;
+		return BytesRead;
+	}
+
+	virtual int GetReaderID() const override { return -1; }
+	virtual int GetWriterID() const override { return WriterID; }
+
+	virtual void Seek(const FbxInt64& pOffset, const FbxFile::ESeekPos& pSeekPos) override {
+		switch (pSeekPos) {
+			case FbxFile::eBegin: this->Position = pOffset; break;
+			case FbxFile::eCurrent: this->Position += pOffset; break;
+			case FbxFile::eEnd: this->Position = Data.Num() + pOffset; break;
+		}
+	}
+
+	virtual long GetPosition() const override { return (long) FMath::Min(Position, GetMaxStreamSize()); }
+	virtual void SetPosition(long pPosition) override { this->Position = pPosition; }
+
+	virtual int GetError() const override { return bExceededMaxSize ? 1 : 0; }
+	//Size error is kept, so export can still be failed once exporter is done
+	virtual void ClearError() override {}
+};
+
+bool ExportFbxSceneToMemory(TArray64<uint8>& OutFileData, FbxScene* Scene, bool bExportAsText, FString* OutErrorMessage) {
 	FbxManager* RootManager = Scene->GetFbxManager();
 	FbxExporter* FbxExporter = FbxExporter::Create(RootManager, "");
 	FbxIOSettings* IOSettings = RootManager->GetIOSettings();
@@ -67,35 +196,55 @@ bool ExportFbxSceneToFileByPath(const FString& OutFileName, FbxScene* Scene, boo
 		FileFormat = RootManager->GetIOPluginRegistry()->GetNativeWriterFormat();
 	}
 
-	const FbxString FbxFileName = FFbxDataConverter::ConvertToFbxString(OutFileName);
-	bool bSuccess = FbxExporter->Initialize(FbxFileName, FileFormat, IOSettings);
+	//Export into the memory so file can be hashed and written by the asset dump pipeline without reading it back from the disk
+	FMemoryFbxStream MemoryStream(OutFileData, FileFormat);
+	bool bSuccess = FbxExporter->Initialize(&MemoryStream, NULL, FileFormat, IOSettings);
 	
-	if (!bSuccess) {
-		if (OutErrorMessage) {
-			*OutErrorMessage = UTF8_TO_TCHAR(FbxExporter->GetStatus().GetErrorString());
-		}
-		return false;
-	}
-
 	//Export scene with fbx mesh we created from static mesh
-	bSuccess = FbxExporter->Export(Scene);
-	if (!bSuccess) {
+	if (bSuccess) {
+		bSuccess = FbxExporter->Export(Scene);
+	}
+	//Exporter does not always check the result of the stream writes, so oversized files have to be rejected explicitly
+	if (MemoryStream.HasExceededMaxSize()) {
+		bSuccess = false;
 		if (OutErrorMessage) {
-			*OutErrorMessage = UTF8_TO_TCHAR(FbxExporter->GetStatus().GetErrorString());
+			*OutErrorMessage = FString::Printf(TEXT("Exported FBX file exceeds maximum size of %lld bytes supported by the FBX SDK stream"), FMemoryFbxStream::GetMaxStreamSize());
 		}
-		return false;
+	} else if (!bSuccess && OutErrorMessage) {
+		*OutErrorMessage = UTF8_TO_TCHAR(FbxExporter->GetStatus().GetErrorString());
 	}
-	return true;
+
+	//Exporter is allocated on the manager, which outlives the scene, so it needs to be destroyed explicitly
+	FbxExporter->Destroy();
+	return bSuccess;
+}
+
+FFbxExportPoolStats FFbxMeshExporter::GetExportPoolStats() {
+	FFbxExportPoolStats PoolStats;
+	PoolStats.PoolHits = GFbxManagerPoolHits.GetValue();
+	PoolStats.PoolMisses = GFbxManagerPoolMisses.GetValue();
+
+	GFbxManagerLifetimeCriticalSection.Lock();
+	PoolStats.ManagerCreationSeconds = GFbxManagerCreationSeconds;
+	GFbxManagerLifetimeCriticalSection.Unlock();
+	return PoolStats;
 }
 
-bool FFbxMeshExporter::ExportStaticMeshIntoFbxFile(UStaticMesh* StaticMesh, const FString& OutFileName, const bool bExportAsText, FString* OutErrorMessage) {
+FString FFbxMeshExporter::ComputeFbxFileHash(const TArray64<uint8>& FileData) {
+	FMD5 HashState;
+	HashState.Update(FileData.GetData(), FileData.Num());
+
+	FMD5Hash ResultHash;
+	ResultHash.Set(HashState);
+	return LexToString(ResultHash);
+}
+
+bool FFbxMeshExporter::ExportStaticMeshIntoFbxData(UStaticMesh* StaticMesh, TArray64<uint8>& OutFileData, const bool bExportAsText, FString* OutErrorMessage) {
     //Make sure we either force static mesh data on CPU globally or mesh has it set locally
     check(StaticMesh->bAllowCPUAccess);
-    FbxManager* FbxManager = AllocateFbxManagerForExport();
-    check(FbxManager);
-
-    //Create root scene which we will use to export mesh
-    FbxScene* Scene = CreateFbxSceneForFbxManager(FbxManager);
+    //Acquire root scene which we will use to export mesh from the pool
+    FThreadFbxManager& ThreadFbxManager = FThreadFbxManager::Get();
+    FbxScene* Scene = ThreadFbxManager.AcquireExportScene();
 
     //Create mesh object
 	const FbxString MeshNodeName = FFbxDataConverter::ConvertToFbxString(StaticMesh->GetName());
@@ -108,20 +257,18 @@ bool FFbxMeshExporter::ExportStaticMeshIntoFbxFile(UStaticMesh* StaticMesh, cons
     
     Scene->GetRootNode()->AddChild(MeshNode);
 
-	//Export scene into the file
-	const bool bResult = ExportFbxSceneToFileByPath(OutFileName, Scene, bExportAsText, OutErrorMessage);
+	//Export scene into the file data
+	const bool bResult = ExportFbxSceneToMemory(OutFileData, Scene, bExportAsText, OutErrorMessage);
 
-    //Destroy FbxManager, which will also destroy all objects allocated by it
-    FbxManager->Destroy();
+    //Release objects allocated inside of the scene, scene and manager are reused by the next export on this thread
+    ThreadFbxManager.ReleaseExportScene();
     return bResult;
 }
 
-bool FFbxMeshExporter::ExportSkeletonIntoFbxFile(USkeleton* Skeleton, const FString& OutFileName, bool bExportAsText, FString* OutErrorMessage) {
-	FbxManager* FbxManager = AllocateFbxManagerForExport();
-	check(FbxManager);
-
-	//Create root scene which we will use to export mesh
-	FbxScene* Scene = CreateFbxSceneForFbxManager(FbxManager);
+bool FFbxMeshExporter::ExportSkeletonIntoFbxData(USkeleton* Skeleton, TArray64<uint8>& OutFileData, bool bExportAsText, FString* OutErrorMessage) {
+	//Acquire root scene which we will use to export mesh from the pool
+	FThreadFbxManager& ThreadFbxManager = FThreadFbxManager::Get();
+	FbxScene* Scene = ThreadFbxManager.AcquireExportScene();
 
 	TArray<FbxNode*> BoneNodes;
 
@@ -129,20 +276,18 @@ bool FFbxMeshExporter::ExportSkeletonIntoFbxFile(USkeleton* Skeleton, const FStr
 	FbxNode* SkeletonRootNode = ExportSkeleton(Scene, Skeleton->GetReferenceSkeleton(), BoneNodes);
 	Scene->GetRootNode()->AddChild(SkeletonRootNode);
 
-	//Export scene into the file
-	const bool bResult = ExportFbxSceneToFileByPath(OutFileName, Scene, bExportAsText, OutErrorMessage);
+	//Export scene into the file data
+	const bool bResult = ExportFbxSceneToMemory(OutFileData, Scene, bExportAsText, OutErrorMessage);
 
-	//Destroy FbxManager, which will also destroy all objects allocated by it
-	FbxManager->Destroy();
+	//Release objects allocated inside of the scene, scene and manager are reused by the next export on this thread
+	ThreadFbxManager.ReleaseExportScene();
 	return bResult;
 }
 
-bool FFbxMeshExporter::ExportSkeletalMeshIntoFbxFile(USkeletalMesh* SkeletalMesh, const FString& OutFileName, bool bExportAsText, FString* OutErrorMessage) {
-	FbxManager* FbxManager = AllocateFbxManagerForExport();
-	check(FbxManager);
-
-	//Create root scene which we will use to export mesh
-	FbxScene* Scene = CreateFbxSceneForFbxManager(FbxManager);
+bool FFbxMeshExporter::ExportSkeletalMeshIntoFbxData(USkeletalMesh* SkeletalMesh, TArray64<uint8>& OutFileData, bool bExportAsText, FString* OutErrorMessage) {
+	//Acquire root scene which we will use to export mesh from the pool
+	FThreadFbxManager& ThreadFbxManager = FThreadFbxManager::Get();
+	FbxScene* Scene = ThreadFbxManager.AcquireExportScene();
 
 	//Create a temporary node attach to the scene root.
 	//This will allow us to do the binding without the scene transform (non uniform scale is not supported when binding the skeleton)
@@ -194,20 +339,18 @@ bool FFbxMeshExporter::ExportSkeletalMeshIntoFbxFile(USkeletalMesh* SkeletalMesh
 	Scene->GetRootNode()->RemoveChild(TmpNodeNoTransform);
 	Scene->RemoveNode(TmpNodeNoTransform);
 
-	//Export scene into the file
-	const bool bResult = ExportFbxSceneToFileByPath(OutFileName, Scene, bExportAsText, OutErrorMessage);
+	//Export scene into the file data
+	const bool bResult = ExportFbxSceneToMemory(OutFileData, Scene, bExportAsText, OutErrorMessage);
 
-	//Destroy FbxManager, which will also destroy all objects allocated by it
-	FbxManager->Destroy();
+	//Release objects allocated inside of the scene, scene and manager are reused by the next export on this thread
+	ThreadFbxManager.ReleaseExportScene();
 	return bResult;
 }
 
-bool FFbxMeshExporter::ExportAnimSequenceIntoFbxFile(UAnimSequence* AnimSequence, const FString& OutFileName, bool bExportAsText, FString* OutErrorMessage) {
-	FbxManager* FbxManager = AllocateFbxManagerForExport();
-	check(FbxManager);
-
-	//Create root scene which we will use to export mesh
-	FbxScene* Scene = CreateFbxSceneForFbxManager(FbxManager);
+bool FFbxMeshExporter::ExportAnimSequenceIntoFbxData(UAnimSequence* AnimSequence, TArray64<uint8>& OutFileData, bool bExportAsText, FString* OutErrorMessage) {
+	//Acquire root scene which we will use to export mesh from the pool
+	FThreadFbxManager& ThreadFbxManager = FThreadFbxManager::Get();
+	FbxScene* Scene = ThreadFbxManager.AcquireExportScene();
 
 	//Create FBX animation stack and one base layer
 	FbxAnimStack* AnimStack = FbxAnimStack::Create(Scene, "Unreal Animation Stack");
@@ -248,11 +391,11 @@ bool FFbxMeshExporter::ExportAnimSequenceIntoFbxFile(UAnimSequence* AnimSequence
 	Scene->GetRootNode()->RemoveChild(TmpNodeNoTransform);
 	Scene->RemoveNode(TmpNodeNoTransform);
 
-	//Export scene into the file
-	const bool bResult = ExportFbxSceneToFileByPath(OutFileName, Scene, bExportAsText, OutErrorMessage);
+	//Export scene into the file data
+	const bool bResult = ExportFbxSceneToMemory(OutFileData, Scene, bExportAsText, OutErrorMessage);
 
-	//Destroy FbxManager, which will also destroy all objects allocated by it
-	FbxManager->Destroy();
+	//Release objects allocated inside of the scene, scene and manager are reused by the next export on this thread
+	ThreadFbxManager.ReleaseExportScene();
 	return bResult;
 }
 
@@ -265,6 +408,63 @@ int32 USkeleton_GetCompressedAnimationTrackIndex(const int32 InSkeletonBoneIndex
 	return INDEX_NONE;
 }
 
+/**
+ * Decodes all of the requested compressed animation tracks at once for a single frame into the reusable buffer
+ * GetBoneTransform sets up decompression context, seeks and enters the codec for every track separately,
+ * while here codec decompresses the whole pose with one call per frame
+ */
+class FAnimSequencePoseDecoder {
+private:
+	const UAnimSequence* AnimSequence;
+	BoneTrackArray TrackPairs;
+	TArray<FTransform> DecodedTransforms;
+public:
+	FAnimSequencePoseDecoder(const UAnimSequence* AnimSequence, const TArray<int32>& TrackIndices) : AnimSequence(AnimSequence) {
+		//Atom index is the position of the track in the decoded transform buffer
+		for (int32 i = 0; i < TrackIndices.Num(); i++) {
+			this->TrackPairs.Add(BoneTrackPair(i, TrackIndices[i]));
+		}
+		this->DecodedTransforms.SetNum(TrackIndices.Num());
+	}
+
+	/** Decodes transforms of all tracks at the provided time. Resulting array is ordered the same way as track indices and is reused by the next call */
+	const TArray<FTransform>& DecodePose(float AnimTime) {
+		//Tracks without scale data are not written by the codec, so they should default to identity
+		for (FTransform& Transform : DecodedTransforms) {
+			Transform.SetIdentity();
+		}
+		
+		const FCompressedAnimSequence& CompressedData = AnimSequence->CompressedData;
+		if (CompressedData.BoneCompressionCodec != NULL && CompressedData.CompressedDataStructure.IsValid()) {
+			FAnimSequenceDecompressionContext DecompContext(AnimSequence->SequenceLength, AnimSequence->Interpolation, AnimSequence->GetFName(), *CompressedData.CompressedDataStructure);
+			DecompContext.Seek(AnimTime);
+			
+			TArrayView<FTransform> OutAtoms(DecodedTransforms);
+			CompressedData.BoneCompressionCodec->DecompressPose(DecompContext, TrackPairs, TrackPairs, TrackPairs, OutAtoms);
+		} else {
+			//Fallback to per-track path that handles missing compressed data
+			for (const BoneTrackPair& TrackPair : TrackPairs) {
+				AnimSequence->GetBoneTransform(DecodedTransforms[TrackPair.AtomIndex], TrackPair.TrackIndex, AnimTime, false);
+			}
+		}
+		return DecodedTransforms;
+	}
+};
+
+FVector SanitizeAnimVector(const FVector& Vector) {
+	FVector ResultVector = Vector;
+	if (!FMath::IsFinite(ResultVector.X)) {
+		ResultVector.X = 0.0f;
+	}
+	if (!FMath::IsFinite(ResultVector.Y)) {
+		ResultVector.Y = 0.0f;
+	}
+	if (!FMath::IsFinite(ResultVector.Z)) {
+		ResultVector.Z = 0.0f;
+	}
+	return ResultVector;
+}
+
 void FFbxMeshExporter::ExportAnimSequence(const UAnimSequence* AnimSeq, TArray<FbxNode*>& BoneNodes, USkeletalMesh* SkeletalMesh, FbxAnimStack* AnimStack, FbxAnimLayer* InAnimLayer, float AnimStartOffset, float AnimEndOffset, float AnimPlayRate, float StartTime) {
 	// stack allocator for extracting curve
 	FMemMark Mark(FMemStack::Get());
@@ -289,17 +489,20 @@ void FFbxMeshExporter::ExportAnimSequence(const UAnimSequence* AnimSeq, TArray<F
 		}
 	}
 
+	const double CurveExportStartTime = FPlatformTime::Seconds();
 	ExportCustomAnimCurvesToFbx(CustomCurveMap, AnimSeq, AnimStartOffset, AnimEndOffset, AnimPlayRate, StartTime);
+	const double CurveExportSeconds = FPlatformTime::Seconds() - CurveExportStartTime;
 
-	// Add the animation data to the bone nodes
+	//Create the AnimCurves for each bone, individual curves for translation, rotation and scaling
+	//Only bones that have tracks in this sequence are keyed, but curves are created for all of them
+	const uint32 NumberOfCurves = 9;
+	TArray<FbxAnimCurve*> TrackCurves;
+	TArray<int32> TrackIndices;
+	
 	for(int32 BoneIndex = 0; BoneIndex < BoneNodes.Num(); BoneIndex++) {
 		FbxNode* CurrentBoneNode = BoneNodes[BoneIndex];
-	
-		// Create the AnimCurves
-		const uint32 NumberOfCurves = 9;
 		FbxAnimCurve* Curves[NumberOfCurves];
 		
-		// Individual curves for translation, rotation and scaling
 		Curves[0] = CurrentBoneNode->LclTranslation.GetCurve(InAnimLayer, FBXSDK_CURVENODE_COMPONENT_X, true);
 		Curves[1] = CurrentBoneNode->LclTranslation.GetCurve(InAnimLayer, FBXSDK_CURVENODE_COMPONENT_Y, true);
 		Curves[2] = CurrentBoneNode->LclTranslation.GetCurve(InAnimLayer, FBXSDK_CURVENODE_COMPONENT_Z, true);
@@ -313,73 +516,85 @@ void FFbxMeshExporter::ExportAnimSequence(const UAnimSequence* AnimSeq, TArray<F
 		Curves[8] = CurrentBoneNode->LclScaling.GetCurve(InAnimLayer, FBXSDK_CURVENODE_COMPONENT_Z, true);
 
 		const int32 BoneTreeIndex = SkeletalMesh ? Skeleton->GetSkeletonBoneIndexFromMeshBoneIndex(SkeletalMesh, BoneIndex) : BoneIndex;
-		int32 BoneTrackIndex = USkeleton_GetCompressedAnimationTrackIndex(BoneTreeIndex, AnimSeq);
+		const int32 BoneTrackIndex = USkeleton_GetCompressedAnimationTrackIndex(BoneTreeIndex, AnimSeq);
 		
 		if(BoneTrackIndex == INDEX_NONE) {
 			// If this sequence does not have a track for the current bone, then skip it
 			continue;
 		}
-		
-		for (FbxAnimCurve* Curve : Curves) {
-			Curve->KeyModifyBegin();
-		}
+		TrackIndices.Add(BoneTrackIndex);
+		TrackCurves.Append(Curves, NumberOfCurves);
+	}
 
-		auto SanitizeVector = [](const FVector& Vector) -> FVector {
-			FVector ResultVector = Vector;
-			if (!FMath::IsFinite(ResultVector.X)) {
-				ResultVector.X = 0.0f;
-			}
-			if (!FMath::IsFinite(ResultVector.Y)) {
-				ResultVector.Y = 0.0f;
-			}
-			if (!FMath::IsFinite(ResultVector.Z)) {
-				ResultVector.Z = 0.0f;
-			}
-			return ResultVector;
-		};
+	for (FbxAnimCurve* Curve : TrackCurves) {
+		Curve->KeyModifyBegin();
+	}
+
+	//Keys are always appended in time order, so remembering last key index of each curve lets SDK skip the key search
+	TArray<int32> LastKeyIndices;
+	LastKeyIndices.Init(0, TrackCurves.Num());
 
-		auto ExportLambda = [&](float AnimTime, FbxTime ExportTime, bool bLastKey) {
-			FTransform BoneAtom;
-			AnimSeq->GetBoneTransform(BoneAtom, BoneTrackIndex, AnimTime, false);
+	FAnimSequencePoseDecoder PoseDecoder(AnimSeq, TrackIndices);
+	double PoseDecodeSeconds = 0.0;
+	double KeyWriteSeconds = 0.0;
+	int32 NumFrames = 0;
+
+	auto ExportLambda = [&](float AnimTime, FbxTime ExportTime, bool bLastKey) {
+		const double DecodeStartTime = FPlatformTime::Seconds();
+		const TArray<FTransform>& DecodedPose = PoseDecoder.DecodePose(AnimTime);
+		const double KeyWriteStartTime = FPlatformTime::Seconds();
+		
+		const FbxAnimCurveDef::EInterpolationType Interpolation = bLastKey ? FbxAnimCurveDef::eInterpolationConstant : FbxAnimCurveDef::eInterpolationCubic;
+		
+		for (int32 TrackIndex = 0; TrackIndex < DecodedPose.Num(); TrackIndex++) {
+			const FTransform& BoneAtom = DecodedPose[TrackIndex];
 			
-			const FbxVector4 Translation = FFbxDataConverter::ConvertToFbxPos(SanitizeVector(BoneAtom.GetTranslation()));
-			const FbxVector4 Rotation = FFbxDataConverter::ConvertToFbxRot(SanitizeVector(BoneAtom.GetRotation().Euler()));
-			const FbxVector4 Scale = FFbxDataConverter::ConvertToFbxScale(SanitizeVector(BoneAtom.GetScale3D()));
+			const FbxVector4 Translation = FFbxDataConverter::ConvertToFbxPos(SanitizeAnimVector(BoneAtom.GetTranslation()));
+			const FbxVector4 Rotation = FFbxDataConverter::ConvertToFbxRot(SanitizeAnimVector(BoneAtom.GetRotation().Euler()));
+			const FbxVector4 Scale = FFbxDataConverter::ConvertToFbxScale(SanitizeAnimVector(BoneAtom.GetScale3D()));
 			
 			FbxVector4 Vectors[3] = { Translation, Rotation, Scale };
 
 			// Loop over each curve and channel to set correct values
 			for (uint32 CurveIndex = 0; CurveIndex < 3; ++CurveIndex) {
 				for (uint32 ChannelIndex = 0; ChannelIndex < 3; ++ChannelIndex) {
-					uint32 OffsetCurveIndex = (CurveIndex * 3) + ChannelIndex;
+					const int32 OffsetCurveIndex = TrackIndex * NumberOfCurves + (CurveIndex * 3) + ChannelIndex;
+					FbxAnimCurve* Curve = TrackCurves[OffsetCurveIndex];
 
-					int32 lKeyIndex = Curves[OffsetCurveIndex]->KeyAdd(ExportTime);
-					Curves[OffsetCurveIndex]->KeySetValue(lKeyIndex, Vectors[CurveIndex][ChannelIndex]);
-					Curves[OffsetCurveIndex]->KeySetInterpolation(lKeyIndex, bLastKey ? FbxAnimCurveDef::eInterpolationConstant : FbxAnimCurveDef::eInterpolationCubic);
+					const int32 lKeyIndex = Curve->KeyAdd(ExportTime, &LastKeyIndices[OffsetCurveIndex]);
+					Curve->KeySet(lKeyIndex, ExportTime, Vectors[CurveIndex][ChannelIndex], Interpolation);
 
 					if (bLastKey) {
-						Curves[OffsetCurveIndex]->KeySetConstantMode(lKeyIndex, FbxAnimCurveDef::eConstantStandard);
+						Curve->KeySetConstantMode(lKeyIndex, FbxAnimCurveDef::eConstantStandard);
 					}
 				}
 			}
-		};
+		}
+		
+		const double FrameEndTime = FPlatformTime::Seconds();
+		PoseDecodeSeconds += KeyWriteStartTime - DecodeStartTime;
+		KeyWriteSeconds += FrameEndTime - KeyWriteStartTime;
+		NumFrames++;
+	};
 
-		IterateInsideAnimSequence(AnimSeq, AnimStartOffset, AnimEndOffset, AnimPlayRate, StartTime, ExportLambda);
+	IterateInsideAnimSequence(AnimSeq, AnimStartOffset, AnimEndOffset, AnimPlayRate, StartTime, ExportLambda);
 
-		for (FbxAnimCurve* Curve : Curves) {
-			Curve->KeyModifyEnd();
-		}
+	for (FbxAnimCurve* Curve : TrackCurves) {
+		Curve->KeyModifyEnd();
 	}
+
+	UE_LOG(LogAssetDumper, Verbose, TEXT("Exported animation %s: %d frames, %d tracks, %d curves. Decoding pose %.2fms, writing keys %.2fms, curves %.2fms"),
+		*AnimSeq->GetPathName(), NumFrames, TrackIndices.Num(), CustomCurveMap.Num(), PoseDecodeSeconds * 1000.0, KeyWriteSeconds * 1000.0, CurveExportSeconds * 1000.0);
 }
 
 bool FFbxMeshExporter::SetupAnimStack(const UAnimSequence* AnimSequence, FbxAnimStack* AnimStack) {
 	check(AnimSequence->SequenceLength > 0.0f);
 	const float FrameRate = FMath::TruncToFloat(((AnimSequence->GetRawNumberOfFrames() - 1) / AnimSequence->SequenceLength) + 0.5f);
 
-	//Configure the scene time line
+	//Configure the scene time line. Time mode is only stored in the scene settings and never set globally on the SDK,
+	//since animations are exported concurrently. Every FbxTime is built from seconds, which does not depend on the time mode
 	FbxGlobalSettings& SceneGlobalSettings = AnimStack->GetScene()->GetGlobalSettings();
 	const FbxTime::EMode ComputeTimeMode = FbxTime::ConvertFrameRateToTimeMode(FrameRate);
-	FbxTime::SetGlobalTimeMode(ComputeTimeMode, ComputeTimeMode == FbxTime::eCustom ? FrameRate : 0.0);
 	SceneGlobalSettings.SetTimeMode(ComputeTimeMode);
 	
 	if (ComputeTimeMode == FbxTime::eCustom) {
@@ -451,21 +666,38 @@ void FFbxMeshExporter::ExportCustomAnimCurvesToFbx(const TMap<FName, FbxAnimCurv
 		CustomCurve.Value->KeyModifyBegin();
 	}
 	
+	//Resolve curve UIDs once instead of looking them up by name on every frame
+	TArray<TPair<SmartName::UID_Type, FbxAnimCurve*>> ResolvedCurves;
+	for (const TTuple<FName, FbxAnimCurve*>& CustomCurve : CustomCurves) {
+		const SmartName::UID_Type NameUID = Skeleton->GetUIDByName(USkeleton::AnimCurveMappingName, CustomCurve.Key);
+		if (NameUID != SmartName::MaxUID) {
+			ResolvedCurves.Add(TPair<SmartName::UID_Type, FbxAnimCurve*>(NameUID, CustomCurve.Value));
+		}
+	}
+	if (ResolvedCurves.Num() == 0) {
+		for (const TTuple<FName, FbxAnimCurve*>& CustomCurve : CustomCurves) {
+			CustomCurve.Value->KeyModifyEnd();
+		}
+		return;
+	}
+	
+	TArray<int32> LastKeyIndices;
+	LastKeyIndices.Init(0, ResolvedCurves.Num());
+	FBlendedCurve BlendedCurve;
+	
 	auto ExportLambda = [&](float AnimTime, FbxTime ExportTime, bool bLastKey) {
-		FBlendedCurve BlendedCurve;
+		//All of the curves are evaluated together for each frame
 		BlendedCurve.InitFrom(&AnimCurveUIDs);
 		AnimSequence->EvaluateCurveData(BlendedCurve, AnimTime, false);
 		
 		if (BlendedCurve.IsValid()) {
 			//Loop over the custom curves and add the actual keys
-			for (auto CustomCurve : CustomCurves) {
-				const SmartName::UID_Type NameUID = Skeleton->GetUIDByName(USkeleton::AnimCurveMappingName, CustomCurve.Key);
+			for (int32 i = 0; i < ResolvedCurves.Num(); i++) {
+				const float CurveValueAtTime = BlendedCurve.Get(ResolvedCurves[i].Key);
+				FbxAnimCurve* Curve = ResolvedCurves[i].Value;
 				
-				if (NameUID != SmartName::MaxUID) {
-					const float CurveValueAtTime = BlendedCurve.Get(NameUID);
-					const int32 KeyIndex = CustomCurve.Value->KeyAdd(ExportTime);
-					CustomCurve.Value->KeySetValue(KeyIndex, CurveValueAtTime);
-				}
+				const int32 KeyIndex = Curve->KeyAdd(ExportTime, &LastKeyIndices[i]);
+				Curve->KeySetValue(KeyIndex, CurveValueAtTime);
 			}
 		}
 	};
@@ -563,6 +795,17 @@ FbxNode* FFbxMeshExporter::ExportSkeleton(FbxScene* Scene, const FReferenceSkele
     return BoneNodes[0];
 }
 
+/**
+ * Resizes direct array of the layer element and locks it for writing, so it can be populated directly
+ * SetAt locks and releases the array on every call, which dominates export time of the large meshes
+ * Returned pointer should be released with the typed FbxLayerElementArrayTemplate::Release overload once array is populated
+ */
+template<typename T>
+T* ResizeAndLockDirectArray(FbxLayerElementArrayTemplate<T>& DirectArray, int32 NumElements) {
+	DirectArray.Resize(NumElements);
+	return DirectArray.GetLocked((T*) NULL, FbxLayerElementArray::eWriteLock);
+}
+
 void FFbxMeshExporter::ExportCommonMeshResources(const FStaticMeshVertexBuffers& VertexBuffers, FbxMesh* FbxMesh) {
 	//Initialize vertices first
 	const uint32 NumVertices = VertexBuffers.PositionVertexBuffer.GetNumVertices();
@@ -572,8 +815,7 @@ void FFbxMeshExporter::ExportCommonMeshResources(const FStaticMeshVertexBuffers&
 	
     for (uint32 i = 0; i < NumVertices; i++) {
         const FVector& SrcPosition = VertexBuffers.PositionVertexBuffer.VertexPosition(i);
-        FbxVector4& DestPosition = ControlPoints[i];
-        DestPosition = FFbxDataConverter::ConvertToFbxPos(SrcPosition);
+        ControlPoints[i] = FFbxDataConverter::ConvertToFbxPos(SrcPosition);
     }
 
     //Initialize vertex colors (if we have any)
@@ -585,85 +827,86 @@ void FFbxMeshExporter::ExportCommonMeshResources(const FStaticMeshVertexBuffers&
         VertexColor->SetReferenceMode(FbxLayerElement::eDirect);
     	
         FbxLayerElementArrayTemplate<FbxColor>& ColorArray = VertexColor->GetDirectArray();
-        ColorArray.AddMultiple(NumVertices);
+        FbxColor* ColorData = ResizeAndLockDirectArray(ColorArray, NumVertices);
 
         for (uint32 i = 0; i < NumVertices; i++) {
             const FColor& SrcColor = VertexBuffers.ColorVertexBuffer.VertexColor(i);
-            ColorArray.SetAt(i, FFbxDataConverter::ConvertToFbxColor(SrcColor));
+            ColorData[i] = FbxColor(FFbxDataConverter::ConvertToFbxColor(SrcColor));
         }
+        ColorArray.Release(&ColorData, (FbxColor*) NULL);
     }
 
     check(VertexBuffers.StaticMeshVertexBuffer.GetNumVertices() == NumVertices);
 
-	//Initialize normals
+	//Initialize normals, tangents and binormals
 	FbxGeometryElementNormal* Normal = FbxMesh->CreateElementNormal();
 	Normal->SetMappingMode(FbxLayerElement::eByControlPoint);
 	Normal->SetReferenceMode(FbxLayerElement::eDirect);
-    	
-	FbxLayerElementArrayTemplate<FbxVector4>& NormalArray = Normal->GetDirectArray();
-	NormalArray.AddMultiple(NumVertices);
-    
-	for (uint32 i = 0; i < NumVertices; i++) {
-		const FVector4 SrcNormal = VertexBuffers.StaticMeshVertexBuffer.VertexTangentZ(i);
-		FbxVector4 DestNormal = FFbxDataConverter::ConvertToFbxPos(SrcNormal);
-		NormalArray.SetAt(i, DestNormal);
-	}
-    
-	//Initialize tangents
+        
 	FbxGeometryElementTangent* Tangent = FbxMesh->CreateElementTangent();
 	Tangent->SetMappingMode(FbxLayerElement::eByControlPoint);
 	Tangent->SetReferenceMode(FbxLayerElement::eDirect);
         
-	FbxLayerElementArrayTemplate<FbxVector4>& TangentArray = Tangent->GetDirectArray();
-	TangentArray.AddMultiple(NumVertices);
-    
-	for (uint32 i = 0; i < NumVertices; i++) {
-		const FVector4 SrcTangent = VertexBuffers.StaticMeshVertexBuffer.VertexTangentX(i);
-		FbxVector4 DestTangent = FFbxDataConverter::ConvertToFbxPos(SrcTangent);
-		TangentArray.SetAt(i, DestTangent);
-	}
-    
-	//Initialize binormals
 	FbxGeometryElementBinormal* Binormal = FbxMesh->CreateElementBinormal();
 	Binormal->SetMappingMode(FbxLayerElement::eByControlPoint);
 	Binormal->SetReferenceMode(FbxLayerElement::eDirect);
-    	
+
+	FbxLayerElementArrayTemplate<FbxVector4>& NormalArray = Normal->GetDirectArray();
+	FbxLayerElementArrayTemplate<FbxVector4>& TangentArray = Tangent->GetDirectArray();
 	FbxLayerElementArrayTemplate<FbxVector4>& BinormalArray = Binormal->GetDirectArray();
-	BinormalArray.AddMultiple(NumVertices);
-    
+	
+	FbxVector4* NormalData = ResizeAndLockDirectArray(NormalArray, NumVertices);
+	FbxVector4* TangentData = ResizeAndLockDirectArray(TangentArray, NumVertices);
+	FbxVector4* BinormalData = ResizeAndLockDirectArray(BinormalArray, NumVertices);
+
+	//Populate all of the tangent basis vectors in one pass over the tangent buffer
 	for (uint32 i = 0; i < NumVertices; i++) {
-		const FVector4 SrcBinormal = VertexBuffers.StaticMeshVertexBuffer.VertexTangentY(i);
-		FbxVector4 DestBinormal = FFbxDataConverter::ConvertToFbxPos(SrcBinormal);
-		BinormalArray.SetAt(i, DestBinormal);
+		NormalData[i] = FFbxDataConverter::ConvertToFbxPos(VertexBuffers.StaticMeshVertexBuffer.VertexTangentZ(i));
+		TangentData[i] = FFbxDataConverter::ConvertToFbxPos(VertexBuffers.StaticMeshVertexBuffer.VertexTangentX(i));
+		BinormalData[i] = FFbxDataConverter::ConvertToFbxPos(VertexBuffers.StaticMeshVertexBuffer.VertexTangentY(i));
 	}
+	NormalArray.Release(&NormalData, (FbxVector4*) NULL);
+	TangentArray.Release(&TangentData, (FbxVector4*) NULL);
+	BinormalArray.Release(&BinormalData, (FbxVector4*) NULL);
 
     //Initialize UV positions for each channel
     const uint32 NumTexCoords = VertexBuffers.StaticMeshVertexBuffer.GetNumTexCoords();
-    TArray<FbxLayerElementArrayTemplate<FbxVector2>*> UVCoordsArray;
     
-    for (uint32 i = 0; i < NumTexCoords; i++) {
+    for (uint32 j = 0; j < NumTexCoords; j++) {
         //TODO proper names, can know if texture is lightmap by checking lightmap tex coord index from static mesh
-        const FString UVChannelName = GetNameForUVChannel(i);
+        const FString UVChannelName = GetNameForUVChannel(j);
         FbxGeometryElementUV* UVCoords = FbxMesh->CreateElementUV(FFbxDataConverter::ConvertToFbxString(UVChannelName));
         UVCoords->SetMappingMode(FbxLayerElement::eByControlPoint);
         UVCoords->SetReferenceMode(FbxLayerElement::eDirect);
-        FbxLayerElementArrayTemplate<FbxVector2>* TexCoordArray = &UVCoords->GetDirectArray();
-        TexCoordArray->AddMultiple(NumVertices);
         
-        UVCoordsArray.Add(TexCoordArray);
-    }
-    
-    //Populate UV coords for each vertex
-    for (uint32 j = 0; j < NumTexCoords; j++) {
-        FbxLayerElementArrayTemplate<FbxVector2>* UVArray = UVCoordsArray[j];
+        //Populate UV coords for each vertex
+        FbxLayerElementArrayTemplate<FbxVector2>& UVArray = UVCoords->GetDirectArray();
+        FbxVector2* UVData = ResizeAndLockDirectArray(UVArray, NumVertices);
+        
         for (uint32 i = 0; i < NumVertices; i++) {
-            const FVector2D& SrcTextureCoord = VertexBuffers.StaticMeshVertexBuffer.GetVertexUV(i, j);
-            FbxVector2 DestUVCoord(SrcTextureCoord.X, -SrcTextureCoord.Y + 1.0f);
-            UVArray->SetAt(i, DestUVCoord);
+            const FVector2D SrcTextureCoord = VertexBuffers.StaticMeshVertexBuffer.GetVertexUV(i, j);
+            UVData[i] = FbxVector2(SrcTextureCoord.X, -SrcTextureCoord.Y + 1.0f);
         }
+        UVArray.Release(&UVData, (FbxVector2*) NULL);
     }
 }
 
+/**
+ * Adds triangles described by the contiguous block of indices into the fbx mesh, all using the same material
+ * FBX SDK has no public API for appending polygons in bulk, but with polygon storage reserved upfront
+ * and indices already unpacked into a flat block the loop only consists of the SDK appends
+ */
+void AddTrianglesToFbxMesh(FbxMesh* FbxMesh, int32 MaterialIndex, const uint32* TriangleIndices, uint32 NumTriangles) {
+	for (uint32 TriangleIndex = 0; TriangleIndex < NumTriangles; TriangleIndex++) {
+		const uint32* Triangle = TriangleIndices + TriangleIndex * 3;
+		FbxMesh->BeginPolygon(MaterialIndex, -1, -1, false);
+		FbxMesh->AddPolygon(Triangle[0]);
+		FbxMesh->AddPolygon(Triangle[1]);
+		FbxMesh->AddPolygon(Triangle[2]);
+		FbxMesh->EndPolygon();
+	}
+}
+
 int32 ExportDummyMaterialIntoFbxScene(const FString& MaterialSlotName, FbxNode* Node) {
     //Create dummy material
     //MaterialSlotName will be either current material name or predefined name
@@ -746,32 +989,33 @@ void FFbxMeshExporter::CreateBindPose(FbxNode* MeshRootNode) {
 	}
 }
 
+//Bone data of each vertex is laid out as VertexInfluenceCount bone indices followed by VertexInfluenceCount bone weights
 uint32 FSkinWeightDataVertexBuffer_GetBoneIndex(const FSkinWeightDataVertexBuffer& VertexBuffer, uint32 VertexWeightOffset, uint32 VertexInfluenceCount, uint32 InfluenceIndex) {	
-	//if (InfluenceIndex < VertexInfluenceCount) {
-	//	const uint8* BoneData = VertexBuffer.GetData() + VertexWeightOffset;
-	//	if (VertexBuffer.Use16BitBoneIndex()) {
-	//		FBoneIndex16* BoneIndex16Ptr = (FBoneIndex16*)BoneData;
-	//		return BoneIndex16Ptr[InfluenceIndex];
-	//	}
-	//	return BoneData[InfluenceIndex];
-	//}
+	if (InfluenceIndex < VertexInfluenceCount) {
+		const uint8* BoneData = VertexBuffer.GetWeightData() + VertexWeightOffset;
+		if (VertexBuffer.Use16BitBoneIndex()) {
+			const FBoneIndex16* BoneIndex16Ptr = (const FBoneIndex16*) BoneData;
+			return BoneIndex16Ptr[InfluenceIndex];
+		}
+		return BoneData[InfluenceIndex];
+	}
 	return 0;
 }
 
 uint8 FSkinWeightDataVertexBuffer_GetBoneWeight(const FSkinWeightDataVertexBuffer& VertexBuffer, uint32 VertexWeightOffset, uint32 VertexInfluenceCount, uint32 InfluenceIndex) {
-	//if (InfluenceIndex < VertexInfluenceCount){
-	//	const uint8* BoneData = VertexBuffer.GetData() + VertexWeightOffset;
-	//	uint32 BoneWeightOffset = VertexBuffer.GetBoneIndexByteSize() * VertexInfluenceCount;
-	//	return BoneData[BoneWeightOffset + InfluenceIndex];
-	//}
+	if (InfluenceIndex < VertexInfluenceCount) {
+		const uint8* BoneData = VertexBuffer.GetWeightData() + VertexWeightOffset;
+		const uint32 BoneWeightOffset = VertexBuffer.GetBoneIndexByteSize() * VertexInfluenceCount;
+		return BoneData[BoneWeightOffset + InfluenceIndex];
+	}
 	return 0;
 }
 
 void FSkinWeightLookupVertexBuffer_GetWeightOffsetAndInfluenceCount(const FSkinWeightLookupVertexBuffer& VertexBuffer, uint32 VertexIndex, uint32& OutWeightOffset, uint32& OutInfluenceCount) {
-	//uint32 Offset = VertexIndex * 4;
-	//uint32 DataUInt32 = *((const uint32*)(&VertexBuffer.GetData()[Offset]));
-	//OutWeightOffset = DataUInt32 >> 8;
-	//OutInfluenceCount = DataUInt32 & 0xff;
+	const uint32 Offset = VertexIndex * 4;
+	const uint32 DataUInt32 = *((const uint32*) (&VertexBuffer.GetLookupData()[Offset]));
+	OutWeightOffset = DataUInt32 >> 8;
+	OutInfluenceCount = DataUInt32 & 0xff;
 }
 
 //Copied from FSkinWeightVertexBuffer methods because they are not exported by the engine
@@ -784,29 +1028,6 @@ void FSkinWeightVertexBuffer_GetVertexInfluenceOffsetCount(const FSkinWeightVert
 	}
 }
 
-uint32 FSkinWeightVertexBuffer_GetBoneIndex(const FSkinWeightVertexBuffer& Buffer, uint32 VertexIndex, uint32 InfluenceIndex) {
-	uint32 VertexWeightOffset = 0;
-	uint32 VertexInfluenceCount = 0;
-	FSkinWeightVertexBuffer_GetVertexInfluenceOffsetCount(Buffer, VertexIndex, VertexWeightOffset, VertexInfluenceCount);
-	return FSkinWeightDataVertexBuffer_GetBoneIndex(*Buffer.GetDataVertexBuffer(), VertexWeightOffset, VertexInfluenceCount, InfluenceIndex);
-}
-
-uint8 FSkinWeightVertexBuffer_GetBoneWeight(const FSkinWeightVertexBuffer& Buffer, uint32 VertexIndex, uint32 InfluenceIndex) {
-	uint32 VertexWeightOffset = 0;
-	uint32 VertexInfluenceCount = 0;
-	FSkinWeightVertexBuffer_GetVertexInfluenceOffsetCount(Buffer, VertexIndex, VertexWeightOffset, VertexInfluenceCount);
-	return FSkinWeightDataVertexBuffer_GetBoneWeight(*Buffer.GetDataVertexBuffer(), VertexWeightOffset, VertexInfluenceCount, InfluenceIndex);
-}
-
-FSkinWeightInfo FSkinWeightVertexBuffer_GetVertexSkinWeights(const FSkinWeightVertexBuffer& Buffer, uint32 VertexIndex) {
-	FSkinWeightInfo OutVertex;
-	for (int32 InfluenceIdx = 0; InfluenceIdx < MAX_TOTAL_INFLUENCES; InfluenceIdx++) {
-		OutVertex.InfluenceBones[InfluenceIdx] = FSkinWeightVertexBuffer_GetBoneIndex(Buffer, VertexIndex, InfluenceIdx);
-		OutVertex.InfluenceWeights[InfluenceIdx] = FSkinWeightVertexBuffer_GetBoneWeight(Buffer, VertexIndex, InfluenceIdx);
-	}
-	return OutVertex;
-}
-
 void FFbxMeshExporter::BindSkeletalMeshToSkeleton(const FSkeletalMeshLODRenderData& SkeletalMeshLOD, const TArray<FbxNode*>& BoneNodes, FbxNode* MeshRootNode) {
 	FbxScene* Scene = MeshRootNode->GetScene();
 	FbxAMatrix MeshMatrix = MeshRootNode->EvaluateGlobalTransform();
@@ -814,8 +1035,42 @@ void FFbxMeshExporter::BindSkeletalMeshToSkeleton(const FSkeletalMeshLODRenderDa
 	FbxGeometry* MeshAttribute = (FbxGeometry*) MeshRootNode->GetNodeAttribute();
 	FbxSkin* Skin = FbxSkin::Create(Scene, "");
     const FSkinWeightVertexBuffer& SkinWeightVertexBuffer = SkeletalMeshLOD.SkinWeightVertexBuffer;
+	const FSkinWeightDataVertexBuffer& SkinWeightDataBuffer = *SkinWeightVertexBuffer.GetDataVertexBuffer();
 
+	//Control point indices and weights influenced by each bone, gathered in one pass over the skin weight buffer
 	const int32 BoneCount = BoneNodes.Num();
+	TArray<TArray<int32>> BoneControlPointIndices;
+	TArray<TArray<double>> BoneControlPointWeights;
+	BoneControlPointIndices.SetNum(BoneCount);
+	BoneControlPointWeights.SetNum(BoneCount);
+
+    //We need to do it per-section because bone indices of vertex are local to the section they are contained in
+    //So we can mesh bone index from section local bone index and then apply transform to this bone
+    for (const FSkelMeshRenderSection& RenderSection : SkeletalMeshLOD.RenderSections) {
+        const uint32 BaseVertexIndex = RenderSection.BaseVertexIndex;
+        const uint32 MaxVertexIndex = BaseVertexIndex + RenderSection.NumVertices;
+        
+        for (uint32 VertexIndex = BaseVertexIndex; VertexIndex < MaxVertexIndex; VertexIndex++) {
+            //Resolve influence data location once per vertex, and then decode all of it's influences
+            uint32 VertexWeightOffset = 0;
+            uint32 VertexInfluenceCount = 0;
+            FSkinWeightVertexBuffer_GetVertexInfluenceOffsetCount(SkinWeightVertexBuffer, VertexIndex, VertexWeightOffset, VertexInfluenceCount);
+
+            for (uint32 InfluenceIndex = 0; InfluenceIndex < VertexInfluenceCount; InfluenceIndex++) {
+                const uint8 InfluenceWeightByte = FSkinWeightDataVertexBuffer_GetBoneWeight(SkinWeightDataBuffer, VertexWeightOffset, VertexInfluenceCount, InfluenceIndex);
+                if (InfluenceWeightByte == 0) {
+                    continue;
+                }
+                const uint32 SectionBoneIndex = FSkinWeightDataVertexBuffer_GetBoneIndex(SkinWeightDataBuffer, VertexWeightOffset, VertexInfluenceCount, InfluenceIndex);
+                const int32 InfluenceBone = RenderSection.BoneMap[SectionBoneIndex];
+                check(InfluenceBone < BoneCount);
+
+                BoneControlPointIndices[InfluenceBone].Add(VertexIndex);
+                BoneControlPointWeights[InfluenceBone].Add(InfluenceWeightByte / 255.0);
+            }
+        }
+    }
+
 	for(int32 BoneIndex = 0; BoneIndex < BoneCount; ++BoneIndex) {
 		FbxNode* BoneNode = BoneNodes[BoneIndex];
 
@@ -824,26 +1079,15 @@ void FFbxMeshExporter::BindSkeletalMeshToSkeleton(const FSkeletalMeshLODRenderDa
 		CurrentCluster->SetLink(BoneNode);
 		CurrentCluster->SetLinkMode(FbxCluster::eTotalOne);
 
-	    //We need to do it per-section because bone indices of vertex are local to the section they are contained in
-	    //So we can mesh bone index from section local bone index and then apply transform to this bone
-	    for (const FSkelMeshRenderSection& RenderSection : SkeletalMeshLOD.RenderSections) {
-	        const uint32 BaseVertexIndex = RenderSection.BaseVertexIndex;
-	        const uint32 MaxVertexIndex = BaseVertexIndex + RenderSection.NumVertices;
-	        
-	        for (uint32 VertexIndex = BaseVertexIndex; VertexIndex < MaxVertexIndex; VertexIndex++) {
-	            //Retrieve influences for this exact vertex
-	        	FSkinWeightInfo WeightInfo = FSkinWeightVertexBuffer_GetVertexSkinWeights(SkinWeightVertexBuffer, VertexIndex);
-
-	            for (int32 InfluenceIndex = 0; InfluenceIndex < MAX_TOTAL_INFLUENCES; InfluenceIndex++) {
-                    const int32 InfluenceBone = RenderSection.BoneMap[WeightInfo.InfluenceBones[InfluenceIndex]];
-                    const float InfluenceWeight = WeightInfo.InfluenceWeights[InfluenceIndex] / 255.f;
-
-	                if(InfluenceBone == BoneIndex && InfluenceWeight > 0.0f) {
-	                    CurrentCluster->AddControlPointIndex(VertexIndex, InfluenceWeight);
-	                }
-	            }
-	        }
-	    }
+		//Copy gathered influences into the cluster arrays directly instead of appending them one by one
+		const TArray<int32>& ControlPointIndices = BoneControlPointIndices[BoneIndex];
+		const TArray<double>& ControlPointWeights = BoneControlPointWeights[BoneIndex];
+		
+		if (ControlPointIndices.Num() > 0) {
+			CurrentCluster->SetControlPointIWCount(ControlPointIndices.Num());
+			FMemory::Memcpy(CurrentCluster->GetControlPointIndices(), ControlPointIndices.GetData(), ControlPointIndices.Num() * sizeof(int32));
+			FMemory::Memcpy(CurrentCluster->GetControlPointWeights(), ControlPointWeights.GetData(), ControlPointWeights.Num() * sizeof(double));
+		}
 
 		// Now we have the Patch and the skeleton correctly positioned,
 		// set the Transform and TransformLink matrix accordingly.
@@ -874,26 +1118,30 @@ void FFbxMeshExporter::ExportSkeletalMesh(const FSkeletalMeshLODRenderData& Skel
     //Create basic static mesh buffers
     ExportCommonMeshResources(SkeletalMeshLOD.StaticVertexBuffers, FbxMesh);
 
-    const FRawStaticIndexBuffer16or32Interface* IndexBuffer = SkeletalMeshLOD.MultiSizeIndexContainer.GetIndexBuffer();
+    //Unpack indices of all sections into one block, so they are not fetched through virtual calls one by one
+    TArray<uint32> Indices;
+    SkeletalMeshLOD.MultiSizeIndexContainer.GetIndexBuffer(Indices);
     FbxNode* MeshNode = FbxMesh->GetNode();
+
+    uint32 TotalNumTriangles = 0;
+    for (const FSkelMeshRenderSection& MeshSection : SkeletalMeshLOD.RenderSections) {
+        TotalNumTriangles += MeshSection.NumTriangles;
+    }
+    FbxMesh->ReservePolygonCount(TotalNumTriangles);
+    FbxMesh->ReservePolygonVertexCount(TotalNumTriangles * 3);
     
     //Create sections and initialize dummy materials
     for (const FSkelMeshRenderSection& MeshSection : SkeletalMeshLOD.RenderSections) {
         const uint32 NumTriangles = MeshSection.NumTriangles;
         const uint32 StartVertexIndex = MeshSection.BaseIndex;
+        check(StartVertexIndex + NumTriangles * 3 <= (uint32) Indices.Num());
 
         //Create dummy material for this section
         const FString MaterialSlotName = ReferencedMaterials[MeshSection.MaterialIndex].MaterialSlotName.ToString();
         const int32 MaterialIndex = ExportDummyMaterialIntoFbxScene(MaterialSlotName, MeshNode);
         
         //Add all triangles associated with this section
-        for (uint32 TriangleIndex = 0; TriangleIndex < NumTriangles; TriangleIndex++) {
-            FbxMesh->BeginPolygon(MaterialIndex, -1, -1, false);
-            FbxMesh->AddPolygon(IndexBuffer->Get(StartVertexIndex + TriangleIndex * 3 + 0));
-            FbxMesh->AddPolygon(IndexBuffer->Get(StartVertexIndex + TriangleIndex * 3 + 1));
-            FbxMesh->AddPolygon(IndexBuffer->Get(StartVertexIndex + TriangleIndex * 3 + 2));
-            FbxMesh->EndPolygon();
-        }
+        AddTrianglesToFbxMesh(FbxMesh, MaterialIndex, Indices.GetData() + StartVertexIndex, NumTriangles);
     }
 }
 
@@ -906,25 +1154,29 @@ void FFbxMeshExporter::ExportStaticMesh(const FStaticMeshLODResources& StaticMes
     //Create basic static mesh buffers
     ExportCommonMeshResources(StaticMeshLOD.VertexBuffers, FbxMesh);
     
-    const FRawStaticIndexBuffer& IndexBuffer = StaticMeshLOD.IndexBuffer;
+    //Unpack indices of all sections into one block, so 16-bit and 32-bit index buffers are handled in one place
+    TArray<uint32> Indices;
+    StaticMeshLOD.IndexBuffer.GetCopy(Indices);
     FbxNode* MeshNode = FbxMesh->GetNode();
 
+    uint32 TotalNumTriangles = 0;
+    for (const FStaticMeshSection& MeshSection : StaticMeshLOD.Sections) {
+        TotalNumTriangles += MeshSection.NumTriangles;
+    }
+    FbxMesh->ReservePolygonCount(TotalNumTriangles);
+    FbxMesh->ReservePolygonVertexCount(TotalNumTriangles * 3);
+
     //Create sections and initialize dummy materials
     for (const FStaticMeshSection& MeshSection : StaticMeshLOD.Sections) {
         const uint32 NumTriangles = MeshSection.NumTriangles;
         const uint32 StartIndex = MeshSection.FirstIndex;
+        check(StartIndex + NumTriangles * 3 <= (uint32) Indices.Num());
 
         //Create dummy material for this section
         const FString MaterialSlotName = ReferencedMaterials[MeshSection.MaterialIndex].MaterialSlotName.ToString();
         const int32 MaterialIndex = ExportDummyMaterialIntoFbxScene(MaterialSlotName, MeshNode);
         
         //Add all triangles associated with this section
-        for (uint32 TriangleIndex = 0; TriangleIndex < NumTriangles; TriangleIndex++) {
-            FbxMesh->BeginPolygon(MaterialIndex, -1, -1, false);
-            FbxMesh->AddPolygon(IndexBuffer.GetIndex(StartIndex + TriangleIndex * 3 + 0));
-            FbxMesh->AddPolygon(IndexBuffer.GetIndex(StartIndex + TriangleIndex * 3 + 1));
-            FbxMesh->AddPolygon(IndexBuffer.GetIndex(StartIndex + TriangleIndex * 3 + 2));
-            FbxMesh->EndPolygon();
-        }
+        AddTrianglesToFbxMesh(FbxMesh, MaterialIndex, Indices.GetData() + StartIndex, NumTriangles);
     }
 }
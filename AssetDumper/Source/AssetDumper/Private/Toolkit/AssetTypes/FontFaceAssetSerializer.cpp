@@ -4,7 +4,6 @@
 #include "Toolkit/ObjectHierarchySerializer.h"
 #include "Engine/FontFace.h"
 #include "Toolkit/PropertySerializer.h"
-#include "Toolkit/AssetTypes/AssetHelper.h"
 
 void UFontFaceAssetSerializer::SerializeAsset(TSharedRef<FSerializationContext> Context) const {
     BEGIN_ASSET_SERIALIZATION(UFontFace)
@@ -22,7 +21,7 @@ void UFontFaceAssetSerializer::SerializeAsset(TSharedRef<FSerializationContext>
     check(FontRawData.Num());
 
 	//Record file hash so we do not have to load it again to check for asset changes in editor
-	Data->SetStringField(TEXT("FontPayloadHash"), FAssetHelper::ComputePayloadHash(FontRawData));
+	Data->SetStringField(TEXT("FontPayloadHash"), Context->ComputePayloadHash(FontRawData.GetData(), FontRawData.Num()));
 
     //Theoretically .ufont can be any kind of font format that FreeType supports,
     //but since most of the programs (including UE importer and Windows font viewer) are able to
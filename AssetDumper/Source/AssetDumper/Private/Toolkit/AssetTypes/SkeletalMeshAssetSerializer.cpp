@@ -40,15 +40,15 @@ void USkeletalMeshAssetSerializer::SerializeAsset(TSharedRef<FSerializationConte
     }
 
     //Export raw mesh data into separate FBX file that can be imported back into UE
-    const FString OutFbxMeshFileName = Context->GetDumpFilePath(TEXT(""), TEXT("fbx"));
+    TArray64<uint8> FbxFileData;
 
 	FString OutErrorMessage;
-    const bool bSuccess = FFbxMeshExporter::ExportSkeletalMeshIntoFbxFile(Asset, OutFbxMeshFileName, false, &OutErrorMessage);
+    const bool bSuccess = FFbxMeshExporter::ExportSkeletalMeshIntoFbxData(Asset, FbxFileData, false, &OutErrorMessage);
     checkf(bSuccess, TEXT("Failed to export skeletal mesh %s: %s"), *Asset->GetPathName(), *OutErrorMessage);
 
 	//Serialize exported model hash to avoid reading it during generation pass
-	const FMD5Hash ModelFileHash = FMD5Hash::HashFile(*OutFbxMeshFileName);
-	Data->SetStringField(TEXT("ModelFileHash"), LexToString(ModelFileHash));
+	Data->SetStringField(TEXT("ModelFileHash"), FFbxMeshExporter::ComputeFbxFileHash(FbxFileData));
+	Context->StoreDumpFileData(TEXT(""), TEXT("fbx"), MoveTemp(FbxFileData));
 	
     END_ASSET_SERIALIZATION
 }
@@ -77,7 +77,3 @@ void USkeletalMeshAssetSerializer::SerializeReferenceSkeleton(const FReferenceSk
 FName USkeletalMeshAssetSerializer::GetAssetClass() const {
     return USkeletalMesh::StaticClass()->GetFName();
 }
-
-bool USkeletalMeshAssetSerializer::SupportsParallelDumping() const {
-	return false;
-}
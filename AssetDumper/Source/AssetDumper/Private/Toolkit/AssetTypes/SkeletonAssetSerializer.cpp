@@ -62,10 +62,11 @@ void USkeletonAssetSerializer::SerializeAsset(TSharedRef<FSerializationContext>
     SERIALIZE_ASSET_OBJECT
 
     //Serialize skeleton itself into the fbx file
-    const FString OutFbxFilename = Context->GetDumpFilePath(TEXT(""), TEXT("fbx"));
+    TArray64<uint8> FbxFileData;
     FString OutErrorMessage;
-    const bool bSuccess = FFbxMeshExporter::ExportSkeletonIntoFbxFile(Asset, OutFbxFilename, false, &OutErrorMessage);
+    const bool bSuccess = FFbxMeshExporter::ExportSkeletonIntoFbxData(Asset, FbxFileData, false, &OutErrorMessage);
     checkf(bSuccess, TEXT("Failed to export skeleton %s: %s"), *Asset->GetPathName(), *OutErrorMessage);
+    Context->StoreDumpFileData(TEXT(""), TEXT("fbx"), MoveTemp(FbxFileData));
     
     END_ASSET_SERIALIZATION
 }
@@ -117,7 +118,3 @@ void USkeletonAssetSerializer::SerializeSmartNameContainer(const FSmartNameConta
 FName USkeletonAssetSerializer::GetAssetClass() const {
     return USkeleton::StaticClass()->GetFName();
 }
-
-bool USkeletonAssetSerializer::SupportsParallelDumping() const {
-	return false;
-}
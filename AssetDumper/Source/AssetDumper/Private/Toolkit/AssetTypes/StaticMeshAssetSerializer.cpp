@@ -48,14 +48,14 @@ void UStaticMeshAssetSerializer::SerializeAsset(TSharedRef<FSerializationContext
 	Data->SetArrayField(TEXT("ScreenSize"), ScreenSize);
 
     //Export raw mesh data into separate FBX file that can be imported back into UE
-    const FString OutFbxMeshFileName = Context->GetDumpFilePath(TEXT(""), TEXT("fbx"));
+    TArray64<uint8> FbxFileData;
     FString OutErrorMessage;
-    const bool bSuccess = FFbxMeshExporter::ExportStaticMeshIntoFbxFile(Asset, OutFbxMeshFileName, false, &OutErrorMessage);
+    const bool bSuccess = FFbxMeshExporter::ExportStaticMeshIntoFbxData(Asset, FbxFileData, false, &OutErrorMessage);
     checkf(bSuccess, TEXT("Failed to export static mesh %s: %s"), *Asset->GetPathName(), *OutErrorMessage);
 
 	//Serialize exported model hash to avoid reading it during generation pass
-	const FMD5Hash ModelFileHash = FMD5Hash::HashFile(*OutFbxMeshFileName);
-	Data->SetStringField(TEXT("ModelFileHash"), LexToString(ModelFileHash));
+	Data->SetStringField(TEXT("ModelFileHash"), FFbxMeshExporter::ComputeFbxFileHash(FbxFileData));
+	Context->StoreDumpFileData(TEXT(""), TEXT("fbx"), MoveTemp(FbxFileData));
     
     END_ASSET_SERIALIZATION
 }
@@ -63,7 +63,3 @@ void UStaticMeshAssetSerializer::SerializeAsset(TSharedRef<FSerializationContext
 FName UStaticMeshAssetSerializer::GetAssetClass() const {
     return UStaticMesh::StaticClass()->GetFName();
 }
-
-bool UStaticMeshAssetSerializer::SupportsParallelDumping() const {
-	return false;
-}
@@ -4,6 +4,7 @@
 #include "Engine/Texture2D.h"
 #include "Toolkit/AssetTypes/TextureDecompressor.h"
 #include "IImageWrapper.h"
+#include "Math/VectorRegister.h"
 #include "Dom/JsonObject.h"
 #include "Toolkit/ObjectHierarchySerializer.h"
 #include "Toolkit/PropertySerializer.h"
@@ -17,11 +18,18 @@ void UTextureAssetSerializer::SerializeAsset(TSharedRef<FSerializationContext> C
 }
 
 void ClearAlphaFromBGRA8Texture(void* TextureData, int32 NumPixels) {
-    FColor* TextureDataColor = static_cast<FColor*>(TextureData);
-
-    for (int i = 0; i < NumPixels; i++) {
-        FColor* CurrentColor = TextureDataColor++;
-        CurrentColor->A = 255;
+    uint32* TextureDataColor = static_cast<uint32*>(TextureData);
+    const uint32 AlphaMask = FColor(0, 0, 0, 255).DWColor();
+    const VectorRegisterInt AlphaMaskVector = MakeVectorRegisterInt(AlphaMask, AlphaMask, AlphaMask, AlphaMask);
+    int32 PixelIndex = 0;
+
+    //Set alpha of 4 pixels at once using platform vector registers, falls back to scalar code on platforms without them
+    for (; PixelIndex + 4 <= NumPixels; PixelIndex += 4) {
+        const VectorRegisterInt CurrentColors = VectorIntLoad(TextureDataColor + PixelIndex);
+        VectorIntStore(VectorIntOr(CurrentColors, AlphaMaskVector), TextureDataColor + PixelIndex);
+    }
+    for (; PixelIndex < NumPixels; PixelIndex++) {
+        TextureDataColor[PixelIndex] |= AlphaMask;
     }
 }
 
@@ -62,22 +70,13 @@ void UTextureAssetSerializer::SerializeTextureData(const FString& ContextString,
 	FirstMipMap.BulkData.GetCopy(&RawCompressedDataCopy, false);
 	check(RawCompressedDataCopy);
 
+	//Extract every slice and stitch them into the single texture, which results in texture being stitched vertically
 	TArray<uint8> OutDecompressedData;
-	uint8* CurrentCompressedData = (uint8*) RawCompressedDataCopy;
-		
-	//Extract every slice and stitch them into the single texture
-	for (int i = 0; i < NumTexturesInBulkData; i++) {
-		FString OutErrorMessage;
-        
-		//Append texture data into the output array, which results in texture being stitched vertically
-		const bool bSuccess = FTextureDecompressor::DecompressTextureData(PixelFormat, CurrentCompressedData, TextureWidth, TextureHeight, OutDecompressedData, &OutErrorMessage);
-
-		//Make sure extraction was successful. Theoretically only failure reason would be unsupported format, but we should support most of the used formats
-		checkf(bSuccess, TEXT("Failed to extract Texture %s (%dx%d, format %s): %s"), *ContextString, TextureWidth, TextureHeight, *PixelFormatName, *OutErrorMessage);
-			
-		//Skip amount of bytes read per slice from compressed data buffer
-		CurrentCompressedData += NumBytesPerSlice;
-	}	
+	FString OutErrorMessage;
+	const bool bSuccess = FTextureDecompressor::DecompressTextureSlices(PixelFormat, (const uint8*) RawCompressedDataCopy, NumBytesPerSlice, NumTexturesInBulkData, TextureWidth, TextureHeight, OutDecompressedData, &OutErrorMessage);
+
+	//Make sure extraction was successful. Theoretically only failure reason would be unsupported format, but we should support most of the used formats
+	checkf(bSuccess, TEXT("Failed to extract Texture %s (%dx%d, format %s): %s"), *ContextString, TextureWidth, TextureHeight, *PixelFormatName, *OutErrorMessage);
     
     //Free bulk data copy that was allocated by GetCopy call
     FMemory::Free(RawCompressedDataCopy);
@@ -89,9 +88,7 @@ void UTextureAssetSerializer::SerializeTextureData(const FString& ContextString,
     }
 
 	//Write hash of the source texture filename so asset generator can easily figure out whenever refresh is needed
-	FString Hash = FMD5::HashBytes(OutDecompressedData.GetData(), OutDecompressedData.Num() * sizeof(uint8));
-	Hash.Append(FString::Printf(TEXT("%x"), OutDecompressedData.Num()));
-	Data->SetStringField(TEXT("SourceImageHash"), Hash);
+	Data->SetStringField(TEXT("SourceImageHash"), Context->ComputePayloadHash(OutDecompressedData.GetData(), OutDecompressedData.Num()));
 
     //Save data in PNG format and store bytes in serialization context
     IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
@@ -99,12 +96,12 @@ void UTextureAssetSerializer::SerializeTextureData(const FString& ContextString,
 
     //TextureHeight should be multiplied by amount of splices because we basically stack textures vertically by appending data to the end of buffer
     const int32 ActualTextureHeight = TextureHeight * NumTexturesInBulkData;
-    check(ImageWrapper->SetRaw(OutDecompressedData.GetData(), OutDecompressedData.Num(), TextureWidth, ActualTextureHeight, ERGBFormat::BGRA, 8));
-    const TArray64<uint8>& PNGResultData = ImageWrapper->GetCompressed();
 
-    //Store data in serialization context
-    const FString ImageFilename = Context->GetDumpFilePath(FileNamePostfix, TEXT("png"));
-    check(FFileHelper::SaveArrayToFile(PNGResultData, *ImageFilename));
+    //PNG compression is deferred to the asset dump pipeline, identical images of different textures will only be written once
+    Context->StoreDumpFileData(FileNamePostfix, TEXT("png"), [ImageWrapper, DecompressedData = MoveTemp(OutDecompressedData), TextureWidth, ActualTextureHeight](TArray64<uint8>& OutData) {
+        check(ImageWrapper->SetRaw(DecompressedData.GetData(), DecompressedData.Num(), TextureWidth, ActualTextureHeight, ERGBFormat::BGRA, 8));
+        OutData = ImageWrapper->GetCompressed();
+    });
 }
 
 void UTextureAssetSerializer::SerializeTexture2D(UTexture2D* Asset, TSharedPtr<FJsonObject> Data, TSharedRef<FSerializationContext> Context, const FString& Postfix) {
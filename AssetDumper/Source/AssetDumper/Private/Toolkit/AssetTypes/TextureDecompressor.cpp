@@ -1,51 +1,124 @@
 #include "Toolkit/AssetTypes/TextureDecompressor.h"
+#include "Async/ParallelFor.h"
+#include "HAL/ThreadSafeBool.h"
 #include "Math/PackedVector.h"
 #include "RenderUtils.h"
 #include "detex.h"
 
+/** Approximate amount of pixels decompressed by a single task, large textures are split into tiles of whole block rows of this size */
+#define TEXTURE_DECOMPRESSION_TILE_PIXELS (256 * 1024)
+
+/**
+ * Lookup tables mapping every possible 16-bit float channel value to it's 8-bit representation
+ * Channels are converted independently, so tables give results identical to FLinearColor::ToFColor,
+ * while avoiding half float decoding and sRGB power curve evaluation for every pixel
+ */
+struct FFloat16ColorTable {
+    uint8 SRGBChannel[65536];
+    uint8 LinearChannel[65536];
+
+    FFloat16ColorTable() {
+        for (uint32 EncodedValue = 0; EncodedValue < 65536; EncodedValue++) {
+            FFloat16 Value;
+            Value.Encoded = (uint16) EncodedValue;
+            const float FloatValue = Value.GetFloat();
+
+            //Alpha is never sRGB encoded by ToFColor, so it gives us linear conversion result
+            const FColor Color = FLinearColor(FloatValue, FloatValue, FloatValue, FloatValue).ToFColor(true);
+            SRGBChannel[EncodedValue] = Color.R;
+            LinearChannel[EncodedValue] = Color.A;
+        }
+    }
+
+    static const FFloat16ColorTable& Get() {
+        static const FFloat16ColorTable Table;
+        return Table;
+    }
+};
+
+/** Lookup tables mapping R11G11B10 float channel values to the sRGB encoded 8-bit values, same as FFloat3Packed::ToLinearColor().ToFColor(true) */
+struct FFloat3PackedColorTable {
+    uint8 RedChannel[2048];
+    uint8 GreenChannel[2048];
+    uint8 BlueChannel[1024];
+
+    FFloat3PackedColorTable() {
+        static_assert(sizeof(FFloat3Packed) == sizeof(uint32), "FFloat3Packed is expected to be 32 bits wide");
+
+        for (uint32 ChannelValue = 0; ChannelValue < 2048; ChannelValue++) {
+            RedChannel[ChannelValue] = DecodeChannel(ChannelValue).R;
+            GreenChannel[ChannelValue] = DecodeChannel(ChannelValue << 11).G;
+        }
+        for (uint32 ChannelValue = 0; ChannelValue < 1024; ChannelValue++) {
+            BlueChannel[ChannelValue] = DecodeChannel(ChannelValue << 22).B;
+        }
+    }
+
+    static FColor DecodeChannel(uint32 EncodedValue) {
+        FFloat3Packed PackedValue;
+        FMemory::Memcpy(&PackedValue, &EncodedValue, sizeof(uint32));
+        return PackedValue.ToLinearColor().ToFColor(true);
+    }
+
+    static const FFloat3PackedColorTable& Get() {
+        static const FFloat3PackedColorTable Table;
+        return Table;
+    }
+};
+
 void ConvertFloatRGBAToBGRA8(const void* SourcePixelData, void* DestPixelData, int32 NumPixels) {
-    const FFloat16Color* SourceData = static_cast<const FFloat16Color*>(SourcePixelData);
+    const uint16* SourceData = static_cast<const uint16*>(SourcePixelData);
     FColor* DestData = static_cast<FColor*>(DestPixelData);
+    const FFloat16ColorTable& ColorTable = FFloat16ColorTable::Get();
 
     for (int i = 0; i < NumPixels; i++) {
-        const FFloat16Color* CurrentColorFloat = SourceData++;
-        FColor* CurrentColor = DestData++;
-        FLinearColor LinearColor(CurrentColorFloat->R.GetFloat(),
-            CurrentColorFloat->G.GetFloat(),
-            CurrentColorFloat->B.GetFloat(),
-            CurrentColorFloat->A.GetFloat());
-        *CurrentColor = LinearColor.ToFColor(true);
+        //FFloat16Color stores channels in RGBA order
+        const uint16* CurrentColorFloat = SourceData + i * 4;
+        DestData[i] = FColor(ColorTable.SRGBChannel[CurrentColorFloat[0]],
+            ColorTable.SRGBChannel[CurrentColorFloat[1]],
+            ColorTable.SRGBChannel[CurrentColorFloat[2]],
+            ColorTable.LinearChannel[CurrentColorFloat[3]]);
     }
 }
 
 void ConvertGrayscale8ToBGRA8(const void* SourcePixelData, void* DestPixelData, int32 NumPixels) {
     const uint8* SourceData = static_cast<const uint8*>(SourcePixelData);
-    FColor* DestData = static_cast<FColor*>(DestPixelData);
+    uint32* DestData = static_cast<uint32*>(DestPixelData);
+
+    //Replicate gray value into all three color channels with a single multiplication, leaving alpha byte free
+    //Loop has no branches or per-channel stores, so the compiler can vectorize it for the target platform
+    const uint32 ColorChannelMask = FColor(1, 1, 1, 0).DWColor();
+    const uint32 AlphaMask = FColor(0, 0, 0, 255).DWColor();
 
     for (int i = 0; i < NumPixels; i++) {
-        const uint8* CurrentColorGray = SourceData++;
-        FColor* CurrentColor = DestData++;
-        CurrentColor->R = *CurrentColorGray;
-        CurrentColor->G = *CurrentColorGray;
-        CurrentColor->B = *CurrentColorGray;
-        CurrentColor->A = 255;
+        DestData[i] = ((uint32) SourceData[i] * ColorChannelMask) | AlphaMask;
     }
 }
 
 //TODO this path has never been tested, i'm not sure whenever we actually need to apply sRGB color space conversion here
 void ConvertFloatR11G11B10ToBGRA8(const void* SourcePixelData, void* DestPixelData, int32 NumPixels) {
-    const FFloat3Packed* SourceData = static_cast<const FFloat3Packed*>(SourcePixelData);
+    const uint32* SourceData = static_cast<const uint32*>(SourcePixelData);
     FColor* DestData = static_cast<FColor*>(DestPixelData);
+    const FFloat3PackedColorTable& ColorTable = FFloat3PackedColorTable::Get();
 
     for (int i = 0; i < NumPixels; i++) {
-        const FFloat3Packed* CurrentColorFloat = SourceData++;
-        const FColor SourceColor = CurrentColorFloat->ToLinearColor().ToFColor(true);
-        FColor* CurrentColor = DestData++;
-        *CurrentColor = SourceColor;
+        const uint32 CurrentColorFloat = SourceData[i];
+        DestData[i] = FColor(ColorTable.RedChannel[CurrentColorFloat & 0x7FF],
+            ColorTable.GreenChannel[(CurrentColorFloat >> 11) & 0x7FF],
+            ColorTable.BlueChannel[CurrentColorFloat >> 22], 255);
     }
 }
 
+void CopyBGRA8Pixels(const void* SourcePixelData, void* DestPixelData, int32 NumPixels) {
+    FPlatformMemory::Memcpy(DestPixelData, SourcePixelData, NumPixels * 4);
+}
+
 bool FTextureDecompressor::DecompressTextureData(EPixelFormat PixelFormat, const uint8* CompressedData, int32 TextureWidth, int32 TextureHeight, TArray<uint8>& OutDecompressedData, FString* OutErrorMessage) {
+    //Slice size does not matter when there is only one slice
+    return DecompressTextureSlices(PixelFormat, CompressedData, 0, 1, TextureWidth, TextureHeight, OutDecompressedData, OutErrorMessage);
+}
+
+bool FTextureDecompressor::DecompressTextureSlices(EPixelFormat PixelFormat, const uint8* CompressedData, int64 BytesPerSlice, int32 NumSlices, int32 TextureWidth, int32 TextureHeight, TArray<uint8>& OutDecompressedData, FString* OutErrorMessage) {
 
     uint32 SourceTextureFormat = 0;
     bool bDecompressionNeeded = true;
@@ -61,50 +134,25 @@ bool FTextureDecompressor::DecompressTextureData(EPixelFormat PixelFormat, const
         case EPixelFormat::PF_BC7: SourceTextureFormat = DETEX_TEXTURE_FORMAT_BPTC; break;
         default: bDecompressionNeeded = false; break;
     }
-    
-    //C doesn't support const, so we need to cast const-ness away
-    uint8* SourceData = const_cast<uint8*>(CompressedData);
-    const int32 NumPixels = TextureWidth * TextureHeight;
 
-    //Reserve enough space in decompressed data array (we use BGRA8, so 4 channels and 8 bits for channel)
-    const int32 DataOffset = OutDecompressedData.AddUninitialized(NumPixels * 4);
-    uint8* DestData = &OutDecompressedData[DataOffset];
-    const uint32 TargetPixelFormat = DETEX_PIXEL_FORMAT_BGRA8;
-    bool bSuccess;
-
-    if (bDecompressionNeeded) {
-        //Construct compressed detex texture
-        detexTexture DetexTexture;
-        DetexTexture.data = SourceData;
-        DetexTexture.format = SourceTextureFormat;
-        DetexTexture.height = TextureHeight;
-        DetexTexture.width = TextureWidth;
-        
-        //Use GPixelFormats to retrieve width in blocks
-        const FPixelFormatInfo& PixelFormatInfo = GPixelFormats[PixelFormat];
-        DetexTexture.width_in_blocks = TextureWidth / PixelFormatInfo.BlockSizeX;
-        DetexTexture.height_in_blocks = TextureHeight / PixelFormatInfo.BlockSizeY;
-
-        //Perform texture decompression now
-        bSuccess = detexDecompressTextureLinear(&DetexTexture, DestData, TargetPixelFormat);
-        
-    } else {
-        //No need to decompress, but we might need to convert pixels into right format
+    //No need to decompress uncompressed formats, but we might need to convert pixels into right format
+    void (*PixelConverter)(const void*, void*, int32) = NULL;
+    if (!bDecompressionNeeded) {
         if (PixelFormat == EPixelFormat::PF_B8G8R8A8) {
             //No conversion is needed - copy data directly
-            FPlatformMemory::Memcpy(DestData, SourceData, NumPixels * 4);
+            PixelConverter = &CopyBGRA8Pixels;
 
         } else if (PixelFormat == EPixelFormat::PF_G8) {
             //Convert grayscale 8-bit image to gray BGRA8 image
-            ConvertGrayscale8ToBGRA8(SourceData, DestData, NumPixels);
+            PixelConverter = &ConvertGrayscale8ToBGRA8;
 
         } else if (PixelFormat == EPixelFormat::PF_FloatRGBA) {
             //Convert 16-bit FloatRGBA image to BGRA8 image
-            ConvertFloatRGBAToBGRA8(SourceData, DestData, NumPixels);
+            PixelConverter = &ConvertFloatRGBAToBGRA8;
 
         } else if (PixelFormat == EPixelFormat::PF_FloatRGB || PixelFormat == EPixelFormat::PF_FloatR11G11B10) {
             //Convert that weird float low-precision format that nobody is using to BGRA8 image
-            ConvertFloatR11G11B10ToBGRA8(SourceData, DestData, NumPixels);
+            PixelConverter = &ConvertFloatR11G11B10ToBGRA8;
             
         } else {
             //Well, this format is not supported apparently
@@ -113,16 +161,71 @@ bool FTextureDecompressor::DecompressTextureData(EPixelFormat PixelFormat, const
             }
             return false;
         }
-        
-        //Usually conversion is successful when we reach this statement
-        //Else statement will handle failure itself
-        return true;
     }
 
+    //Use GPixelFormats to retrieve block dimensions, uncompressed formats have 1x1 blocks
+    const FPixelFormatInfo& PixelFormatInfo = GPixelFormats[PixelFormat];
+    const int32 BlockSizeY = PixelFormatInfo.BlockSizeY;
+    const int32 WidthInBlocks = TextureWidth / PixelFormatInfo.BlockSizeX;
+    const int32 HeightInBlocks = TextureHeight / BlockSizeY;
+    const int64 BytesPerBlockRow = (int64) WidthInBlocks * PixelFormatInfo.BlockBytes;
+    const int64 NumPixelsPerSlice = (int64) TextureWidth * TextureHeight;
+
+    //Reserve enough space in decompressed data array (we use BGRA8, so 4 channels and 8 bits for channel)
+    //Slices are stacked vertically, e.g. appended one after another
+    const int64 DecompressedDataSize = NumPixelsPerSlice * NumSlices * 4;
+    if ((int64) OutDecompressedData.Num() + DecompressedDataSize > MAX_int32) {
+        if (OutErrorMessage) {
+            *OutErrorMessage = FString::Printf(TEXT("Decompressed texture data of %lld bytes exceeds maximum array size"), DecompressedDataSize);
+        }
+        return false;
+    }
+    const int32 DataOffset = OutDecompressedData.AddUninitialized((int32) DecompressedDataSize);
+    uint8* DestData = &OutDecompressedData[DataOffset];
+
+    //Split every slice into tiles of whole block rows, so all slices and tiles of large textures can be processed in parallel
+    const int32 BlockRowsPerTile = FMath::Max(1, TEXTURE_DECOMPRESSION_TILE_PIXELS / FMath::Max(1, TextureWidth * BlockSizeY));
+    const int32 TilesPerSlice = FMath::DivideAndRoundUp(HeightInBlocks, BlockRowsPerTile);
+    FThreadSafeBool bDecompressionFailed = false;
+    FCriticalSection DetexErrorMessageCriticalSection;
+    FString DetexErrorMessage;
+
+    ParallelFor(TilesPerSlice * NumSlices, [&](const int32 TileIndex) {
+        const int32 SliceIndex = TileIndex / TilesPerSlice;
+        const int32 FirstBlockRow = (TileIndex % TilesPerSlice) * BlockRowsPerTile;
+        const int32 NumBlockRows = FMath::Min(BlockRowsPerTile, HeightInBlocks - FirstBlockRow);
+
+        const uint8* TileSourceData = CompressedData + SliceIndex * BytesPerSlice + FirstBlockRow * BytesPerBlockRow;
+        uint8* TileDestData = DestData + (SliceIndex * NumPixelsPerSlice + (int64) FirstBlockRow * BlockSizeY * TextureWidth) * 4;
+
+        if (bDecompressionNeeded) {
+            //Construct compressed detex texture covering only block rows of this tile
+            //C doesn't support const, so we need to cast const-ness away
+            detexTexture DetexTexture;
+            DetexTexture.data = const_cast<uint8*>(TileSourceData);
+            DetexTexture.format = SourceTextureFormat;
+            DetexTexture.height = FMath::Min(NumBlockRows * BlockSizeY, TextureHeight - FirstBlockRow * BlockSizeY);
+            DetexTexture.width = TextureWidth;
+            DetexTexture.width_in_blocks = WidthInBlocks;
+            DetexTexture.height_in_blocks = NumBlockRows;
+
+            //Perform texture decompression now
+            //Detex error message is only valid on the thread that has failed, so it has to be captured right away
+            if (!detexDecompressTextureLinear(&DetexTexture, TileDestData, DETEX_PIXEL_FORMAT_BGRA8)) {
+                FScopeLock ScopeLock(&DetexErrorMessageCriticalSection);
+                if (!bDecompressionFailed) {
+                    DetexErrorMessage = detexGetErrorMessage();
+                }
+                bDecompressionFailed = true;
+            }
+        } else {
+            PixelConverter(TileSourceData, TileDestData, NumBlockRows * TextureWidth);
+        }
+    });
+
     //Populate error message from detex if user provided pointer to set
-    if (!bSuccess && OutErrorMessage) {
-        const FString DetexErrorMessage = detexGetErrorMessage();
+    if (bDecompressionFailed && OutErrorMessage) {
         *OutErrorMessage = FString::Printf(TEXT("detex returned error: %s"), *DetexErrorMessage);
     }
-    return bSuccess;
+    return !bDecompressionFailed;
 }
@@ -1,9 +1,13 @@
 #include "Toolkit/ObjectHierarchySerializer.h"
+#include "AssetDumperModule.h"
+#include "Util/BinaryJsonSerializer.h"
 #include "Toolkit/PropertySerializer.h"
 #include "UObject/Package.h"
 
 DECLARE_LOG_CATEGORY_CLASS(LogObjectHierarchySerializer, All, All);
+#if ASSET_DUMPER_DEBUG_SERIALIZERS
 PRAGMA_DISABLE_OPTIMIZATION
+#endif
 
 TSet<FName> UObjectHierarchySerializer::UnhandledNativeClasses;
 
@@ -26,11 +30,9 @@ void FObjectCompareContext::SetObjectSettings(int32 ObjectIndex, const FObjectCo
 
 bool FObjectCompareContext::HasObjectAlreadyBeenCompared(int32 ObjectIndex, UObject* Object) {
 	const auto ObjectPair = TPair<int32, UObject*>(ObjectIndex, Object);
-	if (ObjectsAlreadyCompared.Contains(ObjectPair)) {
-		return true;
-	}
-	ObjectsAlreadyCompared.Add(ObjectPair);
-	return false;
+	bool bIsAlreadyInSet = false;
+	ObjectsAlreadyCompared.Add(ObjectPair, &bIsAlreadyInSet);
+	return bIsAlreadyInSet;
 }
 
 FObjectCompareSettings FObjectCompareContext::GetObjectSettings(int32 ObjectIndex) const {
@@ -69,22 +71,30 @@ void UObjectHierarchySerializer::SetPackageForDeserialization(UPackage* SelfPack
 }
 
 void UObjectHierarchySerializer::SetObjectMark(UObject* Object, const FString& ObjectMark) {
-	UObject* const* OldMarkObjectValue = ObjectMarks.FindKey(ObjectMark);
+	UObject* const* OldMarkObjectValue = ObjectsByMark.Find(ObjectMark);
+	UObject* OldMarkObject = OldMarkObjectValue != NULL ? *OldMarkObjectValue : NULL;
 
 	//If we have an old value for this mark and it's the same object, exit early
-	if (OldMarkObjectValue != NULL && *OldMarkObjectValue == Object) {
+	if (OldMarkObject == Object) {
 		return;
 	}
+
+	//Object can only have a single mark, so previous mark of this object no longer resolves to it
+	const FString* PreviousObjectMark = ObjectMarks.Find(Object);
+	if (PreviousObjectMark != NULL) {
+		this->ObjectsByMark.Remove(*PreviousObjectMark);
+	}
 	
 	this->ObjectMarks.Add(Object, ObjectMark);
+	this->ObjectsByMark.Add(ObjectMark, Object);
 	
 	//If we have an old mapping, remove it immediately and try to remap old objects to new ones
-	if (OldMarkObjectValue != NULL) {
-		this->ObjectMarks.Remove(*OldMarkObjectValue);
+	if (OldMarkObject != NULL) {
+		this->ObjectMarks.Remove(OldMarkObject);
 		
 		TArray<int32> IndicesToOverwrite;
 		for (const TPair<int32, UObject*>& Pair : this->LoadedObjects) {
-			if (Pair.Value == *OldMarkObjectValue) {
+			if (Pair.Value == OldMarkObject) {
 				IndicesToOverwrite.Add(Pair.Key);
 			}
 		}
@@ -166,7 +176,7 @@ UObject* UObjectHierarchySerializer::DeserializeObject(int32 Index) {
             
             //Object is serialized through object mark
             const FString ObjectMark = ObjectJson->GetStringField(TEXT("ObjectMark"));
-            UObject* const* FoundObject = ObjectMarks.FindKey(ObjectMark);
+            UObject* const* FoundObject = ObjectsByMark.Find(ObjectMark);
             checkf(FoundObject, TEXT("Cannot resolve object serialized using mark: %s"), *ObjectMark);
             ConstructedObject = *FoundObject;
             
@@ -194,13 +204,12 @@ void UObjectHierarchySerializer::SerializeObjectPropertiesIntoObject(UObject* Ob
 	TArray<int32> ReferencedSubobjects;
 
 	//Serialize actual object property values
-    for (FProperty* Property = ObjectClass->PropertyLink; Property; Property = Property->PropertyLinkNext) {
-        if (PropertySerializer->ShouldSerializeProperty(Property)) {
-            const void* PropertyValue = Property->ContainerPtrToValuePtr<void>(Object);
-            TSharedRef<FJsonValue> PropertyValueJson = PropertySerializer->SerializePropertyValue(Property, PropertyValue, &ReferencedSubobjects);
-        	
-            Properties->SetField(Property->GetName(), PropertyValueJson);
-        }
+	const TSharedRef<const FStructSerializationPlan> Plan = PropertySerializer->GetStructSerializationPlan(ObjectClass);
+    for (const FPropertySerializationInfo& PropertyInfo : Plan->Properties) {
+        const void* PropertyValue = PropertyInfo.Property->ContainerPtrToValuePtr<void>(Object);
+        TSharedRef<FJsonValue> PropertyValueJson = PropertySerializer->SerializePropertyValue(PropertyInfo, PropertyValue, &ReferencedSubobjects);
+    	
+        Properties->SetField(PropertyInfo.PropertyName, PropertyValueJson);
     }
 
 	//Remove NULL from referenced subobjects because writing it down is useless
@@ -263,7 +272,7 @@ bool UObjectHierarchySerializer::CompareObjectsWithContext(const int32 ObjectInd
 	//Check if object is serialized through mark first
 	if (ObjectJson->HasField(TEXT("ObjectMark"))) {
 		const FString ObjectMark = ObjectJson->GetStringField(TEXT("ObjectMark"));
-		UObject* const* FoundObject = ObjectMarks.FindKey(ObjectMark);
+		UObject* const* FoundObject = ObjectsByMark.Find(ObjectMark);
 		checkf(FoundObject, TEXT("Cannot resolve object serialized using mark: %s"), *ObjectMark);
 		UObject* RegisteredObject = *FoundObject;
 
@@ -310,14 +319,14 @@ bool UObjectHierarchySerializer::AreObjectPropertiesUpToDate(const TSharedPtr<FJ
 
 	//Iterate all properties and return false if our values do not match existing ones
 	//This will also try to deserialize objects in "read only" mode, incrementing ObjectsNotUpToDate when existing object fields mismatch
-	for (FProperty* Property = ObjectClass->PropertyLink; Property; Property = Property->PropertyLinkNext) {
-		const FString PropertyName = Property->GetName();
+	const TSharedRef<const FStructSerializationPlan> Plan = PropertySerializer->GetStructSerializationPlan(ObjectClass);
+	for (const FPropertySerializationInfo& PropertyInfo : Plan->Properties) {
+		const TSharedPtr<FJsonValue>* ValueObject = Properties->Values.Find(PropertyInfo.PropertyName);
 		
-		if (PropertySerializer->ShouldSerializeProperty(Property) && Properties->HasField(PropertyName)) {
-			const void* PropertyValue = Property->ContainerPtrToValuePtr<void>(Object);
-			const TSharedPtr<FJsonValue> ValueObject = Properties->Values.FindChecked(PropertyName);
+		if (ValueObject != NULL && ValueObject->IsValid()) {
+			const void* PropertyValue = PropertyInfo.Property->ContainerPtrToValuePtr<void>(Object);
 
-			if (!PropertySerializer->ComparePropertyValues(Property, ValueObject.ToSharedRef(), PropertyValue, Context)) {
+			if (!PropertySerializer->ComparePropertyValues(PropertyInfo, ValueObject->ToSharedRef(), PropertyValue, Context)) {
 				return false;
 			}
 		}
@@ -366,14 +375,13 @@ void UObjectHierarchySerializer::FlushPropertiesIntoObject(const int32 ObjectInd
 
 void UObjectHierarchySerializer::DeserializeObjectProperties(const TSharedPtr<FJsonObject>& Properties, UObject* Object) {
     UClass* ObjectClass = Object->GetClass();
-    for (FProperty* Property = ObjectClass->PropertyLink; Property; Property = Property->PropertyLinkNext) {
-        const FString PropertyName = Property->GetName();
+	const TSharedRef<const FStructSerializationPlan> Plan = PropertySerializer->GetStructSerializationPlan(ObjectClass);
+    for (const FPropertySerializationInfo& PropertyInfo : Plan->Properties) {
+        const TSharedPtr<FJsonValue>* ValueObject = Properties->Values.Find(PropertyInfo.PropertyName);
     	
-        if (PropertySerializer->ShouldSerializeProperty(Property) && Properties->HasField(PropertyName)) {
-            void* PropertyValue = Property->ContainerPtrToValuePtr<void>(Object);
-            const TSharedPtr<FJsonValue>& ValueObject = Properties->Values.FindChecked(PropertyName);
-        	
-        	PropertySerializer->DeserializePropertyValue(Property, ValueObject.ToSharedRef(), PropertyValue);
+        if (ValueObject != NULL && ValueObject->IsValid()) {
+            void* PropertyValue = PropertyInfo.Property->ContainerPtrToValuePtr<void>(Object);
+        	PropertySerializer->DeserializePropertyValue(PropertyInfo, ValueObject->ToSharedRef(), PropertyValue);
         }
     }
 }
@@ -389,41 +397,92 @@ TArray<TSharedPtr<FJsonValue>> UObjectHierarchySerializer::FinalizeSerialization
     return ObjectsArray;
 }
 
+void UObjectHierarchySerializer::FinalizeSerialization(const TSharedRef<FJsonFileWriter>& Writer, const FString& Identifier) {
+	Writer->WriteArrayStart(Identifier);
+	ReleaseSerializedObjects([&Writer](const TSharedRef<FJsonObject>& ObjectJson) {
+		FJsonSerializer::Serialize(ObjectJson, Writer, false);
+	});
+	Writer->WriteArrayEnd();
+}
+
+void UObjectHierarchySerializer::FinalizeSerialization(FBinaryJsonWriter& Writer, const FString& Identifier) {
+	Writer.WriteIdentifier(Identifier);
+	Writer.WriteArrayStart();
+	ReleaseSerializedObjects([&Writer](const TSharedRef<FJsonObject>& ObjectJson) {
+		Writer.WriteObject(ObjectJson);
+	});
+	Writer.WriteEnd();
+}
+
+void UObjectHierarchySerializer::ReleaseSerializedObjects(TFunctionRef<void(const TSharedRef<FJsonObject>& ObjectJson)> Callback) {
+	for (int32 i = 0; i < LastObjectIndex; i++) {
+		TSharedPtr<FJsonObject> ObjectJson;
+		if (!SerializedObjects.RemoveAndCopyValue(i, ObjectJson)) {
+			checkf(false, TEXT("Object not in serialized objects: %s"), *(*ObjectIndices.FindKey(i))->GetPathName());
+		}
+		//Object json is dropped right after we write it, so we never hold both json tree and it's encoded form in memory
+		Callback(ObjectJson.ToSharedRef());
+	}
+}
+
+/** Appends package name to the output array unless it has already been added to it */
+void AddReferencedPackageName(const FString& PackageName, TArray<FString>& OutReferencedPackageNames, TSet<FString>& ReferencedPackageNameSet) {
+	bool bIsAlreadyInSet = false;
+	ReferencedPackageNameSet.Add(PackageName, &bIsAlreadyInSet);
+	if (!bIsAlreadyInSet) {
+		OutReferencedPackageNames.Add(PackageName);
+	}
+}
+
 void UObjectHierarchySerializer::CollectReferencedPackages(const TArray<TSharedPtr<FJsonValue>>& ReferencedSubobjects, TArray<FString>& OutReferencedPackageNames) {
-	TArray<int32> AlreadySerializedObjects;
+	TSet<int32> AlreadySerializedObjects;
 	CollectReferencedPackages(ReferencedSubobjects, OutReferencedPackageNames, AlreadySerializedObjects);
 }
 
-void UObjectHierarchySerializer::CollectReferencedPackages(const TArray<TSharedPtr<FJsonValue>>& ReferencedSubobjects, TArray<FString>& OutReferencedPackageNames, TArray<int32>& ObjectsAlreadySerialized) {
+void UObjectHierarchySerializer::CollectReferencedPackages(const TArray<TSharedPtr<FJsonValue>>& ReferencedSubobjects, TArray<FString>& OutReferencedPackageNames, TSet<int32>& ObjectsAlreadySerialized) {
+	//Callers can pass the same array multiple times, so packages already in it have to be taken into account
+	TSet<FString> ReferencedPackageNameSet;
+	ReferencedPackageNameSet.Append(OutReferencedPackageNames);
+	CollectReferencedPackages(ReferencedSubobjects, OutReferencedPackageNames, ReferencedPackageNameSet, ObjectsAlreadySerialized);
+}
+
+void UObjectHierarchySerializer::CollectReferencedPackages(const TArray<TSharedPtr<FJsonValue>>& ReferencedSubobjects, TArray<FString>& OutReferencedPackageNames, TSet<FString>& ReferencedPackageNameSet, TSet<int32>& ObjectsAlreadySerialized) {
 	for (const TSharedPtr<FJsonValue>& JsonValue : ReferencedSubobjects) {
-		CollectObjectPackages(JsonValue->AsNumber(), OutReferencedPackageNames, ObjectsAlreadySerialized);
+		CollectObjectPackagesInternal(JsonValue->AsNumber(), OutReferencedPackageNames, ReferencedPackageNameSet, ObjectsAlreadySerialized);
 	}
 }
 
-void UObjectHierarchySerializer::CollectObjectPackages(const int32 ObjectIndex, TArray<FString>& OutReferencedPackageNames, TArray<int32>& ObjectsAlreadySerialized) {
+void UObjectHierarchySerializer::CollectObjectPackages(const int32 ObjectIndex, TArray<FString>& OutReferencedPackageNames, TSet<int32>& ObjectsAlreadySerialized) {
+	TSet<FString> ReferencedPackageNameSet;
+	ReferencedPackageNameSet.Append(OutReferencedPackageNames);
+	CollectObjectPackagesInternal(ObjectIndex, OutReferencedPackageNames, ReferencedPackageNameSet, ObjectsAlreadySerialized);
+}
+
+void UObjectHierarchySerializer::CollectObjectPackagesInternal(const int32 ObjectIndex, TArray<FString>& OutReferencedPackageNames, TSet<FString>& ReferencedPackageNameSet, TSet<int32>& ObjectsAlreadySerialized) {
     if (ObjectIndex == INDEX_NONE) {
         return;
     }
-	if (ObjectsAlreadySerialized.Contains(ObjectIndex)) {
+	bool bIsAlreadySerialized = false;
+	ObjectsAlreadySerialized.Add(ObjectIndex, &bIsAlreadySerialized);
+	if (bIsAlreadySerialized) {
 		return;
 	}
 	
-	ObjectsAlreadySerialized.Add(ObjectIndex);
     const TSharedPtr<FJsonObject> Object = SerializedObjects.FindChecked(ObjectIndex);
     const FString ObjectType = Object->GetStringField(TEXT("Type"));
     
     if (ObjectType == TEXT("Import")) {
         const FString ClassPackage = Object->GetStringField(TEXT("ClassPackage"));
         if (!ClassPackage.StartsWith(TEXT("/Script/"))) {
-            OutReferencedPackageNames.AddUnique(ClassPackage);
+            AddReferencedPackageName(ClassPackage, OutReferencedPackageNames, ReferencedPackageNameSet);
         }
 
         if (Object->HasField(TEXT("Outer"))) {
             const int32 OuterObjectIndex = Object->GetIntegerField(TEXT("Outer"));
-            CollectObjectPackages(OuterObjectIndex, OutReferencedPackageNames, ObjectsAlreadySerialized);
+            CollectObjectPackagesInternal(OuterObjectIndex, OutReferencedPackageNames, ReferencedPackageNameSet, ObjectsAlreadySerialized);
         } else {
             const FString PackageName = Object->GetStringField(TEXT("ObjectName"));
-            OutReferencedPackageNames.AddUnique(PackageName);
+            AddReferencedPackageName(PackageName, OutReferencedPackageNames, ReferencedPackageNameSet);
         }
 
     } else if (ObjectType == TEXT("Export")) {
@@ -432,22 +491,38 @@ void UObjectHierarchySerializer::CollectObjectPackages(const int32 ObjectIndex,
         }
 
         const int32 ObjectClassIndex = Object->GetIntegerField(TEXT("ObjectClass"));
-        CollectObjectPackages(ObjectClassIndex, OutReferencedPackageNames, ObjectsAlreadySerialized);
+        CollectObjectPackagesInternal(ObjectClassIndex, OutReferencedPackageNames, ReferencedPackageNameSet, ObjectsAlreadySerialized);
 
         if (Object->HasField(TEXT("Outer"))) {
             const int32 OuterObjectIndex = Object->GetIntegerField(TEXT("Outer"));
-            CollectObjectPackages(OuterObjectIndex, OutReferencedPackageNames, ObjectsAlreadySerialized);
+            CollectObjectPackagesInternal(OuterObjectIndex, OutReferencedPackageNames, ReferencedPackageNameSet, ObjectsAlreadySerialized);
         }
 
         if (Object->HasField(TEXT("Properties"))) {
             const TSharedPtr<FJsonObject> Properties = Object->GetObjectField(TEXT("Properties"));
-        	const TArray<TSharedPtr<FJsonValue>> ReferencedSubobjects = Properties->GetArrayField(TEXT("$ReferencedObjects"));
+        	const TArray<TSharedPtr<FJsonValue>>& ReferencedSubobjects = Properties->GetArrayField(TEXT("$ReferencedObjects"));
 
-        	CollectReferencedPackages(ReferencedSubobjects, OutReferencedPackageNames, ObjectsAlreadySerialized);
+        	for (const TSharedPtr<FJsonValue>& JsonValue : ReferencedSubobjects) {
+        		CollectObjectPackagesInternal(JsonValue->AsNumber(), OutReferencedPackageNames, ReferencedPackageNameSet, ObjectsAlreadySerialized);
+        	}
         }
     }
 }
 
+void UObjectHierarchySerializer::CollectImportedPackages(TArray<FName>& OutPackageNames) const {
+	TSet<FName> ImportedPackageNames;
+	for (const TPair<UObject*, int32>& Pair : ObjectIndices) {
+		const UPackage* ObjectPackage = Pair.Key->GetOutermost();
+		if (ObjectPackage != SourcePackage) {
+			ImportedPackageNames.Add(ObjectPackage->GetFName());
+		}
+	}
+
+	TArray<FName> SortedPackageNames = ImportedPackageNames.Array();
+	SortedPackageNames.Sort([](const FName& A, const FName& B) { return A.LexicalLess(B); });
+	OutPackageNames.Append(SortedPackageNames);
+}
+
 FString UObjectHierarchySerializer::GetObjectFullPath(int32 ObjectIndex) {
 	const TSharedPtr<FJsonObject> Object = SerializedObjects.FindChecked(ObjectIndex);
 	const FString ObjectType = Object->GetStringField(TEXT("Type"));
@@ -647,4 +722,6 @@ void UObjectHierarchySerializer::SerializeExportedObject(TSharedPtr<FJsonObject>
     }
 }
 
+#if ASSET_DUMPER_DEBUG_SERIALIZERS
 PRAGMA_ENABLE_OPTIMIZATION
+#endif
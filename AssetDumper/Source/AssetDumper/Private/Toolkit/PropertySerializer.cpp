@@ -1,10 +1,13 @@
 #include "Toolkit/PropertySerializer.h"
+#include "AssetDumperModule.h"
 #include "Toolkit/ObjectHierarchySerializer.h"
 #include "UObject/TextProperty.h"
 
 DECLARE_LOG_CATEGORY_CLASS(LogPropertySerializer, Error, Log);
 
+#if ASSET_DUMPER_DEBUG_SERIALIZERS
 PRAGMA_DISABLE_OPTIMIZATION
+#endif
 
 void FDateTimeSerializer::Serialize(UScriptStruct* Struct, const TSharedPtr<FJsonObject> JsonValue, const void* StructData, TArray<int32>* OutReferencedSubobjects) {
 	const FDateTime* DateTime = (const FDateTime*) StructData;
@@ -44,41 +47,39 @@ FFallbackStructSerializer::FFallbackStructSerializer(UPropertySerializer* Serial
 }
 
 void FFallbackStructSerializer::Serialize(UScriptStruct* Struct, const TSharedPtr<FJsonObject> JsonValue, const void* StructData, TArray<int32>* OutReferencedSubobjects) {
-	for (FProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext) {
-
-		if (PropertySerializer->ShouldSerializeProperty(Property)) {
-			const void* PropertyValue = Property->ContainerPtrToValuePtr<void>(StructData);
-			
-			const TSharedRef<FJsonValue> PropertyValueJson = PropertySerializer->SerializePropertyValue(Property, PropertyValue, OutReferencedSubobjects);
-			JsonValue->SetField(Property->GetName(), PropertyValueJson);
-		}
+	const TSharedRef<const FStructSerializationPlan> Plan = PropertySerializer->GetStructSerializationPlan(Struct);
+	
+	for (const FPropertySerializationInfo& PropertyInfo : Plan->Properties) {
+		const void* PropertyValue = PropertyInfo.Property->ContainerPtrToValuePtr<void>(StructData);
+		
+		const TSharedRef<FJsonValue> PropertyValueJson = PropertySerializer->SerializePropertyValue(PropertyInfo, PropertyValue, OutReferencedSubobjects);
+		JsonValue->SetField(PropertyInfo.PropertyName, PropertyValueJson);
 	}
 }
 
 void FFallbackStructSerializer::Deserialize(UScriptStruct* Struct, void* StructData, const TSharedPtr<FJsonObject> JsonValue) {
-	for (FProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext) {
-		const FString PropertyName = Property->GetName();
+	const TSharedRef<const FStructSerializationPlan> Plan = PropertySerializer->GetStructSerializationPlan(Struct);
+	
+	for (const FPropertySerializationInfo& PropertyInfo : Plan->Properties) {
+		const TSharedPtr<FJsonValue>* ValueObject = JsonValue->Values.Find(PropertyInfo.PropertyName);
 		
-		if (PropertySerializer->ShouldSerializeProperty(Property) && JsonValue->HasField(PropertyName)) {
-			void* PropertyValue = Property->ContainerPtrToValuePtr<void>(StructData);
-			const TSharedPtr<FJsonValue> ValueObject = JsonValue->Values.FindChecked(PropertyName);
-			
-			if (ValueObject.IsValid()) {
-				PropertySerializer->DeserializePropertyValue(Property, ValueObject.ToSharedRef(), PropertyValue);
-			}
+		if (ValueObject != NULL && ValueObject->IsValid()) {
+			void* PropertyValue = PropertyInfo.Property->ContainerPtrToValuePtr<void>(StructData);
+			PropertySerializer->DeserializePropertyValue(PropertyInfo, ValueObject->ToSharedRef(), PropertyValue);
 		}
 	}
 }
 
 bool FFallbackStructSerializer::Compare(UScriptStruct* Struct, const TSharedPtr<FJsonObject> JsonValue, const void* StructData, const TSharedPtr<FObjectCompareContext> Context) {
-	for (FProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext) {
-		const FString PropertyName = Property->GetName();
+	const TSharedRef<const FStructSerializationPlan> Plan = PropertySerializer->GetStructSerializationPlan(Struct);
+	
+	for (const FPropertySerializationInfo& PropertyInfo : Plan->Properties) {
+		const TSharedPtr<FJsonValue>* ValueObject = JsonValue->Values.Find(PropertyInfo.PropertyName);
 		
-		if (PropertySerializer->ShouldSerializeProperty(Property) && JsonValue->HasField(PropertyName)) {
-			const void* PropertyValue = Property->ContainerPtrToValuePtr<void>(StructData);
-			const TSharedPtr<FJsonValue> ValueObject = JsonValue->Values.FindChecked(PropertyName);
+		if (ValueObject != NULL && ValueObject->IsValid()) {
+			const void* PropertyValue = PropertyInfo.Property->ContainerPtrToValuePtr<void>(StructData);
 
-			if (!PropertySerializer->ComparePropertyValues(Property, ValueObject.ToSharedRef(), PropertyValue, Context)) {
+			if (!PropertySerializer->ComparePropertyValues(PropertyInfo, ValueObject->ToSharedRef(), PropertyValue, Context)) {
 				return false;
 			}
 		}
@@ -86,6 +87,112 @@ bool FFallbackStructSerializer::Compare(UScriptStruct* Struct, const TSharedPtr<
 	return true;
 }
 
+FPropertySerializationInfo::FPropertySerializationInfo(FProperty* Property) :
+	Property(Property), ElementType(EPropertyValueType::Unsupported), MapValueType(EPropertyValueType::Unsupported) {
+	this->ValueType = UPropertySerializer::ResolvePropertyValueType(Property);
+
+	if (const FMapProperty* MapProperty = CastField<const FMapProperty>(Property)) {
+		this->ElementType = UPropertySerializer::ResolvePropertyValueType(MapProperty->KeyProp);
+		this->MapValueType = UPropertySerializer::ResolvePropertyValueType(MapProperty->ValueProp);
+	} else if (const FSetProperty* SetProperty = CastField<const FSetProperty>(Property)) {
+		this->ElementType = UPropertySerializer::ResolvePropertyValueType(SetProperty->ElementProp);
+	} else if (const FArrayProperty* ArrayProperty = CastField<const FArrayProperty>(Property)) {
+		this->ElementType = UPropertySerializer::ResolvePropertyValueType(ArrayProperty->Inner);
+	}
+}
+
+FPropertySerializationInfo::FPropertySerializationInfo(FProperty* Property, EPropertyValueType ValueType) :
+	Property(Property), ValueType(ValueType), ElementType(EPropertyValueType::Unsupported), MapValueType(EPropertyValueType::Unsupported) {
+}
+
+FStructSerializationPlanCache& FStructSerializationPlanCache::Get() {
+	static FStructSerializationPlanCache PlanCache;
+	return PlanCache;
+}
+
+void FStructSerializationPlanCache::Initialize() {
+	this->PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FStructSerializationPlanCache::OnPostGarbageCollect);
+	this->ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddRaw(this, &FStructSerializationPlanCache::OnObjectsReplaced);
+}
+
+void FStructSerializationPlanCache::Shutdown() {
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+	FCoreUObjectDelegates::OnObjectsReplaced.Remove(ObjectsReplacedHandle);
+	InvalidateAllPlans();
+}
+
+void FStructSerializationPlanCache::OnPostGarbageCollect() {
+	FScopeLock ScopeLock(&CriticalSection);
+	for (TMap<UStruct*, FCachedPlan>::TIterator It = CachedPlans.CreateIterator(); It; ++It) {
+		if (!It.Value().Struct.IsValid()) {
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FStructSerializationPlanCache::OnObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap) {
+	FScopeLock ScopeLock(&CriticalSection);
+	for (const TPair<UObject*, UObject*>& Pair : ReplacementMap) {
+		if (UStruct* ReplacedStruct = Cast<UStruct>(Pair.Key)) {
+			this->CachedPlans.Remove(ReplacedStruct);
+		}
+	}
+}
+
+TSharedRef<const FStructSerializationPlan> FStructSerializationPlanCache::FindOrBuildPlan(UStruct* Struct) {
+	check(Struct);
+	FScopeLock ScopeLock(&CriticalSection);
+	
+	const FCachedPlan* ExistingPlan = CachedPlans.Find(Struct);
+	if (ExistingPlan != NULL && ExistingPlan->Struct.Get() == Struct) {
+		return ExistingPlan->Plan;
+	}
+
+	const TSharedRef<FStructSerializationPlan> NewPlan = MakeShared<FStructSerializationPlan>();
+	for (FProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext) {
+		if (ShouldSerializePropertyByDefault(Property)) {
+			FPropertySerializationInfo& PropertyInfo = NewPlan->Properties.Add_GetRef(FPropertySerializationInfo(Property));
+			PropertyInfo.PropertyName = Property->GetName();
+		}
+	}
+	this->CachedPlans.Add(Struct, FCachedPlan{Struct, NewPlan});
+	return NewPlan;
+}
+
+void FStructSerializationPlanCache::InvalidatePlans(UStruct* Struct) {
+	if (Struct == NULL) {
+		return;
+	}
+	FScopeLock ScopeLock(&CriticalSection);
+	for (TMap<UStruct*, FCachedPlan>::TIterator It = CachedPlans.CreateIterator(); It; ++It) {
+		const UStruct* CachedStruct = It.Value().Struct.Get();
+		if (CachedStruct == NULL || CachedStruct->IsChildOf(Struct)) {
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FStructSerializationPlanCache::InvalidateAllPlans() {
+	FScopeLock ScopeLock(&CriticalSection);
+	this->CachedPlans.Empty();
+}
+
+bool FStructSerializationPlanCache::ShouldSerializePropertyByDefault(FProperty* Property) {
+	//skip transient properties
+	if (Property->HasAnyPropertyFlags(CPF_Transient)) {
+		return false;
+	}
+	//Skip editor only properties altogether
+	if (Property->HasAnyPropertyFlags(CPF_EditorOnly)) {
+		return false;
+	}
+	//Skip deprecated properties
+	if (Property->HasAnyPropertyFlags(CPF_Deprecated)) {
+		return false;
+	}
+	return true;
+}
+
 UPropertySerializer::UPropertySerializer() {
 	this->FallbackStructSerializer = MakeShared<FFallbackStructSerializer>(this);
 
@@ -99,6 +206,11 @@ UPropertySerializer::UPropertySerializer() {
 }
 
 void UPropertySerializer::DeserializePropertyValue(FProperty* Property, const TSharedRef<FJsonValue>& JsonValue, void* Value) {
+	DeserializePropertyValue(FPropertySerializationInfo(Property), JsonValue, Value);
+}
+
+void UPropertySerializer::DeserializePropertyValue(const FPropertySerializationInfo& PropertyInfo, const TSharedRef<FJsonValue>& JsonValue, void* Value) {
+	FProperty* Property = PropertyInfo.Property;
 
 	//Handle statically sized array properties
 	if (Property->ArrayDim != 1) {
@@ -109,21 +221,21 @@ void UPropertySerializer::DeserializePropertyValue(FProperty* Property, const TS
 			uint8* ArrayPropertyValue = (uint8*) Value + Property->ElementSize * ArrayIndex;
 			const TSharedRef<FJsonValue> ArrayJsonValue = ArrayElements[ArrayIndex].ToSharedRef();
 			
-			DeserializePropertyValueInner(Property, ArrayJsonValue, ArrayPropertyValue);
+			DeserializePropertyValueInner(PropertyInfo, ArrayJsonValue, ArrayPropertyValue);
 		}
 	} else {
-		DeserializePropertyValueInner(Property, JsonValue, Value);
+		DeserializePropertyValueInner(PropertyInfo, JsonValue, Value);
 	}
 }
 
-void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, const TSharedRef<FJsonValue>& JsonValue, void* Value) {
-	const FMapProperty* MapProperty = CastField<const FMapProperty>(Property);
-	const FSetProperty* SetProperty = CastField<const FSetProperty>(Property);
-	const FArrayProperty* ArrayProperty = CastField<const FArrayProperty>(Property);
+void UPropertySerializer::DeserializePropertyValueInner(const FPropertySerializationInfo& PropertyInfo, const TSharedRef<FJsonValue>& JsonValue, void* Value) {
+	FProperty* Property = PropertyInfo.Property;
 
-	if (MapProperty) {
-		FProperty* KeyProperty = MapProperty->KeyProp;
-		FProperty* ValueProperty = MapProperty->ValueProp;
+	switch (PropertyInfo.ValueType) {
+	case EPropertyValueType::Map: {
+		const FMapProperty* MapProperty = CastFieldChecked<const FMapProperty>(Property);
+		const FPropertySerializationInfo KeyInfo(MapProperty->KeyProp, PropertyInfo.ElementType);
+		const FPropertySerializationInfo ValueInfo(MapProperty->ValueProp, PropertyInfo.MapValueType);
 		FScriptMapHelper MapHelper(MapProperty, Value);
 		const TArray<TSharedPtr<FJsonValue>>& PairArray = JsonValue->AsArray();
 
@@ -134,13 +246,16 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 			const int32 Index = MapHelper.AddDefaultValue_Invalid_NeedsRehash();
 			uint8* PairPtr = MapHelper.GetPairPtr(Index);
 			// Copy over imported key and value from temporary storage
-			DeserializePropertyValue(KeyProperty, EntryKey.ToSharedRef(), PairPtr);
-			DeserializePropertyValue(ValueProperty, EntryValue.ToSharedRef(), PairPtr + MapHelper.MapLayout.ValueOffset);
+			DeserializePropertyValue(KeyInfo, EntryKey.ToSharedRef(), PairPtr);
+			DeserializePropertyValue(ValueInfo, EntryValue.ToSharedRef(), PairPtr + MapHelper.MapLayout.ValueOffset);
 		}
 		MapHelper.Rehash();
-
-	} else if (SetProperty) {
+		break;
+	}
+	case EPropertyValueType::Set: {
+		const FSetProperty* SetProperty = CastFieldChecked<const FSetProperty>(Property);
 		FProperty* ElementProperty = SetProperty->ElementProp;
+		const FPropertySerializationInfo ElementInfo(ElementProperty, PropertyInfo.ElementType);
 		FScriptSetHelper SetHelper(SetProperty, Value);
 		const TArray<TSharedPtr<FJsonValue>>& SetArray = JsonValue->AsArray();
 		SetHelper.EmptyElements();
@@ -149,7 +264,7 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 		
 		for (int32 i = 0; i < SetArray.Num(); i++) {
 			const TSharedPtr<FJsonValue>& Element = SetArray[i];
-			DeserializePropertyValue(ElementProperty, Element.ToSharedRef(), TempElementStorage);
+			DeserializePropertyValue(ElementInfo, Element.ToSharedRef(), TempElementStorage);
 			
 			const int32 NewElementIndex = SetHelper.AddDefaultValue_Invalid_NeedsRehash();
 			uint8* NewElementPtr = SetHelper.GetElementPtr(NewElementIndex);
@@ -161,9 +276,11 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 
 		ElementProperty->DestroyValue(TempElementStorage);
 		FMemory::Free(TempElementStorage);
-		
-	} else if (ArrayProperty) {
-		FProperty* ElementProperty = ArrayProperty->Inner;
+		break;
+	}
+	case EPropertyValueType::Array: {
+		const FArrayProperty* ArrayProperty = CastFieldChecked<const FArrayProperty>(Property);
+		const FPropertySerializationInfo ElementInfo(ArrayProperty->Inner, PropertyInfo.ElementType);
 		FScriptArrayHelper ArrayHelper(ArrayProperty, Value);
 		const TArray<TSharedPtr<FJsonValue>>& SetArray = JsonValue->AsArray();
 		ArrayHelper.EmptyValues();
@@ -172,10 +289,11 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 			const TSharedPtr<FJsonValue>& Element = SetArray[i];
 			const uint32 AddedIndex = ArrayHelper.AddValue();
 			uint8* ValuePtr = ArrayHelper.GetRawPtr(AddedIndex);
-			DeserializePropertyValue(ElementProperty, Element.ToSharedRef(), ValuePtr);
+			DeserializePropertyValue(ElementInfo, Element.ToSharedRef(), ValuePtr);
 		}
-		
-	} else if (Property->IsA<FMulticastDelegateProperty>()) {
+		break;
+	}
+	case EPropertyValueType::MulticastDelegate: {
 		/*FMulticastScriptDelegate* MulticastScriptDelegate = (FMulticastScriptDelegate*) Value;
 		const TArray<TSharedPtr<FJsonValue>>& DelegatesArray = JsonValue->AsArray();
 
@@ -191,8 +309,9 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 				MulticastScriptDelegate->Add(ScriptDelegate);
 			}
 		}*/
-
-	} else if (Property->IsA<FDelegateProperty>()) {
+		break;
+	}
+	case EPropertyValueType::Delegate: {
 		/*FScriptDelegate* ScriptDelegate = (FScriptDelegate*) Value;
 		TSharedPtr<FJsonObject> Element = JsonValue->AsObject();
 
@@ -202,8 +321,10 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 			
 			ScriptDelegate->BindUFunction(Object, *FunctionName);
 		}*/
-		
-	} else if (const FInterfaceProperty* InterfaceProperty = CastField<const FInterfaceProperty>(Property)) {
+		break;
+	}
+	case EPropertyValueType::Interface: {
+		const FInterfaceProperty* InterfaceProperty = CastFieldChecked<const FInterfaceProperty>(Property);
 		//UObject is enough to re-create value, since we known property on deserialization
 		FScriptInterface* Interface = static_cast<FScriptInterface*>(Value);
 		UObject* Object = ObjectHierarchySerializer ? ObjectHierarchySerializer->DeserializeObject((int32) JsonValue->AsNumber()) : NULL;
@@ -213,23 +334,30 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 			Interface->SetObject(Object);
 			Interface->SetInterface(InterfacePtr);
 		}
-
-	} else if (Property->IsA<FSoftObjectProperty>()) {
+		break;
+	}
+	case EPropertyValueType::SoftObject: {
 		//For soft object reference, path is enough too for deserialization.
 		const FString PathString = JsonValue->AsString();
 		FSoftObjectPtr* ObjectPtr = static_cast<FSoftObjectPtr*>(Value);
 		*ObjectPtr = FSoftObjectPath(PathString);
-
-	} else if (const FObjectPropertyBase* ObjectProperty = CastField<const FObjectPropertyBase>(Property)) {
+		break;
+	}
+	case EPropertyValueType::Object: {
+		const FObjectPropertyBase* ObjectProperty = CastFieldChecked<const FObjectPropertyBase>(Property);
 		//Need to serialize full UObject for object property
 		UObject* Object = ObjectHierarchySerializer ? ObjectHierarchySerializer->DeserializeObject((int32) JsonValue->AsNumber()) : NULL;
 		ObjectProperty->SetObjectPropertyValue(Value, Object);
-
-	} else if (const FStructProperty* StructProperty = CastField<const FStructProperty>(Property)) {
+		break;
+	}
+	case EPropertyValueType::Struct: {
+		const FStructProperty* StructProperty = CastFieldChecked<const FStructProperty>(Property);
 		//To serialize struct, we need it's type and value pointer, because struct value doesn't contain type information
 		DeserializeStruct(StructProperty->Struct, JsonValue->AsObject().ToSharedRef(), Value);
-
-	} else if (const FByteProperty* ByteProperty = CastField<const FByteProperty>(Property)) {
+		break;
+	}
+	case EPropertyValueType::Byte: {
+		const FByteProperty* ByteProperty = CastFieldChecked<const FByteProperty>(Property);
 		//If we have a string provided, make sure Enum is not null
 		if (JsonValue->Type == EJson::String) {
 			check(ByteProperty->Enum);
@@ -240,45 +368,59 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 			const int64 NumberValue = (int64) JsonValue->AsNumber();
 			ByteProperty->SetIntPropertyValue(Value, NumberValue);
 		}
-		//Primitives below, they are serialized as plain json values
-	} else if (const FNumericProperty* NumberProperty = CastField<const FNumericProperty>(Property)) {
+		break;
+	}
+	//Primitives below, they are serialized as plain json values
+	case EPropertyValueType::Numeric: {
+		const FNumericProperty* NumberProperty = CastFieldChecked<const FNumericProperty>(Property);
 		const double NumberValue = JsonValue->AsNumber();
 		if (NumberProperty->IsFloatingPoint())
 			NumberProperty->SetFloatingPointPropertyValue(Value, NumberValue);
 		else NumberProperty->SetIntPropertyValue(Value, static_cast<int64>(NumberValue));
-		
-	} else if (const FBoolProperty* BoolProperty = CastField<const FBoolProperty>(Property)) {
+		break;
+	}
+	case EPropertyValueType::Bool: {
+		const FBoolProperty* BoolProperty = CastFieldChecked<const FBoolProperty>(Property);
 		const bool bBooleanValue = JsonValue->AsBool();
 		BoolProperty->SetPropertyValue(Value, bBooleanValue);
-
-	} else if (Property->IsA<FStrProperty>()) {
+		break;
+	}
+	case EPropertyValueType::String: {
 		const FString StringValue = JsonValue->AsString();
 		*static_cast<FString*>(Value) = StringValue;
-
-	} else if (const FEnumProperty* EnumProperty = CastField<const FEnumProperty>(Property)) {
+		break;
+	}
+	case EPropertyValueType::Enum: {
+		const FEnumProperty* EnumProperty = CastFieldChecked<const FEnumProperty>(Property);
 		//Prefer readable enum names in result json to raw numbers
 		const FString EnumName = JsonValue->AsString();
 		const int64 UnderlyingValue = EnumProperty->GetEnum()->GetValueByNameString(EnumName);
 		if (ensure(UnderlyingValue != INDEX_NONE)) {
 			EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(Value, UnderlyingValue);
 		}
-
-	} else if (Property->IsA<FNameProperty>()) {
+		break;
+	}
+	case EPropertyValueType::Name: {
 		//Name is perfectly representable as string
 		const FString NameString = JsonValue->AsString();
 		*static_cast<FName*>(Value) = *NameString;
-		
-	} else if (const FTextProperty* TextProperty = CastField<const FTextProperty>(Property)) {
+		break;
+	}
+	case EPropertyValueType::Text: {
 		//For FText, standard ExportTextItem is okay to use, because it's serialization is quite complex
 		const FString SerializedValue = JsonValue->AsString();
 		if (!SerializedValue.IsEmpty()) {
 			FTextStringHelper::ReadFromBuffer(*SerializedValue, *static_cast<FText*>(Value));
 		}
-	} else if (const FFieldPathProperty* FieldPathProperty = CastField<const FFieldPathProperty>(Property)) {
+		break;
+	}
+	case EPropertyValueType::FieldPath: {
 		FFieldPath FieldPath;
 		FieldPath.Generate(*JsonValue->AsString());
 		*static_cast<FFieldPath*>(Value) = FieldPath;
-	} else {
+		break;
+	}
+	default:
 		UE_LOG(LogPropertySerializer, Fatal, TEXT("Found unsupported property type when deserializing value: %s"), *Property->GetClass()->GetName());
 	}
 }
@@ -288,6 +430,7 @@ void UPropertySerializer::DisablePropertySerialization(UStruct* Struct, FName Pr
 	checkf(Property, TEXT("Cannot find Property %s in Struct %s"), *PropertyName.ToString(), *Struct->GetPathName());
 	this->PinnedStructs.Add(Struct);
 	this->BlacklistedProperties.Add(Property);
+	this->FilteredStructSerializationPlans.Empty();
 }
 
 void UPropertySerializer::AddStructSerializer(UScriptStruct* Struct, const TSharedPtr<FStructSerializer>& Serializer) {
@@ -296,52 +439,126 @@ void UPropertySerializer::AddStructSerializer(UScriptStruct* Struct, const TShar
 }
 
 bool UPropertySerializer::ShouldSerializeProperty(FProperty* Property) const {
-	//skip transient properties
-    if (Property->HasAnyPropertyFlags(CPF_Transient)) {
-        return false;
-    }
-	//Skip editor only properties altogether
-	if (Property->HasAnyPropertyFlags(CPF_EditorOnly)) {
-		return false;
+	return FStructSerializationPlanCache::ShouldSerializePropertyByDefault(Property) && !BlacklistedProperties.Contains(Property);
+}
+
+TSharedRef<const FStructSerializationPlan> UPropertySerializer::GetStructSerializationPlan(UStruct* Struct) {
+	const TSharedRef<const FStructSerializationPlan> SharedPlan = FStructSerializationPlanCache::Get().FindOrBuildPlan(Struct);
+	if (BlacklistedProperties.Num() == 0) {
+		return SharedPlan;
 	}
-	//Skip deprecated properties
-	if (Property->HasAnyPropertyFlags(CPF_Deprecated)) {
-		return false;
+
+	//Blacklisted properties are specific to this serializer, so filter them out of the shared plan and remember the result
+	//Filtered plan is only reused while it has been built from the current shared plan, which is rebuilt when struct changes
+	const TPair<TSharedRef<const FStructSerializationPlan>, TSharedRef<const FStructSerializationPlan>>* ExistingPlan = FilteredStructSerializationPlans.Find(Struct);
+	if (ExistingPlan != NULL && ExistingPlan->Key == SharedPlan) {
+		return ExistingPlan->Value;
+	}
+	
+	TSharedRef<const FStructSerializationPlan> FilteredPlan = SharedPlan;
+	if (SharedPlan->Properties.ContainsByPredicate([this](const FPropertySerializationInfo& PropertyInfo) { return BlacklistedProperties.Contains(PropertyInfo.Property); })) {
+		const TSharedRef<FStructSerializationPlan> NewPlan = MakeShared<FStructSerializationPlan>();
+		for (const FPropertySerializationInfo& PropertyInfo : SharedPlan->Properties) {
+			if (!BlacklistedProperties.Contains(PropertyInfo.Property)) {
+				NewPlan->Properties.Add(PropertyInfo);
+			}
+		}
+		FilteredPlan = NewPlan;
+	}
+	this->FilteredStructSerializationPlans.Add(Struct, TPair<TSharedRef<const FStructSerializationPlan>, TSharedRef<const FStructSerializationPlan>>(SharedPlan, FilteredPlan));
+	return FilteredPlan;
+}
+
+EPropertyValueType UPropertySerializer::ResolvePropertyValueType(FProperty* Property) {
+	//Order of checks matters, since some property types derive from the others
+	if (Property->IsA<FMapProperty>()) {
+		return EPropertyValueType::Map;
+	}
+	if (Property->IsA<FSetProperty>()) {
+		return EPropertyValueType::Set;
+	}
+	if (Property->IsA<FArrayProperty>()) {
+		return EPropertyValueType::Array;
+	}
+	if (Property->IsA<FMulticastDelegateProperty>()) {
+		return EPropertyValueType::MulticastDelegate;
+	}
+	if (Property->IsA<FDelegateProperty>()) {
+		return EPropertyValueType::Delegate;
+	}
+	if (Property->IsA<FInterfaceProperty>()) {
+		return EPropertyValueType::Interface;
+	}
+	if (Property->IsA<FSoftObjectProperty>()) {
+		return EPropertyValueType::SoftObject;
+	}
+	if (Property->IsA<FObjectPropertyBase>()) {
+		return EPropertyValueType::Object;
+	}
+	if (Property->IsA<FStructProperty>()) {
+		return EPropertyValueType::Struct;
+	}
+	if (Property->IsA<FByteProperty>()) {
+		return EPropertyValueType::Byte;
+	}
+	if (Property->IsA<FNumericProperty>()) {
+		return EPropertyValueType::Numeric;
+	}
+	if (Property->IsA<FBoolProperty>()) {
+		return EPropertyValueType::Bool;
+	}
+	if (Property->IsA<FStrProperty>()) {
+		return EPropertyValueType::String;
+	}
+	if (Property->IsA<FEnumProperty>()) {
+		return EPropertyValueType::Enum;
+	}
+	if (Property->IsA<FNameProperty>()) {
+		return EPropertyValueType::Name;
+	}
+	if (Property->IsA<FTextProperty>()) {
+		return EPropertyValueType::Text;
 	}
-    if (BlacklistedProperties.Contains(Property)) {
-        return false;
-    }
-    return true;
+	if (Property->IsA<FFieldPathProperty>()) {
+		return EPropertyValueType::FieldPath;
+	}
+	return EPropertyValueType::Unsupported;
 }
 
 TSharedRef<FJsonValue> UPropertySerializer::SerializePropertyValue(FProperty* Property, const void* Value, TArray<int32>* OutReferencedSubobjects) {
+	return SerializePropertyValue(FPropertySerializationInfo(Property), Value, OutReferencedSubobjects);
+}
+
+TSharedRef<FJsonValue> UPropertySerializer::SerializePropertyValue(const FPropertySerializationInfo& PropertyInfo, const void* Value, TArray<int32>* OutReferencedSubobjects) {
+	FProperty* Property = PropertyInfo.Property;
+	
 	//Serialize statically sized array properties
 	if (Property->ArrayDim != 1) {
 		TArray<TSharedPtr<FJsonValue>> OutJsonValueArray;
 		for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ArrayIndex++) {
 			const uint8* ArrayPropertyValue = (const uint8*) Value + Property->ElementSize * ArrayIndex;
-			const TSharedRef<FJsonValue> ElementValue = SerializePropertyValueInner(Property, ArrayPropertyValue, OutReferencedSubobjects);
+			const TSharedRef<FJsonValue> ElementValue = SerializePropertyValueInner(PropertyInfo, ArrayPropertyValue, OutReferencedSubobjects);
 			OutJsonValueArray.Add(ElementValue);
 		}
 		return MakeShareable(new FJsonValueArray(OutJsonValueArray));
 	} else {
-		return SerializePropertyValueInner(Property, Value, OutReferencedSubobjects);
+		return SerializePropertyValueInner(PropertyInfo, Value, OutReferencedSubobjects);
 	}
 }
 
-TSharedRef<FJsonValue> UPropertySerializer::SerializePropertyValueInner(FProperty* Property, const void* Value, TArray<int32>* OutReferencedSubobjects) {
-	const FMapProperty* MapProperty = CastField<const FMapProperty>(Property);
-	const FSetProperty* SetProperty = CastField<const FSetProperty>(Property);
-	const FArrayProperty* ArrayProperty = CastField<const FArrayProperty>(Property);
+TSharedRef<FJsonValue> UPropertySerializer::SerializePropertyValueInner(const FPropertySerializationInfo& PropertyInfo, const void* Value, TArray<int32>* OutReferencedSubobjects) {
+	FProperty* Property = PropertyInfo.Property;
 	
-	if (MapProperty) {
-		FProperty* KeyProperty = MapProperty->KeyProp;
-		FProperty* ValueProperty = MapProperty->ValueProp;
+	switch (PropertyInfo.ValueType) {
+	case EPropertyValueType::Map: {
+		const FMapProperty* MapProperty = CastFieldChecked<const FMapProperty>(Property);
+		const FPropertySerializationInfo KeyInfo(MapProperty->KeyProp, PropertyInfo.ElementType);
+		const FPropertySerializationInfo ValueInfo(MapProperty->ValueProp, PropertyInfo.MapValueType);
 		FScriptMapHelper MapHelper(MapProperty, Value);
 		TArray<TSharedPtr<FJsonValue>> ResultArray;
 		for (int32 i = 0; i < MapHelper.Num(); i++) {
-			TSharedPtr<FJsonValue> EntryKey = SerializePropertyValue(KeyProperty, MapHelper.GetKeyPtr(i), OutReferencedSubobjects);
-			TSharedPtr<FJsonValue> EntryValue = SerializePropertyValue(ValueProperty, MapHelper.GetValuePtr(i), OutReferencedSubobjects);
+			TSharedPtr<FJsonValue> EntryKey = SerializePropertyValue(KeyInfo, MapHelper.GetKeyPtr(i), OutReferencedSubobjects);
+			TSharedPtr<FJsonValue> EntryValue = SerializePropertyValue(ValueInfo, MapHelper.GetValuePtr(i), OutReferencedSubobjects);
 			TSharedRef<FJsonObject> Pair = MakeShareable(new FJsonObject());
 			Pair->SetField(TEXT("Key"), EntryKey);
 			Pair->SetField(TEXT("Value"), EntryValue);
@@ -349,32 +566,32 @@ TSharedRef<FJsonValue> UPropertySerializer::SerializePropertyValueInner(FPropert
 		}
 		return MakeShareable(new FJsonValueArray(ResultArray));
 	}
-	
-	if (SetProperty) {
-		FProperty* ElementProperty = SetProperty->ElementProp;
+	case EPropertyValueType::Set: {
+		const FSetProperty* SetProperty = CastFieldChecked<const FSetProperty>(Property);
+		const FPropertySerializationInfo ElementInfo(SetProperty->ElementProp, PropertyInfo.ElementType);
 		FScriptSetHelper SetHelper(SetProperty, Value);
 		TArray<TSharedPtr<FJsonValue>> ResultArray;
 		for (int32 i = 0; i < SetHelper.Num(); i++) {
-			TSharedPtr<FJsonValue> Element = SerializePropertyValue(ElementProperty, SetHelper.GetElementPtr(i), OutReferencedSubobjects);
+			TSharedPtr<FJsonValue> Element = SerializePropertyValue(ElementInfo, SetHelper.GetElementPtr(i), OutReferencedSubobjects);
 			ResultArray.Add(Element);
 		}
 		return MakeShareable(new FJsonValueArray(ResultArray));
 	}
-	
-	if (ArrayProperty) {
-		FProperty* ElementProperty = ArrayProperty->Inner;
+	case EPropertyValueType::Array: {
+		const FArrayProperty* ArrayProperty = CastFieldChecked<const FArrayProperty>(Property);
+		const FPropertySerializationInfo ElementInfo(ArrayProperty->Inner, PropertyInfo.ElementType);
 		FScriptArrayHelper ArrayHelper(ArrayProperty, Value);
 		TArray<TSharedPtr<FJsonValue>> ResultArray;
+		ResultArray.Reserve(ArrayHelper.Num());
 		for (int32 i = 0; i < ArrayHelper.Num(); i++) {
-			TSharedPtr<FJsonValue> Element = SerializePropertyValue(ElementProperty, ArrayHelper.GetRawPtr(i), OutReferencedSubobjects);
+			TSharedPtr<FJsonValue> Element = SerializePropertyValue(ElementInfo, ArrayHelper.GetRawPtr(i), OutReferencedSubobjects);
 			ResultArray.Add(Element);
 		}
 		return MakeShareable(new FJsonValueArray(ResultArray));
 	}
-
-	if (Property->IsA<FMulticastDelegateProperty>()) {
-		FMulticastScriptDelegate* MulticastScriptDelegate = (FMulticastScriptDelegate*) Value;
-		/*TArray<TSharedPtr<FJsonValue>> DelegatesArray;
+	case EPropertyValueType::MulticastDelegate: {
+		/*FMulticastScriptDelegate* MulticastScriptDelegate = (FMulticastScriptDelegate*) Value;
+		TArray<TSharedPtr<FJsonValue>> DelegatesArray;
 
 		if (ObjectHierarchySerializer != NULL) {
 			for (FScriptDelegate& ScriptDelegate : MulticastScriptDelegate->InvocationList) {
@@ -399,8 +616,7 @@ TSharedRef<FJsonValue> UPropertySerializer::SerializePropertyValueInner(FPropert
 		return MakeShareable(new FJsonValueArray(DelegatesArray));*/
 		return MakeShareable(new FJsonValueString(TEXT("##NOT SERIALIZED##")));
 	}
-	
-	if (Property->IsA<FDelegateProperty>()) {
+	case EPropertyValueType::Delegate: {
 		/*FScriptDelegate* ScriptDelegate = (FScriptDelegate*) Value;
 		TSharedPtr<FJsonObject> DelegateObject = MakeShareable(new FJsonObject());
 
@@ -421,8 +637,7 @@ TSharedRef<FJsonValue> UPropertySerializer::SerializePropertyValueInner(FPropert
 		return MakeShareable(new FJsonValueObject(DelegateObject));*/
 		return MakeShareable(new FJsonValueString(TEXT("##NOT SERIALIZED##")));
 	}
-	
-	if (Property->IsA<FInterfaceProperty>()) {
+	case EPropertyValueType::Interface: {
 		//UObject is enough to re-create value, since we known property on deserialization
 		const FScriptInterface* Interface = reinterpret_cast<const FScriptInterface*>(Value);
 		int32 ObjectIndex = ObjectHierarchySerializer ? ObjectHierarchySerializer->SerializeObject(Interface->GetObject()) : 0;
@@ -433,8 +648,10 @@ TSharedRef<FJsonValue> UPropertySerializer::SerializePropertyValueInner(FPropert
 		
 		return MakeShareable(new FJsonValueNumber(ObjectIndex));
 	}
-
-	if (const FObjectPropertyBase* ObjectProperty = CastField<const FObjectPropertyBase>(Property)) {
+	//Soft object properties derive from FObjectPropertyBase, and have always been written as object references
+	case EPropertyValueType::SoftObject:
+	case EPropertyValueType::Object: {
+		const FObjectPropertyBase* ObjectProperty = CastFieldChecked<const FObjectPropertyBase>(Property);
 		//Need to serialize full UObject for object property
 		UObject* ObjectPointer = ObjectProperty->GetObjectPropertyValue(Value);
 		int32 ObjectIndex = ObjectHierarchySerializer ? ObjectHierarchySerializer->SerializeObject(ObjectPointer) : 0;
@@ -445,71 +662,64 @@ TSharedRef<FJsonValue> UPropertySerializer::SerializePropertyValueInner(FPropert
 		
 		return MakeShareable(new FJsonValueNumber(ObjectIndex));
 	}
-
-	if (const FStructProperty* StructProperty = CastField<const FStructProperty>(Property)) {
+	case EPropertyValueType::Struct: {
+		const FStructProperty* StructProperty = CastFieldChecked<const FStructProperty>(Property);
 		//To serialize struct, we need it's type and value pointer, because struct value doesn't contain type information
 		return MakeShareable(new FJsonValueObject(SerializeStruct(StructProperty->Struct, Value, OutReferencedSubobjects)));
 	}
-
-	if (Property->IsA<FSoftObjectProperty>()) {
-		//For soft object reference, path is enough too for deserialization.
-		const FSoftObjectPtr* ObjectPtr = reinterpret_cast<const FSoftObjectPtr*>(Value);
-		return MakeShareable(new FJsonValueString(ObjectPtr->ToSoftObjectPath().ToString()));
-	}
-
-	if (const FByteProperty* ByteProperty = CastField<const FByteProperty>(Property)) {
+	case EPropertyValueType::Byte: {
+		const FByteProperty* ByteProperty = CastFieldChecked<const FByteProperty>(Property);
 		//If Enum is NULL, property will be handled as standard UNumericProperty
 		if (ByteProperty->Enum) {
 			const int64 UnderlyingValue = ByteProperty->GetSignedIntPropertyValue(Value);
 			const FString EnumName = ByteProperty->Enum->GetNameByValue(UnderlyingValue).ToString();
 			return MakeShareable(new FJsonValueString(EnumName));
 		}
+		return MakeShareable(new FJsonValueNumber(ByteProperty->GetSignedIntPropertyValue(Value)));
 	}
-	
-	if (const FNumericProperty* NumberProperty = CastField<const FNumericProperty>(Property)) {
+	case EPropertyValueType::Numeric: {
+		const FNumericProperty* NumberProperty = CastFieldChecked<const FNumericProperty>(Property);
 		double ResultValue;
 		if (NumberProperty->IsFloatingPoint())
 			ResultValue = NumberProperty->GetFloatingPointPropertyValue(Value);
 		else ResultValue = NumberProperty->GetSignedIntPropertyValue(Value);
 		return MakeShareable(new FJsonValueNumber(ResultValue));
 	}
-	
-	if (const FBoolProperty* BoolProperty = CastField<const FBoolProperty>(Property)) {
+	case EPropertyValueType::Bool: {
+		const FBoolProperty* BoolProperty = CastFieldChecked<const FBoolProperty>(Property);
 		const bool bBooleanValue = BoolProperty->GetPropertyValue(Value);
 		return MakeShareable(new FJsonValueBoolean(bBooleanValue));
 	}
-	
-	if (Property->IsA<FStrProperty>()) {
+	case EPropertyValueType::String: {
 		const FString& StringValue = *reinterpret_cast<const FString*>(Value);
 		return MakeShareable(new FJsonValueString(StringValue));
 	}
-	
-	if (const FEnumProperty* EnumProperty = CastField<const FEnumProperty>(Property)) {
+	case EPropertyValueType::Enum: {
+		const FEnumProperty* EnumProperty = CastFieldChecked<const FEnumProperty>(Property);
 		const int64 UnderlyingValue = EnumProperty->GetUnderlyingProperty()->GetSignedIntPropertyValue(Value);
 		const FString EnumName = EnumProperty->GetEnum()->GetNameByValue(UnderlyingValue).ToString();
 		return MakeShareable(new FJsonValueString(EnumName));
 	}
-	
-	if (Property->IsA<FNameProperty>()) {
+	case EPropertyValueType::Name: {
 		//Name is perfectly representable as string
 		FName* Temp = ((FName*) Value);
 		return MakeShareable(new FJsonValueString(Temp->ToString()));
 	}
-
-	if (const FTextProperty* TextProperty = CastField<const FTextProperty>(Property)) {
+	case EPropertyValueType::Text: {
+		const FTextProperty* TextProperty = CastFieldChecked<const FTextProperty>(Property);
 		FString ResultValue;
 		const FText& TextValue = TextProperty->GetPropertyValue(Value);
 		FTextStringHelper::WriteToBuffer(ResultValue, TextValue);
 		return MakeShareable(new FJsonValueString(ResultValue));
 	}
-
-	if (Property->IsA<FFieldPathProperty>()) {
+	case EPropertyValueType::FieldPath: {
 		FFieldPath* Temp = ((FFieldPath*) Value);
 		return MakeShareable(new FJsonValueString(Temp->ToString()));
 	}
-	
-	UE_LOG(LogPropertySerializer, Fatal, TEXT("Found unsupported property type when serializing value: %s"), *Property->GetClass()->GetName());
-	return MakeShareable(new FJsonValueString(TEXT("#ERROR#")));
+	default:
+		UE_LOG(LogPropertySerializer, Fatal, TEXT("Found unsupported property type when serializing value: %s"), *Property->GetClass()->GetName());
+		return MakeShareable(new FJsonValueString(TEXT("#ERROR#")));
+	}
 }
 
 TSharedRef<FJsonObject> UPropertySerializer::SerializeStruct(UScriptStruct* Struct, const void* Value, TArray<int32>* OutReferencedSubobjects) {
@@ -526,7 +736,12 @@ void UPropertySerializer::DeserializeStruct(UScriptStruct* Struct, const TShared
 }
 
 bool UPropertySerializer::ComparePropertyValues(FProperty* Property, const TSharedRef<FJsonValue>& JsonValue, const void* CurrentValue, const TSharedPtr<FObjectCompareContext> Context) {
+	return ComparePropertyValues(FPropertySerializationInfo(Property), JsonValue, CurrentValue, Context);
+}
 
+bool UPropertySerializer::ComparePropertyValues(const FPropertySerializationInfo& PropertyInfo, const TSharedRef<FJsonValue>& JsonValue, const void* CurrentValue, const TSharedPtr<FObjectCompareContext> Context) {
+	FProperty* Property = PropertyInfo.Property;
+	
 	if (Property->ArrayDim != 1) {
 		const TArray<TSharedPtr<FJsonValue>>& ArrayElements = JsonValue->AsArray();
 		check(ArrayElements.Num() == Property->ArrayDim);
@@ -535,23 +750,23 @@ bool UPropertySerializer::ComparePropertyValues(FProperty* Property, const TShar
 			const uint8* ArrayPropertyValue = (const uint8*) CurrentValue + Property->ElementSize * ArrayIndex;
 			const TSharedRef<FJsonValue> ArrayJsonValue = ArrayElements[ArrayIndex].ToSharedRef();
 			
-			if (!ComparePropertyValuesInner(Property, ArrayJsonValue, ArrayPropertyValue, Context)) {
+			if (!ComparePropertyValuesInner(PropertyInfo, ArrayJsonValue, ArrayPropertyValue, Context)) {
 				return false;
 			}
 		}
 		return true;
 	}
-	return ComparePropertyValuesInner(Property, JsonValue, CurrentValue, Context);
+	return ComparePropertyValuesInner(PropertyInfo, JsonValue, CurrentValue, Context);
 }
 
-bool UPropertySerializer::ComparePropertyValuesInner(FProperty* Property, const TSharedRef<FJsonValue>& JsonValue, const void* CurrentValue, const TSharedPtr<FObjectCompareContext> Context) {
-	const FMapProperty* MapProperty = CastField<const FMapProperty>(Property);
-	const FSetProperty* SetProperty = CastField<const FSetProperty>(Property);
-	const FArrayProperty* ArrayProperty = CastField<const FArrayProperty>(Property);
+bool UPropertySerializer::ComparePropertyValuesInner(const FPropertySerializationInfo& PropertyInfo, const TSharedRef<FJsonValue>& JsonValue, const void* CurrentValue, const TSharedPtr<FObjectCompareContext> Context) {
+	FProperty* Property = PropertyInfo.Property;
+	const EPropertyValueType ValueType = PropertyInfo.ValueType;
 
-	if (MapProperty) {
-		FProperty* KeyProperty = MapProperty->KeyProp;
-		FProperty* ValueProperty = MapProperty->ValueProp;
+	if (ValueType == EPropertyValueType::Map) {
+		const FMapProperty* MapProperty = CastFieldChecked<const FMapProperty>(Property);
+		const FPropertySerializationInfo KeyInfo(MapProperty->KeyProp, PropertyInfo.ElementType);
+		const FPropertySerializationInfo ValueInfo(MapProperty->ValueProp, PropertyInfo.MapValueType);
 		FScriptMapHelper MapHelper(MapProperty, CurrentValue);
 
 		//Try to fail early to not attempt expensive map comparison operations
@@ -573,8 +788,8 @@ bool UPropertySerializer::ComparePropertyValuesInner(FProperty* Property, const
 				const void* CurrentPairValuePtr = MapHelper.GetValuePtr(j);
 
 				//If both checks succeeded, we found a matching pair, check the next pair in the main array
-				if (ComparePropertyValues(KeyProperty, EntryKey.ToSharedRef(), CurrentPairKeyPtr, Context) &&
-					ComparePropertyValues(ValueProperty, EntryValue.ToSharedRef(), CurrentPairValuePtr, Context)) {
+				if (ComparePropertyValues(KeyInfo, EntryKey.ToSharedRef(), CurrentPairKeyPtr, Context) &&
+					ComparePropertyValues(ValueInfo, EntryValue.ToSharedRef(), CurrentPairValuePtr, Context)) {
 
 					bFoundMatchingPair = true;
 					break;
@@ -590,8 +805,9 @@ bool UPropertySerializer::ComparePropertyValuesInner(FProperty* Property, const
 		return true;
 	}
 
-	if (SetProperty) {
-		FProperty* ElementProperty = SetProperty->ElementProp;
+	if (ValueType == EPropertyValueType::Set) {
+		const FSetProperty* SetProperty = CastFieldChecked<const FSetProperty>(Property);
+		const FPropertySerializationInfo ElementInfo(SetProperty->ElementProp, PropertyInfo.ElementType);
 		FScriptSetHelper SetHelper(SetProperty, CurrentValue);
 		const TArray<TSharedPtr<FJsonValue>>& SetArray = JsonValue->AsArray();
 		
@@ -608,7 +824,7 @@ bool UPropertySerializer::ComparePropertyValuesInner(FProperty* Property, const
 			bool bFoundMatchingPair = false;
 			for (int32 j = 0; j < SetHelper.Num(); j++) {
 				const void* CurrentElementValue = SetHelper.GetElementPtr(j);
-				if (ComparePropertyValues(ElementProperty, Element.ToSharedRef(), CurrentElementValue, Context)) {
+				if (ComparePropertyValues(ElementInfo, Element.ToSharedRef(), CurrentElementValue, Context)) {
 					bFoundMatchingPair = true;
 					break;
 				}
@@ -621,8 +837,9 @@ bool UPropertySerializer::ComparePropertyValuesInner(FProperty* Property, const
 		return true;
 	}
 
-	if (ArrayProperty) {
-		FProperty* ElementProperty = ArrayProperty->Inner;
+	if (ValueType == EPropertyValueType::Array) {
+		const FArrayProperty* ArrayProperty = CastFieldChecked<const FArrayProperty>(Property);
+		const FPropertySerializationInfo ElementInfo(ArrayProperty->Inner, PropertyInfo.ElementType);
 		FScriptArrayHelper ArrayHelper(ArrayProperty, CurrentValue);
 		const TArray<TSharedPtr<FJsonValue>>& JsonArray = JsonValue->AsArray();
 
@@ -636,7 +853,7 @@ bool UPropertySerializer::ComparePropertyValuesInner(FProperty* Property, const
 			const TSharedPtr<FJsonValue>& Element = JsonArray[i];
 			const void* CurrentElementValue = ArrayHelper.GetRawPtr(i);
 
-			if (!ComparePropertyValues(ElementProperty, Element.ToSharedRef(), CurrentElementValue, Context)) {
+			if (!ComparePropertyValues(ElementInfo, Element.ToSharedRef(), CurrentElementValue, Context)) {
 				return false;
 			}
 		}
@@ -683,7 +900,7 @@ bool UPropertySerializer::ComparePropertyValuesInner(FProperty* Property, const
 			JsonFunctionName == BoundFunctionName;
 	}*/
 
-	if (Property->IsA<FInterfaceProperty>()) {
+	if (ValueType == EPropertyValueType::Interface) {
 		//Interface properties are equal if objects they refer to are equal
 		const FScriptInterface* Interface = static_cast<const FScriptInterface*>(CurrentValue);
 		UObject* InterfaceObject = Interface->GetObject();
@@ -692,7 +909,8 @@ bool UPropertySerializer::ComparePropertyValuesInner(FProperty* Property, const
 		return ObjectHierarchySerializer->CompareObjectsWithContext(InterfaceObjectIndex, InterfaceObject, Context);
 	}
 
-	if (const FObjectPropertyBase* ObjectProperty = CastField<const FObjectPropertyBase>(Property)) {
+	if (ValueType == EPropertyValueType::Object || ValueType == EPropertyValueType::SoftObject) {
+		const FObjectPropertyBase* ObjectProperty = CastFieldChecked<const FObjectPropertyBase>(Property);
 		//Need to serialize full UObject for object property
 		UObject* PropertyObject = ObjectProperty->GetObjectPropertyValue(CurrentValue);
 		const int32 ObjectIndex = JsonValue->AsNumber();
@@ -701,16 +919,18 @@ bool UPropertySerializer::ComparePropertyValuesInner(FProperty* Property, const
 	}
 
 	//To serialize struct, we need it's type and value pointer, because struct value doesn't contain type information
-	if (const FStructProperty* StructProperty = CastField<const FStructProperty>(Property)) {
+	if (ValueType == EPropertyValueType::Struct) {
+		const FStructProperty* StructProperty = CastFieldChecked<const FStructProperty>(Property);
 		return CompareStructs(StructProperty->Struct, JsonValue->AsObject().ToSharedRef(), CurrentValue, Context);
 	}
 
 	//If property hasn't been handled above, we can just deserialize it normally and then do FProperty.Identical
 	FDefaultConstructedPropertyElement DeserializedElement(Property);
 	//We use DeserializePropertyValueInner here because we handle statically sized array properties externally, so we need to bypass their handling
-	DeserializePropertyValueInner(Property, JsonValue, DeserializedElement.GetObjAddress());
+	DeserializePropertyValueInner(PropertyInfo, JsonValue, DeserializedElement.GetObjAddress());
 
-	if (const FTextProperty* TextProperty = CastField<const FTextProperty>(Property)) {
+	if (ValueType == EPropertyValueType::Text) {
+		const FTextProperty* TextProperty = CastFieldChecked<const FTextProperty>(Property);
 		// FTextProperty::Identical compares the CultureInvariant flag, and sometimes empty deserialized texts don't have it while the exiting texts do
 		if (TextProperty->GetPropertyValue(CurrentValue).IsEmpty() && TextProperty->GetPropertyValue(DeserializedElement.GetObjAddress()).IsEmpty())
 			return true;
@@ -724,10 +944,12 @@ bool UPropertySerializer::CompareStructs(UScriptStruct* Struct, const TSharedRef
 	return StructSerializer->Compare(Struct, JsonValue, CurrentValue, Context);
 }
 
-FStructSerializer* UPropertySerializer::GetStructSerializer(UScriptStruct* Struct) const {
+FStructSerializer* UPropertySerializer::GetStructSerializer(UScriptStruct* Struct) {
 	check(Struct);
 	TSharedPtr<FStructSerializer> const* StructSerializer = StructSerializers.Find(Struct);
 	return StructSerializer && ensure(StructSerializer->IsValid()) ? StructSerializer->Get() : FallbackStructSerializer.Get();
 }
 
+#if ASSET_DUMPER_DEBUG_SERIALIZERS
 PRAGMA_ENABLE_OPTIMIZATION
+#endif
@@ -0,0 +1,435 @@
+#include "Util/BinaryJsonSerializer.h"
+#include "Dom/JsonValue.h"
+
+/** Magic number at the start of the binary json files, "UADJ" in little endian */
+#define BINARY_JSON_FILE_MAGIC 0x4A444155
+#define BINARY_JSON_FILE_VERSION 1
+
+/** Strings longer than that are written inline and are never interned, since they are unlikely to be repeated */
+#define MAX_INTERNED_STRING_LENGTH 128
+
+/** String references: 0 is reserved for the End tag, 1 is inline string, 2 is inline string added to the intern table, anything above is an interned string index + 3 */
+#define STRING_REFERENCE_INLINE 1
+#define STRING_REFERENCE_INTERN 2
+#define STRING_REFERENCE_FIRST_INDEX 3
+
+/** Number range in which integers are represented exactly by doubles */
+#define MAX_EXACT_DOUBLE_INTEGER 9007199254740992.0
+
+FBinaryJsonWriter::FBinaryJsonWriter(FArchive& Archive) : Archive(Archive) {
+	uint32 FileMagic = BINARY_JSON_FILE_MAGIC;
+	uint32 FileVersion = BINARY_JSON_FILE_VERSION;
+	this->Archive << FileMagic;
+	this->Archive << FileVersion;
+}
+
+void FBinaryJsonWriter::WriteObjectStart() {
+	WriteTag(EBinaryJsonTag::ObjectStart);
+}
+
+void FBinaryJsonWriter::WriteArrayStart() {
+	WriteTag(EBinaryJsonTag::ArrayStart);
+}
+
+void FBinaryJsonWriter::WriteEnd() {
+	WriteTag(EBinaryJsonTag::End);
+}
+
+void FBinaryJsonWriter::WriteIdentifier(const FString& Identifier) {
+	WriteStringReference(Identifier);
+}
+
+void FBinaryJsonWriter::WriteString(const FString& Value) {
+	WriteTag(EBinaryJsonTag::String);
+	WriteStringReference(Value);
+}
+
+void FBinaryJsonWriter::WriteNumber(double Value) {
+	//Most of the numbers we write are object indices, enumeration values and other integers, store them as varints
+	if (Value >= -MAX_EXACT_DOUBLE_INTEGER && Value <= MAX_EXACT_DOUBLE_INTEGER && !(Value == 0.0 && FMath::IsNegativeDouble(Value))) {
+		const int64 IntegerValue = (int64) Value;
+
+		if ((double) IntegerValue == Value) {
+			WriteTag(EBinaryJsonTag::Integer);
+			WriteVarInt(((uint64) IntegerValue << 1) ^ (uint64) (IntegerValue >> 63));
+			return;
+		}
+	}
+
+	//Properties are mostly single precision floats, so they can be written as such without losing anything
+	float FloatValue = (float) Value;
+	if ((double) FloatValue == Value) {
+		WriteTag(EBinaryJsonTag::Float);
+		Archive << FloatValue;
+		return;
+	}
+	WriteTag(EBinaryJsonTag::Double);
+	Archive << Value;
+}
+
+void FBinaryJsonWriter::WriteBool(bool bValue) {
+	WriteTag(bValue ? EBinaryJsonTag::True : EBinaryJsonTag::False);
+}
+
+void FBinaryJsonWriter::WriteValue(const TSharedPtr<FJsonValue>& Value) {
+	if (!Value.IsValid()) {
+		WriteTag(EBinaryJsonTag::Null);
+		return;
+	}
+
+	switch (Value->Type) {
+		case EJson::String: {
+			WriteString(Value->AsString());
+			break;
+		}
+		case EJson::Number: {
+			WriteNumber(Value->AsNumber());
+			break;
+		}
+		case EJson::Boolean: {
+			WriteBool(Value->AsBool());
+			break;
+		}
+		case EJson::Array: {
+			WriteArrayStart();
+			for (const TSharedPtr<FJsonValue>& ArrayElement : Value->AsArray()) {
+				WriteValue(ArrayElement);
+			}
+			WriteEnd();
+			break;
+		}
+		case EJson::Object: {
+			WriteObject(Value->AsObject().ToSharedRef());
+			break;
+		}
+		default: {
+			WriteTag(EBinaryJsonTag::Null);
+			break;
+		}
+	}
+}
+
+void FBinaryJsonWriter::WriteObject(const TSharedRef<FJsonObject>& Object) {
+	WriteObjectStart();
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Object->Values) {
+		WriteIdentifier(Pair.Key);
+		WriteValue(Pair.Value);
+	}
+	WriteEnd();
+}
+
+void FBinaryJsonWriter::WriteTag(EBinaryJsonTag Tag) {
+	uint8 TagValue = (uint8) Tag;
+	Archive.Serialize(&TagValue, sizeof(uint8));
+}
+
+void FBinaryJsonWriter::WriteVarInt(uint64 Value) {
+	uint8 Buffer[10];
+	int32 BytesUsed = 0;
+
+	while (Value >= 0x80) {
+		Buffer[BytesUsed++] = (uint8) (Value | 0x80);
+		Value >>= 7;
+	}
+	Buffer[BytesUsed++] = (uint8) Value;
+	Archive.Serialize(Buffer, BytesUsed);
+}
+
+void FBinaryJsonWriter::WriteStringReference(const FString& Value) {
+	if (Value.Len() <= MAX_INTERNED_STRING_LENGTH) {
+		const int32* ExistingStringIndex = InternedStrings.Find(Value);
+		if (ExistingStringIndex != NULL) {
+			WriteVarInt(*ExistingStringIndex + STRING_REFERENCE_FIRST_INDEX);
+			return;
+		}
+		InternedStrings.Add(Value, InternedStrings.Num());
+		WriteVarInt(STRING_REFERENCE_INTERN);
+	} else {
+		WriteVarInt(STRING_REFERENCE_INLINE);
+	}
+
+	//Explicit length is used so strings containing null characters are written completely
+	const FTCHARToUTF8 ConvertedString(*Value, Value.Len());
+	WriteVarInt(ConvertedString.Length());
+	Archive.Serialize((void*) ConvertedString.Get(), ConvertedString.Length());
+}
+
+/** Holds state of the binary json reading, with every read being bounds checked */
+class FBinaryJsonReadContext {
+public:
+	const uint8* Data;
+	const uint8* DataEnd;
+	TArray<FString> InternedStrings;
+	FString ErrorMessage;
+
+	FBinaryJsonReadContext(const uint8* Data, int64 DataSize) : Data(Data), DataEnd(Data + DataSize) {
+	}
+
+	FORCEINLINE bool HasError() const {
+		return ErrorMessage.Len() > 0;
+	}
+
+	void SetError(const FString& NewErrorMessage) {
+		if (!HasError()) {
+			this->ErrorMessage = NewErrorMessage;
+		}
+	}
+
+	bool ReadBytes(void* OutData, int64 Length) {
+		if (DataEnd - Data < Length) {
+			SetError(TEXT("Unexpected end of data"));
+			return false;
+		}
+		FMemory::Memcpy(OutData, Data, Length);
+		this->Data += Length;
+		return true;
+	}
+
+	bool ReadHeader() {
+		uint8 HeaderData[8];
+		if (!ReadBytes(HeaderData, sizeof(HeaderData))) {
+			return false;
+		}
+		const uint32 FileMagic = HeaderData[0] | (HeaderData[1] << 8) | (HeaderData[2] << 16) | ((uint32) HeaderData[3] << 24);
+		const uint32 FileVersion = HeaderData[4] | (HeaderData[5] << 8) | (HeaderData[6] << 16) | ((uint32) HeaderData[7] << 24);
+
+		if (FileMagic != BINARY_JSON_FILE_MAGIC) {
+			SetError(TEXT("Invalid binary json file header"));
+			return false;
+		}
+		if (FileVersion > BINARY_JSON_FILE_VERSION) {
+			SetError(FString::Printf(TEXT("Unsupported binary json file version %d"), FileVersion));
+			return false;
+		}
+		return true;
+	}
+
+	bool ReadTag(EBinaryJsonTag& OutTag) {
+		uint8 TagValue;
+		if (!ReadBytes(&TagValue, sizeof(uint8))) {
+			return false;
+		}
+		OutTag = (EBinaryJsonTag) TagValue;
+		return true;
+	}
+
+	bool ReadVarInt(uint64& OutValue) {
+		OutValue = 0;
+		for (int32 Shift = 0; Shift < 64; Shift += 7) {
+			if (Data >= DataEnd) {
+				SetError(TEXT("Unexpected end of data"));
+				return false;
+			}
+			const uint8 CurrentByte = *Data++;
+			OutValue |= (uint64) (CurrentByte & 0x7F) << Shift;
+
+			if ((CurrentByte & 0x80) == 0) {
+				return true;
+			}
+		}
+		SetError(TEXT("Malformed variable length integer"));
+		return false;
+	}
+
+	bool ReadStringReference(FString& OutString) {
+		uint64 StringReference;
+		if (!ReadVarInt(StringReference)) {
+			return false;
+		}
+
+		if (StringReference == (uint64) EBinaryJsonTag::End) {
+			SetError(TEXT("Unexpected end of object"));
+			return false;
+		}
+		if (StringReference >= STRING_REFERENCE_FIRST_INDEX) {
+			const uint64 StringIndex = StringReference - STRING_REFERENCE_FIRST_INDEX;
+			if (StringIndex >= (uint64) InternedStrings.Num()) {
+				SetError(FString::Printf(TEXT("Invalid interned string index %llu"), StringIndex));
+				return false;
+			}
+			OutString = InternedStrings[StringIndex];
+			return true;
+		}
+
+		uint64 StringLength;
+		if (!ReadVarInt(StringLength)) {
+			return false;
+		}
+		if ((uint64) (DataEnd - Data) < StringLength) {
+			SetError(TEXT("Unexpected end of data"));
+			return false;
+		}
+
+		const FUTF8ToTCHAR ConvertedString((const ANSICHAR*) Data, (int32) StringLength);
+		OutString = FString(ConvertedString.Length(), ConvertedString.Get());
+		this->Data += StringLength;
+
+		if (StringReference == STRING_REFERENCE_INTERN) {
+			InternedStrings.Add(OutString);
+		}
+		return true;
+	}
+
+	TSharedPtr<FJsonObject> ReadObjectBody() {
+		TSharedPtr<FJsonObject> ResultObject = MakeShareable(new FJsonObject());
+		EBinaryJsonTag Tag;
+
+		while (PeekTag(Tag)) {
+			if (Tag == EBinaryJsonTag::End) {
+				this->Data++;
+				return ResultObject;
+			}
+			FString FieldName;
+			if (!ReadStringReference(FieldName)) {
+				return NULL;
+			}
+			const TSharedPtr<FJsonValue> FieldValue = ReadValue();
+			if (!FieldValue.IsValid()) {
+				return NULL;
+			}
+			ResultObject->Values.Add(FieldName, FieldValue);
+		}
+		return NULL;
+	}
+
+	bool PeekTag(EBinaryJsonTag& OutTag) {
+		if (Data >= DataEnd) {
+			SetError(TEXT("Unexpected end of data"));
+			return false;
+		}
+		OutTag = (EBinaryJsonTag) *Data;
+		return true;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> ReadArrayBody() {
+		TArray<TSharedPtr<FJsonValue>> ResultArray;
+		EBinaryJsonTag Tag;
+
+		while (PeekTag(Tag)) {
+			if (Tag == EBinaryJsonTag::End) {
+				this->Data++;
+				break;
+			}
+			const TSharedPtr<FJsonValue> ArrayElement = ReadValue();
+			if (!ArrayElement.IsValid()) {
+				break;
+			}
+			ResultArray.Add(ArrayElement);
+		}
+		return ResultArray;
+	}
+
+	TSharedPtr<FJsonValue> ReadValue() {
+		EBinaryJsonTag Tag;
+		if (!ReadTag(Tag)) {
+			return NULL;
+		}
+
+		switch (Tag) {
+			case EBinaryJsonTag::Null: return MakeShareable(new FJsonValueNull());
+			case EBinaryJsonTag::False: return MakeShareable(new FJsonValueBoolean(false));
+			case EBinaryJsonTag::True: return MakeShareable(new FJsonValueBoolean(true));
+			case EBinaryJsonTag::Integer: {
+				uint64 EncodedValue;
+				if (!ReadVarInt(EncodedValue)) {
+					return NULL;
+				}
+				const int64 IntegerValue = (int64) (EncodedValue >> 1) ^ -(int64) (EncodedValue & 1);
+				return MakeShareable(new FJsonValueNumber((double) IntegerValue));
+			}
+			case EBinaryJsonTag::Float: {
+				float FloatValue;
+				if (!ReadBytes(&FloatValue, sizeof(float))) {
+					return NULL;
+				}
+				return MakeShareable(new FJsonValueNumber(FloatValue));
+			}
+			case EBinaryJsonTag::Double: {
+				double DoubleValue;
+				if (!ReadBytes(&DoubleValue, sizeof(double))) {
+					return NULL;
+				}
+				return MakeShareable(new FJsonValueNumber(DoubleValue));
+			}
+			case EBinaryJsonTag::String: {
+				FString StringValue;
+				if (!ReadStringReference(StringValue)) {
+					return NULL;
+				}
+				return MakeShareable(new FJsonValueString(StringValue));
+			}
+			case EBinaryJsonTag::ObjectStart: {
+				const TSharedPtr<FJsonObject> ObjectValue = ReadObjectBody();
+				if (!ObjectValue.IsValid()) {
+					return NULL;
+				}
+				return MakeShareable(new FJsonValueObject(ObjectValue));
+			}
+			case EBinaryJsonTag::ArrayStart: {
+				TArray<TSharedPtr<FJsonValue>> ArrayValue = ReadArrayBody();
+				if (HasError()) {
+					return NULL;
+				}
+				return MakeShareable(new FJsonValueArray(ArrayValue));
+			}
+			default: {
+				SetError(FString::Printf(TEXT("Unexpected binary json tag %d"), (int32) Tag));
+				return NULL;
+			}
+		}
+	}
+};
+
+bool FBinaryJsonReader::IsBinaryJsonData(const uint8* Data, int64 DataSize) {
+	FBinaryJsonReadContext ReadContext(Data, DataSize);
+	return ReadContext.ReadHeader();
+}
+
+TSharedPtr<FJsonObject> FBinaryJsonReader::ReadObject(const uint8* Data, int64 DataSize, FString* OutErrorMessage) {
+	FBinaryJsonReadContext ReadContext(Data, DataSize);
+	TSharedPtr<FJsonObject> ResultObject;
+
+	if (ReadContext.ReadHeader()) {
+		const TSharedPtr<FJsonValue> RootValue = ReadContext.ReadValue();
+
+		if (RootValue.IsValid() && RootValue->Type == EJson::Object) {
+			ResultObject = RootValue->AsObject();
+		} else {
+			ReadContext.SetError(TEXT("Root value is not an object"));
+		}
+	}
+
+	if (ReadContext.HasError()) {
+		if (OutErrorMessage) {
+			*OutErrorMessage = ReadContext.ErrorMessage;
+		}
+		return NULL;
+	}
+	return ResultObject;
+}
+
+bool FBinaryJsonReader::ReadRootStringField(const uint8* Data, int64 DataSize, const FString& FieldName, FString& OutValue) {
+	FBinaryJsonReadContext ReadContext(Data, DataSize);
+	EBinaryJsonTag Tag;
+
+	if (!ReadContext.ReadHeader() || !ReadContext.ReadTag(Tag) || Tag != EBinaryJsonTag::ObjectStart) {
+		return false;
+	}
+
+	//Fields preceding the requested one still have to be read because they can intern strings we need later
+	while (ReadContext.PeekTag(Tag) && Tag != EBinaryJsonTag::End) {
+		FString CurrentFieldName;
+		if (!ReadContext.ReadStringReference(CurrentFieldName)) {
+			return false;
+		}
+		const TSharedPtr<FJsonValue> FieldValue = ReadContext.ReadValue();
+		if (!FieldValue.IsValid()) {
+			return false;
+		}
+		if (CurrentFieldName == FieldName && FieldValue->Type == EJson::String) {
+			OutValue = FieldValue->AsString();
+			return true;
+		}
+	}
+	return false;
+}
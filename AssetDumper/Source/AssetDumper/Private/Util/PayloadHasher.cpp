@@ -0,0 +1,59 @@
+#include "Util/PayloadHasher.h"
+#include "Async/ParallelFor.h"
+#include "Hash/CityHash.h"
+#include "Misc/SecureHash.h"
+
+/** Size of the chunks hashed independently, so large payloads can be hashed by multiple threads at once */
+#define PAYLOAD_HASH_CHUNK_SIZE (4 * 1024 * 1024)
+
+FString HashPayloadCityHash64(const uint8* Data, int64 DataSize) {
+	const int32 NumChunks = FMath::Max(1, (int32) FMath::DivideAndRoundUp(DataSize, (int64) PAYLOAD_HASH_CHUNK_SIZE));
+	TArray<uint64> ChunkHashes;
+	ChunkHashes.AddUninitialized(NumChunks);
+
+	ParallelFor(NumChunks, [&](const int32 ChunkIndex) {
+		const int64 ChunkOffset = (int64) ChunkIndex * PAYLOAD_HASH_CHUNK_SIZE;
+		const int64 ChunkSize = FMath::Min((int64) PAYLOAD_HASH_CHUNK_SIZE, DataSize - ChunkOffset);
+		ChunkHashes[ChunkIndex] = CityHash64((const char*) Data + ChunkOffset, (uint32) ChunkSize);
+	});
+
+	//Hash of the whole payload is a hash of the chunk hashes, so it only depends on the payload contents and the chunk size
+	const uint64 PayloadHash = CityHash64((const char*) ChunkHashes.GetData(), ChunkHashes.Num() * sizeof(uint64));
+	return FString::Printf(TEXT("%016llx"), PayloadHash);
+}
+
+EPayloadHashAlgorithm FPayloadHasher::GetDefaultAlgorithm() {
+	return EPayloadHashAlgorithm::CityHash64;
+}
+
+FString FPayloadHasher::GetAlgorithmName(EPayloadHashAlgorithm Algorithm) {
+	switch (Algorithm) {
+		case EPayloadHashAlgorithm::MD5: return TEXT("MD5");
+		case EPayloadHashAlgorithm::CityHash64: return TEXT("CityHash64");
+		default: checkf(0, TEXT("Unknown payload hash algorithm %d"), (int32) Algorithm); return TEXT("");
+	}
+}
+
+bool FPayloadHasher::FindAlgorithmByName(const FString& AlgorithmName, EPayloadHashAlgorithm& OutAlgorithm) {
+	if (AlgorithmName == TEXT("MD5")) {
+		OutAlgorithm = EPayloadHashAlgorithm::MD5;
+		return true;
+	}
+	if (AlgorithmName == TEXT("CityHash64")) {
+		OutAlgorithm = EPayloadHashAlgorithm::CityHash64;
+		return true;
+	}
+	return false;
+}
+
+FString FPayloadHasher::HashPayload(const uint8* Data, int64 DataSize, EPayloadHashAlgorithm Algorithm) {
+	FString Hash;
+	if (Algorithm == EPayloadHashAlgorithm::MD5) {
+		//MD5 state cannot be split between threads, and hashes need to match the ones written by the older dumps
+		Hash = FMD5::HashBytes(Data, DataSize);
+	} else {
+		Hash = HashPayloadCityHash64(Data, DataSize);
+	}
+	Hash.Append(FString::Printf(TEXT("%llx"), DataSize));
+	return Hash;
+}
@@ -9,6 +9,11 @@
 #define METHOD_PATCHING_SUPPORTED 0
 #endif
 
+/** When set, property and object hierarchy serializers are compiled without optimizations to make debugging them easier */
+#ifndef ASSET_DUMPER_DEBUG_SERIALIZERS
+#define ASSET_DUMPER_DEBUG_SERIALIZERS 0
+#endif
+
 DECLARE_LOG_CATEGORY_EXTERN(LogAssetDumper, All, All);
 
 class ASSETDUMPER_API FAssetDumperModule : public FDefaultGameModuleImpl {
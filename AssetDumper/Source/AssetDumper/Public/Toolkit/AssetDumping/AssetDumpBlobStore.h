@@ -0,0 +1,36 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/** Name of the directory under the asset dump root containing content addressed side files */
+#define ASSET_DUMP_BLOB_DIRECTORY_NAME TEXT("Blobs")
+
+/**
+ * Content addressed storage for the side files of the asset dumps, like textures and models
+ * Files are stored under the dump root by the hash of their contents, so identical payloads
+ * of the different assets are only written once, and assets reference them through the hash
+ * Store is safe to use from multiple threads at once
+ */
+class ASSETDUMPER_API FAssetDumpBlobStore {
+private:
+	FString RootDirectory;
+	/** Blobs that have been written or found on disk already, relative to the root directory */
+	TSet<FString> StoredBlobFileNames;
+	FCriticalSection StoredBlobsCriticalSection;
+	
+	FThreadSafeCounter BlobsWritten;
+	FThreadSafeCounter BlobsDeduplicated;
+public:
+	explicit FAssetDumpBlobStore(const FString& RootDirectory);
+
+	/** Returns name of the blob file with provided hash and extension, relative to the dump root directory */
+	static FString MakeBlobFileName(const FString& ContentHash, const FString& Extension);
+
+	/** Stores provided data in the blob store unless it is already present there, returns blob file name */
+	FString StoreBlobData(const FString& ContentHash, const FString& Extension, const TArray64<uint8>& Data);
+
+	FORCEINLINE int32 GetBlobsWritten() const { return BlobsWritten.GetValue(); }
+	FORCEINLINE int32 GetBlobsDeduplicated() const { return BlobsDeduplicated.GetValue(); }
+private:
+	/** Returns true when the caller should write the blob, false when it has been written already */
+	bool ClaimBlob(const FString& BlobFileName);
+};
@@ -0,0 +1,96 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/** Name of the manifest file placed in the asset dump root directory */
+#define ASSET_DUMP_MANIFEST_FILE_NAME TEXT("AssetDump.manifest")
+/** Name of the manifest checkpoint file, periodically written while dump is in progress */
+#define ASSET_DUMP_MANIFEST_CHECKPOINT_FILE_NAME TEXT("AssetDump.manifest.partial")
+
+/** Describes a single dumped package inside of the asset dump manifest */
+struct ASSETDUMPER_API FAssetDumpManifestEntry {
+	/** Long package name, e.g /Game/Path/Asset */
+	FName PackageName;
+	/** Class of the asset contained in the package */
+	FName AssetClass;
+	/** Name of the asset dump file, located in the package directory */
+	FString DumpFileName;
+	/** Size of the asset dump file, in bytes */
+	int64 DumpFileSize;
+	/** Hash of the asset dump file contents */
+	FString DumpFileHash;
+	/** Names of the additional files written alongside the asset dump file, like textures and models */
+	TArray<FString> SideFiles;
+	/** Side files stored in the content addressed blob store, relative to the dump root directory */
+	TArray<FString> BlobFiles;
+	/** Packages referenced by the objects in the asset dump */
+	TArray<FName> ReferencedPackages;
+	/** Hash of the cooked package files the dump has been made from, empty if it could not be computed */
+	FString CookedPackageHash;
+	/** Version of the asset type serializer that produced the dump */
+	int32 SerializerVersion;
+
+	FAssetDumpManifestEntry();
+};
+
+/**
+ * Index of all of the packages present in the asset dump, written by the asset dump processor when dumping finishes
+ * Allows to list dumped packages and retrieve basic information about them without scanning
+ * dump directories and reading asset dump files themselves
+ */
+class ASSETDUMPER_API FAssetDumpManifest {
+private:
+	TMap<FName, FAssetDumpManifestEntry> Entries;
+	/** Maps package path to it's immediate child paths, e.g /Game -> /Game/Path */
+	TMap<FString, TSet<FString>> ChildPackagePaths;
+	/** Maps package path to the packages located directly inside of it */
+	TMap<FString, TArray<FName>> PackagesInPath;
+	/** True when path indices need to be rebuilt */
+	bool bPathIndicesDirty;
+public:
+	FAssetDumpManifest();
+
+	/** Adds new entry or replaces an existing entry for the same package */
+	void AddEntry(const FAssetDumpManifestEntry& Entry);
+
+	/** Removes entry for the provided package, if it is present */
+	void RemoveEntry(FName PackageName);
+
+	/** Returns entry for the provided package, or NULL if it is not present in the manifest */
+	FORCEINLINE const FAssetDumpManifestEntry* FindEntry(FName PackageName) const { return Entries.Find(PackageName); }
+
+	FORCEINLINE const TMap<FName, FAssetDumpManifestEntry>& GetEntries() const { return Entries; }
+
+	/** Appends package paths located directly under the provided path and packages inside of it. Root path is / */
+	void GetPathContents(const FString& PackagePath, TArray<FString>& OutChildPaths, TArray<FName>& OutPackageNames);
+
+	/** Returns full path to the asset dump file of the provided entry */
+	static FString GetDumpFilePath(const FString& RootDirectory, const FAssetDumpManifestEntry& Entry);
+
+	/** Returns path of the manifest file inside of the provided dump root directory */
+	static FString GetManifestFilePath(const FString& RootDirectory);
+
+	/** Returns path of the manifest checkpoint file inside of the provided dump root directory */
+	static FString GetCheckpointFilePath(const FString& RootDirectory);
+
+	/**
+	 * Loads manifest from the provided dump root directory. Returns invalid pointer if there is no manifest or it cannot be read
+	 * When bAllowCheckpoint is true, checkpoint of the interrupted dump will be loaded if there is no complete manifest
+	 */
+	static TSharedPtr<FAssetDumpManifest> LoadFromDirectory(const FString& RootDirectory, bool bAllowCheckpoint = false);
+
+	/** Writes manifest into the provided dump root directory */
+	bool SaveToDirectory(const FString& RootDirectory) const;
+
+	/** Writes manifest checkpoint into the provided dump root directory, it is only used to resume interrupted dumps */
+	bool SaveCheckpointToDirectory(const FString& RootDirectory) const;
+
+	/** Deletes manifest file from the provided directory, so partially completed dumps are not considered indexed */
+	static void DeleteFromDirectory(const FString& RootDirectory);
+
+	/** Deletes manifest checkpoint file from the provided directory */
+	static void DeleteCheckpointFromDirectory(const FString& RootDirectory);
+private:
+	void RebuildPathIndices();
+	bool SaveToFile(const FString& ManifestFilePath) const;
+	static TSharedPtr<FAssetDumpManifest> LoadFromFile(const FString& ManifestFilePath);
+};
@@ -0,0 +1,58 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Toolkit/AssetDumping/AssetDumpProcessor.h"
+
+/**
+ * Single stage of the asset dump pipeline, processing packages on the thread pool
+ * Every stage has a limited amount of workers and a bounded queue of packages waiting for them,
+ * and stops taking packages from it's queue while the next stage is full, so slow stages
+ * apply backpressure on the stages before them instead of accumulating packages in memory
+ * Stages should never touch UObjects, all of the UObject work is done on the game thread before packages enter the pipeline
+ */
+class ASSETDUMPER_API FAssetDumpPipelineStage {
+public:
+	using FStageFunction = TFunction<void(FPendingPackageData& PackageData)>;
+private:
+	FString StageName;
+	int32 MaxWorkers;
+	int32 MaxQueuedPackages;
+	bool bForceSingleThread;
+	FStageFunction StageFunction;
+	/** Called with the processed package once worker is done with it, receives ownership of the package data */
+	FStageFunction OnPackageProcessed;
+	/** Stage packages will be passed to after being processed, used to check for backpressure */
+	FAssetDumpPipelineStage* NextStage;
+	/** Stage feeding packages into this one, notified when we have space for more packages */
+	FAssetDumpPipelineStage* PreviousStage;
+
+	FCriticalSection QueueCriticalSection;
+	TArray<FPendingPackageData> QueuedPackages;
+	int32 ActiveWorkers;
+	/** Amount of packages queued or being processed in this stage */
+	FThreadSafeCounter PackagesInStage;
+public:
+	FAssetDumpPipelineStage(const FString& StageName, int32 MaxWorkers, int32 MaxQueuedPackages, bool bForceSingleThread, FStageFunction StageFunction);
+	~FAssetDumpPipelineStage();
+
+	/** Sets the stage processed packages are handed over to, and the handler called for every processed package */
+	void SetOutput(FAssetDumpPipelineStage* NextStage, FStageFunction OnPackageProcessed);
+
+	/** Returns true when stage can accept more packages without exceeding it's queue size */
+	FORCEINLINE bool CanAcceptPackage() const { return PackagesInStage.GetValue() < MaxQueuedPackages + MaxWorkers; }
+
+	/** Returns amount of packages stage can accept before it's queue is full */
+	FORCEINLINE int32 GetFreeSpace() const { return FMath::Max(MaxQueuedPackages + MaxWorkers - PackagesInStage.GetValue(), 0); }
+
+	/** Returns amount of packages waiting for processing or being processed in this stage */
+	FORCEINLINE int32 GetPackagesInStage() const { return PackagesInStage.GetValue(); }
+
+	FORCEINLINE const FString& GetStageName() const { return StageName; }
+
+	/** Adds package to the queue of this stage and starts workers if possible */
+	void EnqueuePackage(FPendingPackageData&& PackageData);
+
+	/** Starts new workers for the queued packages, as long as worker limit and next stage backpressure allow it */
+	void StartWorkers();
+private:
+	void ProcessPackage(FPendingPackageData& PackageData);
+};
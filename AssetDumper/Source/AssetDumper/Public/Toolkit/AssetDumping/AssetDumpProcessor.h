@@ -1,17 +1,38 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "Tickable.h"
+#include "Async/Future.h"
 #include "AssetData.h"
 #include "AssetDumperModule.h"
+#include "Toolkit/AssetDumping/SerializationContext.h"
 
 /** Holds asset dumping related settings */
 struct ASSETDUMPER_API FAssetDumpSettings {
 	FString RootDumpDirectory;
 	int32 MaxPackagesToProcessInOneTick;
 	bool bForceSingleThread;
+	/**
+	 * When false, packages will only be dumped if they have changed since the last dump into the same directory,
+	 * e.g. their cooked package files or the version of their asset serializer are different
+	 */
 	bool bOverwriteExistingAssets;
 	bool bExitOnFinish;
+	/** Minimum amount of seconds between garbage collections, which are only performed when memory usage approaches the budget */
 	float GarbageCollectionInterval;
+	/**
+	 * Amount of resident memory dumping is allowed to use, in megabytes. Zero means part of the physical memory is used
+	 * Amount of packages loaded and processed at once is reduced as memory usage approaches the budget
+	 */
+	int32 MemoryBudgetMB;
+	/** Format in which asset dump files are written */
+	EAssetDumpFileFormat DumpFileFormat;
+	/** When true, side files like textures and models are stored once per unique content in the blob store under the dump root */
+	bool bUseBlobStore;
+	/** Maximum amount of workers encoding dump files and side files, and amount of workers writing them to disk */
+	int32 MaxEncodeWorkers;
+	int32 MaxWriteWorkers;
+	/** Algorithm used for hashing asset payloads, recorded in the asset dump files so the asset generator can compute matching hashes */
+	EPayloadHashAlgorithm PayloadHashAlgorithm;
 
 	/** Default settings for asset dumping */
 	FAssetDumpSettings();
@@ -20,12 +41,39 @@ struct ASSETDUMPER_API FAssetDumpSettings {
 	static FString GetDefaultRootDumpDirectory();
 };
 
+/** Counters describing memory usage of the asset dump and how it has been throttled to stay within the memory budget */
+struct ASSETDUMPER_API FAssetDumpMemoryStats {
+	uint64 MemoryBudget;
+	uint64 UsedPhysicalMemory;
+	uint64 PeakUsedPhysicalMemory;
+	/** Packages loaded or being loaded and not processed yet, which are kept in memory */
+	int32 PackagesInMemory;
+	int32 PeakPackagesInMemory;
+	int32 GarbageCollections;
+	double GarbageCollectionSeconds;
+	/** Amount of ticks during which package loading and processing have been throttled */
+	int32 ThrottledTicks;
+	int32 CurrentMaxLoadRequestsInFly;
+	int32 CurrentMaxPackagesToProcessInOneTick;
+
+	FAssetDumpMemoryStats();
+};
+
 struct FPendingPackageData {
 public:
 	UObject* AssetObject;
 	UPackage* Package;
 	TSharedPtr<class FSerializationContext> SerializationContext;
 	class UAssetTypeSerializer* Serializer;
+	/** Hash of the cooked package files, recorded into the manifest for incremental dumps */
+	FString CookedPackageHash;
+};
+
+/** Package waiting for the hash of it's cooked files to be computed on the worker thread before it can be checked for changes */
+struct FPendingPackageHash {
+public:
+	FAssetData* AssetData;
+	TFuture<FString> CookedPackageHash;
 };
 
 /**
@@ -39,6 +87,11 @@ private:
 	
 	TArray<FAssetData> PackagesToLoad;
 	TMap<FName, FAssetData*> AssetDataByPackageName; 
+	/** Hashes of the cooked package files, computed before the packages are loaded */
+	TMap<FName, FString> CookedPackageHashes;
+	/** Upcoming packages in the load order, which cooked files are being hashed */
+	TArray<FPendingPackageHash> PendingPackageHashes;
+	int32 MaxPendingPackageHashes;
 	int32 CurrentPackageToLoadIndex;
 	
 	FThreadSafeCounter PackageLoadRequestsInFlyCounter;
@@ -53,10 +106,34 @@ private:
 	FAssetDumpSettings Settings;
 	bool bHasFinishedDumping;
 	float TimeSinceGarbageCollection;
+	float TimeSinceMemoryTrim;
+	/** Used physical memory measured right after the last garbage collection, next one is only performed once usage grows past it */
+	uint64 UsedPhysicalMemoryAfterGarbageCollection;
+	float TimeSinceManifestCheckpoint;
 
 	int32 MaxLoadRequestsInFly;
 	int32 MaxPackagesInProcessQueue;
 	int32 MaxPackagesToProcessInOneTick;
+	/** Limits before memory budget throttling has been applied */
+	int32 BaseMaxLoadRequestsInFly;
+	int32 BaseMaxPackagesToProcessInOneTick;
+	FAssetDumpMemoryStats MemoryStats;
+	bool bReportedMemoryBudgetExceeded;
+
+	/** Manifest of the dump, containing entries from the previous dumps into the same directory and packages dumped so far */
+	TSharedPtr<class FAssetDumpManifest> DumpManifest;
+	FCriticalSection DumpManifestCriticalSection;
+
+	/** Content addressed store for the side files, NULL when it is disabled in the settings */
+	TSharedPtr<class FAssetDumpBlobStore> BlobStore;
+
+	/** Pipeline stages serialized packages go through before being finished on the game thread */
+	TUniquePtr<class FAssetDumpPipelineStage> EncodeStage;
+	TUniquePtr<class FAssetDumpPipelineStage> WriteStage;
+	
+	/** Packages that have been written to disk and are waiting to be recorded in the manifest */
+	FCriticalSection WrittenPackagesCriticalSection;
+	TArray<FPendingPackageData> WrittenPackages;
 	
 	explicit FAssetDumpProcessor(const FAssetDumpSettings& Settings, const TArray<FAssetData>& InAssets);
 	explicit FAssetDumpProcessor(const FAssetDumpSettings& Settings, const TMap<FName, FAssetData>& InAssets);
@@ -77,6 +154,7 @@ public:
 	FORCEINLINE int32 GetPackagesSkipped() const { return PackagesSkipped.GetValue(); }
 	FORCEINLINE int32 GetPackagesProcessed() const { return PackagesProcessed.GetValue(); }
 	FORCEINLINE bool IsFinishedDumping() const { return bHasFinishedDumping; }
+	FORCEINLINE const FAssetDumpMemoryStats& GetMemoryStats() const { return MemoryStats; }
 	
 	//Begin FTickableGameObject
 	virtual void Tick(float DeltaTime) override;
@@ -87,6 +165,13 @@ public:
 protected:
 	bool CreatePackageData(UPackage* Package, FPendingPackageData& PendingPackageData);
 	void InitializeAssetDump();
+	/** Collects garbage when memory usage approaches the budget and throttles package loading and processing */
+	void UpdateMemoryBudget(float DeltaTime);
+	/** Returns true if package dump is up to date and it can be skipped without loading the package */
+	bool IsPackageDumpUpToDate(const FAssetData& AssetData, const FString& CookedPackageHash) const;
 	void OnPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result);
 	void PerformAssetDumpForPackage(const FPendingPackageData& PackageData);
+	/** Records packages that have gone through the whole pipeline. Called on the game thread */
+	void FinishWrittenPackages();
+	bool IsPipelineEmpty();
 };
\ No newline at end of file
@@ -37,6 +37,12 @@ public:
 	/** Determines whenever this serializer supports being run in parallel in worker threads. Override and return false if you depend on main thread state */
 	virtual bool SupportsParallelDumping() const { return true; }
 
+	/**
+	 * Returns version of the data written by this serializer. Incremental dumps will re-dump assets
+	 * dumped by the different version of the serializer, so bump it every time serialized data changes
+	 */
+	virtual int32 GetSerializerVersion() const { return 1; }
+
     /**
      * Returns serializer capable of serializing asset of specified class
      * or NULL if such serializer cannot be resolved.
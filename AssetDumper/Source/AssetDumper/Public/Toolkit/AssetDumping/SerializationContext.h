@@ -1,9 +1,21 @@
 #pragma once
 #include "CoreMinimal.h"
+#include "Util/PayloadHasher.h"
 
 class UPropertySerializer;
 class UObjectHierarchySerializer;
 class FJsonObject;
+class FArchive;
+struct FAssetDumpManifestEntry;
+class FAssetDumpBlobStore;
+
+/** Format of the asset dump file containing serialized asset data and object hierarchy */
+enum class EAssetDumpFileFormat : uint8 {
+	/** Human readable json file */
+	Json,
+	/** Binary encoding of the same json document, see FBinaryJsonWriter. Much faster to write and read */
+	BinaryJson
+};
 
 /**
  * Describes context used for the serialization of a single asset object
@@ -32,12 +44,52 @@ private:
 	UObjectHierarchySerializer* ObjectHierarchySerializer;
 	/** Additional data serialized by the asset type serializer */
 	TSharedPtr<FJsonObject> AssetSerializedData;
+	/** Format of the asset dump file we will write */
+	EAssetDumpFileFormat DumpFileFormat;
+	/** Names of the additional files requested through GetDumpFilePath, relative to the package directory */
+	mutable TArray<FString> SideFileNames;
+	/** Blob store for the side files, or NULL if they should be written into the package directory */
+	TSharedPtr<FAssetDumpBlobStore> BlobStore;
+	/** Maps names of the side files moved into the blob store to blob file names, relative to the root directory */
+	mutable TMap<FString, FString> BlobFileNames;
+	/** Algorithm used for hashing asset payloads, recorded into the asset dump file */
+	EPayloadHashAlgorithm PayloadHashAlgorithm;
+	/** Size and hash of the asset dump file, computed while it is being written */
+	int64 DumpFileSize;
+	FString DumpFileHash;
+
+	/** Side file which data is encoded and written by the asset dump pipeline after asset serialization is done */
+	struct FPendingDumpFile {
+		FString Postfix;
+		FString Extension;
+		TFunction<void(TArray64<uint8>& OutData)> DataEncoder;
+		TArray64<uint8> Data;
+		FString ContentHash;
+	};
+	mutable TArray<FPendingDumpFile> PendingDumpFiles;
+	/** Packages referenced by the serialized objects, collected before UObjects are released */
+	TArray<FName> ReferencedPackageNames;
 
 	/** Internal constructor */
-	FSerializationContext(const FString& RootOutputDirectory, const FAssetData& AssetData, UObject* AssetObject);
+	FSerializationContext(const FString& RootOutputDirectory, const FAssetData& AssetData, UObject* AssetObject, EAssetDumpFileFormat DumpFileFormat, TSharedPtr<FAssetDumpBlobStore> BlobStore, EPayloadHashAlgorithm PayloadHashAlgorithm);
+
+	/** Called after asset has been serialized, collects all of the information that requires access to UObjects */
+	void FinishSerialization();
+
+	/** Encodes pending side files into memory. Does not touch UObjects, so can be called from any thread */
+	void EncodeDumpFiles();
+
+	/** Writes encoded side files to disk and streams the asset dump file into the file. Does not touch UObjects, so can be called from any thread */
+	void WriteDumpFiles();
+
+	void WriteJsonDumpFile(FArchive& FileWriter);
+	void WriteBinaryDumpFile(FArchive& FileWriter);
+
+	/** Creates manifest entry describing the package we have dumped. Should be called after WriteDumpFiles */
+	void CreateManifestEntry(FAssetDumpManifestEntry& OutManifestEntry) const;
 
-	/** Finalizes serialization by writing resulting JSON file containing object hierarchy and additional information */
-	void Finalize() const;
+	/** Builds path for the file with provided postfix and extension inside of the package directory */
+	FString MakeDumpFileName(const FString& Postfix, const FString& Extension) const;
 public:
 	~FSerializationContext();
 
@@ -93,25 +145,35 @@ public:
 
 	/** Returns file path for the dump output file with provided postfix (can be empty) and extension. File is placed in the base asset directory */
 	FORCEINLINE FString GetDumpFilePath(const FString& Postfix, const FString& Extension) const {
-		FString Filename = FPackageName::GetShortName(GetPackageName());
+		const FString Filename = MakeDumpFileName(Postfix, Extension);
 		
-		//TODO can we even have multiple assets in one package? what should be the treatment for that case?
-		//We cannot really specify that information inside of the filename because we can lookup entire package by request,
-		//and not just a single asset object, and iterating files to find exact json name is too expensive for massive dumping
-		//As far as I'm aware, package can only contain one asset, because usually it only contains one top level object,
-		//and only top level objects are considered to be assets (so f.e. font-embedded textures do not represent separate assets)
-		//Filename.AppendChar('-').Append(GetAssetName());
-		
-		if (Postfix.Len() > 0) {
-			Filename.AppendChar('-').Append(Postfix);
-		}
-		if (Extension.Len() > 0) {
-			if (Extension[0] != '.')
-				Filename.AppendChar('.');
-			Filename.Append(Extension);
-		}
+		//Keep track of additional files so they can be listed in the dump manifest
+		SideFileNames.AddUnique(Filename);
 		return FPaths::Combine(PackageBaseDirectory, Filename);
 	}
 
+	/**
+	 * Schedules side file with provided postfix and extension to be written once asset has been serialized
+	 * Data encoder is called from the asset dump pipeline worker thread, so it should not access any UObjects
+	 * When blob store is enabled, file is stored there instead, so identical data of different assets is only written once
+	 */
+	void StoreDumpFileData(const FString& Postfix, const FString& Extension, TFunction<void(TArray64<uint8>& OutData)> DataEncoder) const;
+
+	/** Schedules side file with already encoded data to be written once asset has been serialized, see overload above */
+	void StoreDumpFileData(const FString& Postfix, const FString& Extension, TArray64<uint8>&& Data) const;
+
+	/** Computes hash of the asset payload, like decompressed texture data, with the algorithm recorded in the asset dump file */
+	FORCEINLINE FString ComputePayloadHash(const uint8* Data, int64 DataSize) const {
+		return FPayloadHasher::HashPayload(Data, DataSize, PayloadHashAlgorithm);
+	}
+
+	/** Returns path to the main asset dump file, with the extension matching the dump file format */
+	FORCEINLINE FString GetAssetDumpFilePath() const {
+		return FPaths::Combine(PackageBaseDirectory, MakeDumpFileName(TEXT(""), GetDumpFileExtension(DumpFileFormat)));
+	}
+
 	FORCEINLINE const FString& GetRootOutputDirectory() const { return RootOutputDirectory; }
+
+	/** Returns file extension used by the asset dump files of the provided format */
+	static FString GetDumpFileExtension(EAssetDumpFileFormat DumpFileFormat);
 };
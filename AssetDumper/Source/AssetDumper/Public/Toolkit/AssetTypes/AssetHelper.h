@@ -32,10 +32,4 @@ public:
 
     /** Serializes UEnum object in a way mirroring native UEnum::Serialize implementation */
     static void SerializeEnum(TSharedPtr<FJsonObject> OutObject, UEnum* Enum);
-
-	/** Computes hash for the provided payload */
-	static FString ComputePayloadHash(const TArray64<uint8>& Payload);
-
-	/* Computes hash for the provided payload */
-	static FString ComputePayloadHash(const TArray<uint8>& Payload);
 };
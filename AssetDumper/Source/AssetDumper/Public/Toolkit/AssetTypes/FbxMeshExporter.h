@@ -13,36 +13,52 @@ struct FReferenceSkeleton;
 struct FStaticMeshVertexBuffers;
 class UAnimSequence;
 
+/** Counters describing reuse of the pooled FBX SDK managers and scenes by the exports */
+struct ASSETDUMPER_API FFbxExportPoolStats {
+	/** Exports that reused manager and scene allocated by the previous export on the same thread */
+	int32 PoolHits;
+	/** Exports that had to allocate a new manager */
+	int32 PoolMisses;
+	/** Total time spent creating managers, in seconds */
+	double ManagerCreationSeconds;
+};
+
 class ASSETDUMPER_API FFbxMeshExporter {
 public:
     /**
-     * Exports static mesh data into the FBX file using the specified path
+     * Exports static mesh data into the FBX file data
      * If exporting fails, false is returned and error message is populated with error message
      * Keep in mind that not all information is exported, and materials are not exported
      * Material slot names are kept intact during export though, and are filled with dummy materials
      */
-    static bool ExportStaticMeshIntoFbxFile(UStaticMesh* StaticMesh, const FString& OutFileName, bool bExportAsText = false, FString* OutErrorMessage = NULL);
+    static bool ExportStaticMeshIntoFbxData(UStaticMesh* StaticMesh, TArray64<uint8>& OutFileData, bool bExportAsText = false, FString* OutErrorMessage = NULL);
 
     /**
      * Exports skeleton itself into the FBX file
      * It does not actually export any geometry or animations, just a bare skeleton
      */
-    static bool ExportSkeletonIntoFbxFile(USkeleton* Skeleton, const FString& OutFileName, bool bExportAsText = false, FString* OutErrorMessage = NULL);
+    static bool ExportSkeletonIntoFbxData(USkeleton* Skeleton, TArray64<uint8>& OutFileData, bool bExportAsText = false, FString* OutErrorMessage = NULL);
  
     /**
      * Exports skeletal mesh into the FBX file
-     * Overall behavior is similar to ExportStaticMeshIntoFbxFile, but
+     * Overall behavior is similar to ExportStaticMeshIntoFbxData, but
      * additional skeletal mesh related data (e.g skeleton, skin weights and binding pose) is exported
      * Animations are exported separately and this function does not handle that
      */
-    static bool ExportSkeletalMeshIntoFbxFile(USkeletalMesh* SkeletalMesh, const FString& OutFileName, bool bExportAsText = false, FString* OutErrorMessage = NULL);
+    static bool ExportSkeletalMeshIntoFbxData(USkeletalMesh* SkeletalMesh, TArray64<uint8>& OutFileData, bool bExportAsText = false, FString* OutErrorMessage = NULL);
 
     /**
      * Exports animation sequence into the fbx file
      * Will export associated skeleton and animation applied to it,
      * but will not export any kind of skeletal meshes
      */
-    static bool ExportAnimSequenceIntoFbxFile(UAnimSequence* AnimSequence, const FString& OutFileName, bool bExportAsText = false, FString* OutErrorMessage = NULL);
+    static bool ExportAnimSequenceIntoFbxData(UAnimSequence* AnimSequence, TArray64<uint8>& OutFileData, bool bExportAsText = false, FString* OutErrorMessage = NULL);
+
+	/** Returns counters of the FBX SDK manager pool shared by all of the exports */
+	static FFbxExportPoolStats GetExportPoolStats();
+
+	/** Computes hash of the exported FBX file data, matching the source file hash recorded by the editor on import */
+	static FString ComputeFbxFileHash(const TArray64<uint8>& FileData);
 
 	/**
 	 * Attempts to generate smoothing groups using normal and neighbour buffer information
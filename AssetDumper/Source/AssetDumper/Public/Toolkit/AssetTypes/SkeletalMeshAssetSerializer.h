@@ -11,5 +11,7 @@ public:
     static void SerializeReferenceSkeleton(const struct FReferenceSkeleton& ReferenceSkeleton, TSharedPtr<class FJsonObject> OutObject);
     
     virtual FName GetAssetClass() const override;
-	virtual bool SupportsParallelDumping() const override;
+
+    /** Version 2: exported FBX files contain actual skin weights instead of zero weights */
+    virtual int32 GetSerializerVersion() const override { return 2; }
 };
@@ -9,5 +9,4 @@ public:
     virtual void SerializeAsset(TSharedRef<FSerializationContext> Context) const override;
 
     virtual FName GetAssetClass() const override;
-    virtual bool SupportsParallelDumping() const override;
 };
@@ -11,4 +11,11 @@ public:
      * no intention to support texture formats used outside of FactoryGame assets
      */
     static bool DecompressTextureData(EPixelFormat PixelFormat, const uint8* CompressedData, int32 TextureWidth, int32 TextureHeight, TArray<uint8>& OutDecompressedData, FString* OutErrorMessage = NULL);
+
+    /**
+     * Decompresses multiple slices of the same size located one after another in the compressed data,
+     * and stacks them vertically in the output data. Slices are split into tiles of block rows
+     * which are decompressed in parallel, so large textures, cubemaps and texture arrays use all of the cores
+     */
+    static bool DecompressTextureSlices(EPixelFormat PixelFormat, const uint8* CompressedData, int64 BytesPerSlice, int32 NumSlices, int32 TextureWidth, int32 TextureHeight, TArray<uint8>& OutDecompressedData, FString* OutErrorMessage = NULL);
 };
@@ -1,6 +1,7 @@
 #pragma once
 #include "UObject/Object.h"
 #include "Json.h"
+#include "Util/JsonFileWriter.h"
 #include "ObjectHierarchySerializer.generated.h"
 
 class UPropertySerializer;
@@ -17,7 +18,7 @@ struct ASSETDUMPER_API FObjectCompareSettings {
 };
 
 class ASSETDUMPER_API FObjectCompareContext {
-	TArray<TPair<int32, UObject*>> ObjectsAlreadyCompared;
+	TSet<TPair<int32, UObject*>> ObjectsAlreadyCompared;
 	TMap<int32, FObjectCompareSettings> CompareSettings;
 public:
 	FObjectCompareContext();
@@ -43,6 +44,9 @@ private:
     TMap<int32, TSharedPtr<FJsonObject>> SerializedObjects;
     UPROPERTY()
     TMap<UObject*, FString> ObjectMarks;
+    /** Reverse index of the ObjectMarks, always kept in sync with it */
+    UPROPERTY()
+    TMap<FString, UObject*> ObjectsByMark;
 public:
     UObjectHierarchySerializer();
 
@@ -83,26 +87,55 @@ public:
     
     TArray<TSharedPtr<FJsonValue>> FinalizeSerialization();
 
+	/**
+	 * Writes serialized objects directly into the provided writer as an array field with the given identifier
+	 * Every object json is released right after it has been written, so this serializer cannot be finalized twice
+	 */
+	void FinalizeSerialization(const TSharedRef<FJsonFileWriter>& Writer, const FString& Identifier);
+
+	/** Same as above, but writes objects using the binary json writer */
+	void FinalizeSerialization(class FBinaryJsonWriter& Writer, const FString& Identifier);
+
+	/** Appends packages referenced by the provided objects to the output array, in the order they are first encountered. Packages already present in the array are not added again */
 	void CollectReferencedPackages(const TArray<TSharedPtr<FJsonValue>>& ReferencedSubobjects, TArray<FString>& OutReferencedPackageNames);
 
-	void CollectReferencedPackages(const TArray<TSharedPtr<FJsonValue>>& ReferencedSubobjects, TArray<FString>& OutReferencedPackageNames, TArray<int32>& ObjectsAlreadySerialized);
+	void CollectReferencedPackages(const TArray<TSharedPtr<FJsonValue>>& ReferencedSubobjects, TArray<FString>& OutReferencedPackageNames, TSet<int32>& ObjectsAlreadySerialized);
 
 	FORCEINLINE void CollectObjectPackages(const int32 ObjectIndex, TArray<FString>& OutReferencedPackageNames) {
-		TArray<int32> ObjectsAlreadySerialized;
+		TSet<int32> ObjectsAlreadySerialized;
 		CollectObjectPackages(ObjectIndex, OutReferencedPackageNames, ObjectsAlreadySerialized);
 	}
 
-	void CollectObjectPackages(const int32 ObjectIndex, TArray<FString>& OutReferencedPackageNames, TArray<int32>& ObjectsAlreadySerialized);
+	void CollectObjectPackages(const int32 ObjectIndex, TArray<FString>& OutReferencedPackageNames, TSet<int32>& ObjectsAlreadySerialized);
+
+	/**
+	 * Overloads for the callers collecting packages of many objects into the same output array
+	 * Set of the package names already present in the array is owned by the caller and kept in sync with it, so it is not rebuilt on every call
+	 */
+	void CollectReferencedPackages(const TArray<TSharedPtr<FJsonValue>>& ReferencedSubobjects, TArray<FString>& OutReferencedPackageNames, TSet<FString>& ReferencedPackageNameSet, TSet<int32>& ObjectsAlreadySerialized);
+
+	FORCEINLINE void CollectObjectPackages(const int32 ObjectIndex, TArray<FString>& OutReferencedPackageNames, TSet<FString>& ReferencedPackageNameSet, TSet<int32>& ObjectsAlreadySerialized) {
+		CollectObjectPackagesInternal(ObjectIndex, OutReferencedPackageNames, ReferencedPackageNameSet, ObjectsAlreadySerialized);
+	}
 
 	FString GetObjectFullPath(int32 ObjectIndex);
 
+	/** Appends names of the packages of all imported objects serialized so far, sorted by name */
+	void CollectImportedPackages(TArray<FName>& OutPackageNames) const;
+
     FORCEINLINE static const TSet<FName>& GetUnhandledNativeClasses() { return UnhandledNativeClasses; }
 private:
     static TSet<FName> UnhandledNativeClasses;
+
+	/** Removes serialized objects in their index order and passes them to the provided callback */
+	void ReleaseSerializedObjects(TFunctionRef<void(const TSharedRef<FJsonObject>& ObjectJson)> Callback);
     
     void SerializeImportedObject(TSharedPtr<FJsonObject> ResultJson, UObject* Object);
     void SerializeExportedObject(TSharedPtr<FJsonObject> ResultJson, UObject* Object);
 
     UObject* DeserializeImportedObject(TSharedPtr<FJsonObject> ObjectJson);
     UObject* DeserializeExportedObject(int32 ObjectIndex, TSharedPtr<FJsonObject> ObjectJson);
+
+	/** Walks object graph starting at the provided object, using the set of package names to skip packages already present in the output array */
+	void CollectObjectPackagesInternal(int32 ObjectIndex, TArray<FString>& OutReferencedPackageNames, TSet<FString>& ReferencedPackageNameSet, TSet<int32>& ObjectsAlreadySerialized);
 };
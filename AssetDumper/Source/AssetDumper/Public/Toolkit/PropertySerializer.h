@@ -5,6 +5,93 @@
 #include "PropertySerializer.generated.h"
 
 class UObjectHierarchySerializer;
+class FStructSerializer;
+
+/** Kind of the property value, resolved once per property so serialization can dispatch on it without walking the cast chain */
+enum class EPropertyValueType : uint8 {
+	Unsupported,
+	Map,
+	Set,
+	Array,
+	MulticastDelegate,
+	Delegate,
+	Interface,
+	SoftObject,
+	Object,
+	Struct,
+	Byte,
+	Numeric,
+	Bool,
+	String,
+	Enum,
+	Name,
+	Text,
+	FieldPath
+};
+
+/** Property together with it's resolved value type and the value types of it's container elements */
+struct ASSETDUMPER_API FPropertySerializationInfo {
+	FProperty* Property;
+	/** Name of the property as written into the json, only set for the struct members */
+	FString PropertyName;
+	EPropertyValueType ValueType;
+	/** Element type for arrays and sets, key type for maps */
+	EPropertyValueType ElementType;
+	/** Value type for maps */
+	EPropertyValueType MapValueType;
+
+	/** Resolves value types of the property and it's container elements */
+	explicit FPropertySerializationInfo(FProperty* Property);
+	/** Describes a container element with already resolved value type */
+	FPropertySerializationInfo(FProperty* Property, EPropertyValueType ValueType);
+};
+
+/** Serialized properties of the struct or class, built once per struct and shared by all of the property serializers */
+struct ASSETDUMPER_API FStructSerializationPlan {
+	/** Properties that should be serialized, in the property link order */
+	TArray<FPropertySerializationInfo> Properties;
+};
+
+/**
+ * Module wide cache of the struct serialization plans, shared by all of the property serializers and safe to use from any thread
+ * Plans only filter out transient, editor only and deprecated properties, blacklists of the individual serializers are applied on top of them
+ * Plans of the garbage collected and replaced structs are dropped automatically, structs recompiled in place have to be invalidated explicitly
+ */
+class ASSETDUMPER_API FStructSerializationPlanCache {
+private:
+	struct FCachedPlan {
+		/** Used to detect struct being garbage collected and it's address reused by another one */
+		TWeakObjectPtr<UStruct> Struct;
+		TSharedRef<const FStructSerializationPlan> Plan;
+	};
+
+	FCriticalSection CriticalSection;
+	TMap<UStruct*, FCachedPlan> CachedPlans;
+	FDelegateHandle PostGarbageCollectHandle;
+	FDelegateHandle ObjectsReplacedHandle;
+
+	void OnPostGarbageCollect();
+	void OnObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap);
+public:
+	static FStructSerializationPlanCache& Get();
+
+	/** Subscribes to garbage collection and object replacement, called on module startup */
+	void Initialize();
+	/** Unsubscribes from the delegates and drops all of the plans, called on module shutdown */
+	void Shutdown();
+
+	/** Returns plan for the provided struct or class, building it on the first call */
+	TSharedRef<const FStructSerializationPlan> FindOrBuildPlan(UStruct* Struct);
+
+	/** Drops plans of the provided struct and all of it's children, should be called when struct is recompiled in place */
+	void InvalidatePlans(UStruct* Struct);
+
+	/** Drops all of the cached plans */
+	void InvalidateAllPlans();
+
+	/** Determines whenever property should be serialized regardless of the serializer configuration */
+	static bool ShouldSerializePropertyByDefault(FProperty* Property);
+};
 
 /** Handles struct serialization */
 class ASSETDUMPER_API FStructSerializer {
@@ -49,12 +136,15 @@ private:
     UPROPERTY()
     UObjectHierarchySerializer* ObjectHierarchySerializer;
 
+    /** Structs referenced by the blacklisted properties and struct serializers, kept alive while they are referenced */
     UPROPERTY()
-    TArray<UStruct*> PinnedStructs;
-    TArray<FProperty*> BlacklistedProperties;
+    TSet<UStruct*> PinnedStructs;
+    TSet<FProperty*> BlacklistedProperties;
 
     TSharedPtr<FStructSerializer> FallbackStructSerializer;
     TMap<UScriptStruct*, TSharedPtr<FStructSerializer>> StructSerializers;
+	/** Shared plans with blacklisted properties filtered out, together with the shared plan they have been built from. Only used when this serializer has blacklisted properties */
+	TMap<UStruct*, TPair<TSharedRef<const FStructSerializationPlan>, TSharedRef<const FStructSerializationPlan>>> FilteredStructSerializationPlans;
 public:
     UPropertySerializer();
     
@@ -66,17 +156,26 @@ public:
     /** Checks whenever we should serialize property in question at all */
     bool ShouldSerializeProperty(FProperty* Property) const;
 
+	/** Returns properties of the struct or class that should be serialized, using the shared plan cache */
+	TSharedRef<const FStructSerializationPlan> GetStructSerializationPlan(UStruct* Struct);
+
+	/** Resolves value type of the provided property, walking the cast chain once */
+	static EPropertyValueType ResolvePropertyValueType(FProperty* Property);
+
     TSharedRef<FJsonValue> SerializePropertyValue(FProperty* Property, const void* Value, TArray<int32>* OutReferencedSubobjects = NULL);
+    TSharedRef<FJsonValue> SerializePropertyValue(const FPropertySerializationInfo& PropertyInfo, const void* Value, TArray<int32>* OutReferencedSubobjects = NULL);
     TSharedRef<FJsonObject> SerializeStruct(UScriptStruct* Struct, const void* Value, TArray<int32>* OutReferencedSubobjects = NULL);
     
     void DeserializePropertyValue(FProperty* Property, const TSharedRef<FJsonValue>& Value, void* OutValue);
+    void DeserializePropertyValue(const FPropertySerializationInfo& PropertyInfo, const TSharedRef<FJsonValue>& Value, void* OutValue);
     void DeserializeStruct(UScriptStruct* Struct, const TSharedRef<FJsonObject>& Value, void* OutValue);
 
 	bool ComparePropertyValues(FProperty* Property, const TSharedRef<FJsonValue>& JsonValue, const void* CurrentValue, const TSharedPtr<FObjectCompareContext> Context = MakeShareable(new FObjectCompareContext));
+	bool ComparePropertyValues(const FPropertySerializationInfo& PropertyInfo, const TSharedRef<FJsonValue>& JsonValue, const void* CurrentValue, const TSharedPtr<FObjectCompareContext> Context);
 	bool CompareStructs(UScriptStruct* Struct, const TSharedRef<FJsonObject>& JsonValue, const void* CurrentValue, const TSharedPtr<FObjectCompareContext> Context = MakeShareable(new FObjectCompareContext));
 private:
-    FStructSerializer* GetStructSerializer(UScriptStruct* Struct) const;
-	bool ComparePropertyValuesInner(FProperty* Property, const TSharedRef<FJsonValue>& JsonValue, const void* CurrentValue, const TSharedPtr<FObjectCompareContext> Context);
-    void DeserializePropertyValueInner(FProperty* Property, const TSharedRef<FJsonValue>& Value, void* OutValue);
-    TSharedRef<FJsonValue> SerializePropertyValueInner(FProperty* Property, const void* Value, TArray<int32>* OutReferencedSubobjects);
+    FStructSerializer* GetStructSerializer(UScriptStruct* Struct);
+	bool ComparePropertyValuesInner(const FPropertySerializationInfo& PropertyInfo, const TSharedRef<FJsonValue>& JsonValue, const void* CurrentValue, const TSharedPtr<FObjectCompareContext> Context);
+    void DeserializePropertyValueInner(const FPropertySerializationInfo& PropertyInfo, const TSharedRef<FJsonValue>& Value, void* OutValue);
+    TSharedRef<FJsonValue> SerializePropertyValueInner(const FPropertySerializationInfo& PropertyInfo, const void* Value, TArray<int32>* OutReferencedSubobjects);
 };
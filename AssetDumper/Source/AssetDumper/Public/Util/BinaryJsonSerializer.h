@@ -0,0 +1,86 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/** Extension used by the asset dump files written in the binary json format */
+#define BINARY_JSON_FILE_EXTENSION TEXT("bjson")
+
+/** Tags of the binary json value stream */
+enum class EBinaryJsonTag : uint8 {
+	/** Ends an object or an array. Zero is never a valid string reference, so it also terminates object field lists */
+	End = 0,
+	Null = 1,
+	False = 2,
+	True = 3,
+	/** Zigzag encoded variable length integer */
+	Integer = 4,
+	/** Single precision float, used when it represents the number exactly */
+	Float = 5,
+	Double = 6,
+	String = 7,
+	/** Begins an object, followed by identifier + value pairs until End tag */
+	ObjectStart = 8,
+	/** Begins an array, followed by values until End tag */
+	ArrayStart = 9
+};
+
+/** Makes sure strings are interned with case taken into account, unlike default FString map key funcs */
+struct FCaseSensitiveStringMapKeyFuncs : TDefaultMapKeyFuncs<FString, int32, false> {
+	static FORCEINLINE bool Matches(const FString& A, const FString& B) {
+		return A.Equals(B, ESearchCase::CaseSensitive);
+	}
+};
+
+/**
+ * Writes json document model in a compact binary encoding
+ * Layout is the same as the json one, but values are stored as a typed tag stream,
+ * numbers are stored natively as integers when possible, and object keys and short strings
+ * are interned on their first occurrence, so repeated strings are written as a single index afterwards
+ * Writer is streaming, e.g. it does not need the whole document to be available upfront
+ */
+class ASSETDUMPER_API FBinaryJsonWriter {
+private:
+	FArchive& Archive;
+	TMap<FString, int32, FDefaultSetAllocator, FCaseSensitiveStringMapKeyFuncs> InternedStrings;
+public:
+	/** Creates writer for the provided archive and writes the file header */
+	explicit FBinaryJsonWriter(FArchive& Archive);
+
+	void WriteObjectStart();
+	void WriteArrayStart();
+	/** Ends last object or array started */
+	void WriteEnd();
+
+	/** Writes identifier of the next object field, must be followed by the value */
+	void WriteIdentifier(const FString& Identifier);
+
+	void WriteString(const FString& Value);
+	void WriteNumber(double Value);
+	void WriteBool(bool bValue);
+	void WriteValue(const TSharedPtr<FJsonValue>& Value);
+	void WriteObject(const TSharedRef<FJsonObject>& Object);
+private:
+	void WriteTag(EBinaryJsonTag Tag);
+	void WriteVarInt(uint64 Value);
+	void WriteStringReference(const FString& Value);
+};
+
+/** Reads documents written by FBinaryJsonWriter back into the json document model, without text parsing */
+class ASSETDUMPER_API FBinaryJsonReader {
+public:
+	/** Returns true if provided data starts with binary json file header */
+	static bool IsBinaryJsonData(const uint8* Data, int64 DataSize);
+
+	/** Reads root object from the provided binary json data. Returns invalid pointer and sets error message if data is malformed */
+	static TSharedPtr<FJsonObject> ReadObject(const uint8* Data, int64 DataSize, FString* OutErrorMessage = NULL);
+
+	/**
+	 * Attempts to read string field of the root object without reading the whole document
+	 * Fields preceding the requested one are skipped, so this is fast for fields written first, like AssetClass
+	 * Works on truncated data too, in which case it will return false if the field is outside of the data
+	 */
+	static bool ReadRootStringField(const uint8* Data, int64 DataSize, const FString& FieldName, FString& OutValue);
+
+	FORCEINLINE static bool IsBinaryJsonData(const TArray<uint8>& Data) { return IsBinaryJsonData(Data.GetData(), Data.Num()); }
+	FORCEINLINE static TSharedPtr<FJsonObject> ReadObject(const TArray<uint8>& Data, FString* OutErrorMessage = NULL) { return ReadObject(Data.GetData(), Data.Num(), OutErrorMessage); }
+};
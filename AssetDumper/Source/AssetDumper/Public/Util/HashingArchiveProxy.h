@@ -0,0 +1,32 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/ArchiveProxy.h"
+
+/**
+ * Archive proxy computing hash and size of the data written through it
+ * Allows hashing the files we write without reading them back from the disk afterwards
+ */
+class FHashingArchiveProxy : public FArchiveProxy {
+private:
+	FMD5 HashState;
+	int64 BytesWritten;
+public:
+	explicit FHashingArchiveProxy(FArchive& InnerArchive) : FArchiveProxy(InnerArchive), BytesWritten(0) {
+	}
+
+	virtual void Serialize(void* Data, int64 Length) override {
+		InnerArchive.Serialize(Data, Length);
+		HashState.Update((const uint8*) Data, Length);
+		this->BytesWritten += Length;
+	}
+
+	FORCEINLINE int64 GetBytesWritten() const { return BytesWritten; }
+
+	/** Finalizes the hash of the data written. Can only be called once */
+	FORCEINLINE FString FinalizeHash() {
+		FMD5Hash ResultHash;
+		ResultHash.Set(HashState);
+		return LexToString(ResultHash);
+	}
+};
@@ -0,0 +1,114 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+/**
+ * Pretty print policy writing UTF-8 encoded output directly into the archive
+ * Default TCHAR policies would write UTF-16 code units into the file archive,
+ * and ANSI ones truncate non-ASCII characters, so we perform the conversion ourselves
+ * Files written with this policy are readable by FFileHelper::LoadFileToString
+ */
+//Code point written in place of the unpaired surrogates
+#define UNICODE_REPLACEMENT_CODEPOINT 0xFFFD
+
+struct FUtf8PrettyJsonPrintPolicy : public TPrettyJsonPrintPolicy<UTF8CHAR> {
+private:
+	/** High surrogate waiting for the low one, along with the stream it has been written into */
+	struct FPendingSurrogate {
+		FArchive* Stream;
+		uint32 HighSurrogate;
+	};
+	
+	static FORCEINLINE FPendingSurrogate& GetPendingSurrogate() {
+		//Policy methods are static, so pending surrogate is kept per thread and tagged with the stream it belongs to
+		static thread_local FPendingSurrogate PendingSurrogate = {NULL, 0};
+		return PendingSurrogate;
+	}
+public:
+	/** Writes replacement character for the surrogate left pending in the provided stream. Surrogates pending in other streams are dropped */
+	static FORCEINLINE void FlushPendingSurrogate(FArchive* Stream) {
+		FPendingSurrogate& PendingSurrogate = GetPendingSurrogate();
+		if (PendingSurrogate.HighSurrogate != 0 && PendingSurrogate.Stream == Stream) {
+			WriteCodePoint(Stream, UNICODE_REPLACEMENT_CODEPOINT);
+		}
+		PendingSurrogate.Stream = NULL;
+		PendingSurrogate.HighSurrogate = 0;
+	}
+
+	static void WriteChar(FArchive* Stream, TCHAR Char) {
+		//Json writer feeds escaped strings one code unit at a time, so high surrogate has to be kept until the low one arrives,
+		//converting them separately would produce CESU-8 instead of the single 4 byte sequence
+		FPendingSurrogate& PendingSurrogate = GetPendingSurrogate();
+		const uint32 CodeUnit = (uint32) Char;
+
+		if (CodeUnit >= 0xDC00 && CodeUnit <= 0xDFFF && PendingSurrogate.HighSurrogate != 0 && PendingSurrogate.Stream == Stream) {
+			const uint32 HighSurrogate = PendingSurrogate.HighSurrogate;
+			PendingSurrogate.Stream = NULL;
+			PendingSurrogate.HighSurrogate = 0;
+			WriteCodePoint(Stream, 0x10000 + ((HighSurrogate - 0xD800) << 10) + (CodeUnit - 0xDC00));
+			return;
+		}
+		//Unpaired surrogates cannot be represented in UTF-8
+		FlushPendingSurrogate(Stream);
+		
+		if (CodeUnit >= 0xD800 && CodeUnit <= 0xDBFF) {
+			PendingSurrogate.Stream = Stream;
+			PendingSurrogate.HighSurrogate = CodeUnit;
+			return;
+		}
+		if (CodeUnit >= 0xDC00 && CodeUnit <= 0xDFFF) {
+			WriteCodePoint(Stream, UNICODE_REPLACEMENT_CODEPOINT);
+			return;
+		}
+		WriteCodePoint(Stream, CodeUnit);
+	}
+
+	static FORCEINLINE void WriteCodePoint(FArchive* Stream, uint32 CodePoint) {
+		UTF8CHAR Buffer[4];
+		int32 Length;
+
+		if (CodePoint < 0x80) {
+			Buffer[0] = (UTF8CHAR) CodePoint;
+			Length = 1;
+		} else if (CodePoint < 0x800) {
+			Buffer[0] = (UTF8CHAR) (0xC0 | (CodePoint >> 6));
+			Buffer[1] = (UTF8CHAR) (0x80 | (CodePoint & 0x3F));
+			Length = 2;
+		} else if (CodePoint < 0x10000) {
+			Buffer[0] = (UTF8CHAR) (0xE0 | (CodePoint >> 12));
+			Buffer[1] = (UTF8CHAR) (0x80 | ((CodePoint >> 6) & 0x3F));
+			Buffer[2] = (UTF8CHAR) (0x80 | (CodePoint & 0x3F));
+			Length = 3;
+		} else if (CodePoint <= 0x10FFFF) {
+			Buffer[0] = (UTF8CHAR) (0xF0 | (CodePoint >> 18));
+			Buffer[1] = (UTF8CHAR) (0x80 | ((CodePoint >> 12) & 0x3F));
+			Buffer[2] = (UTF8CHAR) (0x80 | ((CodePoint >> 6) & 0x3F));
+			Buffer[3] = (UTF8CHAR) (0x80 | (CodePoint & 0x3F));
+			Length = 4;
+		} else {
+			WriteCodePoint(Stream, UNICODE_REPLACEMENT_CODEPOINT);
+			return;
+		}
+		Stream->Serialize(Buffer, Length * sizeof(UTF8CHAR));
+	}
+
+	static FORCEINLINE void WriteString(FArchive* Stream, const FString& String) {
+		//Escape sequences are written as strings, so surrogate pending before them has to be written first
+		FlushPendingSurrogate(Stream);
+		const FTCHARToUTF8 Converted(*String);
+		Stream->Serialize((void*) Converted.Get(), Converted.Length());
+	}
+};
+
+/** Json writer streaming UTF-8 output into the file archive, as opposed to accumulating it inside of the FString */
+using FJsonFileWriter = TJsonWriter<UTF8CHAR, FUtf8PrettyJsonPrintPolicy>;
+
+/** Creates json file writers, making sure surrogate left pending by the previous writer on this thread does not leak into the new one */
+class FJsonFileWriterFactory {
+public:
+	static FORCEINLINE TSharedRef<FJsonFileWriter> Create(FArchive* const Stream, int32 InitialIndentLevel = 0) {
+		FUtf8PrettyJsonPrintPolicy::FlushPendingSurrogate(NULL);
+		return TJsonWriterFactory<UTF8CHAR, FUtf8PrettyJsonPrintPolicy>::Create(Stream, InitialIndentLevel);
+	}
+};
@@ -0,0 +1,33 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/** Algorithms used for hashing asset payloads, like decompressed texture pixels and font data */
+enum class EPayloadHashAlgorithm : uint8 {
+	/** Used by the dumps written before the algorithm has been recorded, slow but kept so they can still be read */
+	MD5,
+	/** 64-bit CityHash computed over fixed size chunks in parallel, and then over the chunk hashes */
+	CityHash64
+};
+
+/**
+ * Computes hashes of the asset payloads, used by the asset generator to determine whenever existing asset data is up to date
+ * Resulting hash string includes payload size, so payloads of different size never have matching hashes
+ * Algorithm used by the dump is recorded in the asset dump files, so the generator can compute matching hashes
+ */
+class ASSETDUMPER_API FPayloadHasher {
+public:
+	/** Algorithm used for the new asset dumps */
+	static EPayloadHashAlgorithm GetDefaultAlgorithm();
+
+	/** Returns name of the algorithm as written into the asset dump files */
+	static FString GetAlgorithmName(EPayloadHashAlgorithm Algorithm);
+
+	/** Resolves algorithm from the name written into the asset dump file. Returns false if the name is not recognized */
+	static bool FindAlgorithmByName(const FString& AlgorithmName, EPayloadHashAlgorithm& OutAlgorithm);
+
+	/** Computes hash of the provided payload using the specified algorithm. Large payloads are hashed in parallel when algorithm allows it */
+	static FString HashPayload(const uint8* Data, int64 DataSize, EPayloadHashAlgorithm Algorithm);
+
+	FORCEINLINE static FString HashPayload(const TArray64<uint8>& Payload, EPayloadHashAlgorithm Algorithm) { return HashPayload(Payload.GetData(), Payload.Num(), Algorithm); }
+	FORCEINLINE static FString HashPayload(const TArray<uint8>& Payload, EPayloadHashAlgorithm Algorithm) { return HashPayload(Payload.GetData(), Payload.Num(), Algorithm); }
+};
@@ -0,0 +1,75 @@
+#include "Toolkit/AssetGeneration/AssetDumpPrefetcher.h"
+#include "Async/Async.h"
+#include "Toolkit/AssetGeneration/AssetTypeGenerator.h"
+
+//Parsed json object tree occupies many times more memory than the dump file it has been read from, this is a rough upper estimate
+#define PARSED_DUMP_FILE_MEMORY_FACTOR 10
+//Dump file size assumed for the packages not listed in the manifest, until the worker finds out the actual one
+#define UNKNOWN_DUMP_FILE_SIZE_ESTIMATE (256 * 1024)
+
+FPrefetchedAssetDump::FPrefetchedAssetDump() : FileSize(0), ReservedBytes(0) {
+}
+
+FAssetDumpPrefetcher::FAssetDumpPrefetcher(const FString& DumpRootDirectory, const int64 MaxPrefetchedBytes) {
+	this->DumpRootDirectory = DumpRootDirectory;
+	this->MaxPrefetchedBytes = MaxPrefetchedBytes;
+}
+
+FAssetDumpPrefetcher::~FAssetDumpPrefetcher() {
+	//Workers reference this prefetcher, so they have to finish before it goes away
+	for (TPair<FName, TFuture<FPrefetchedAssetDump>>& Pair : PendingDumps) {
+		Pair.Value.Wait();
+	}
+}
+
+bool FAssetDumpPrefetcher::CanPrefetchMore() const {
+	return ReservedBytes.GetValue() < MaxPrefetchedBytes;
+}
+
+void FAssetDumpPrefetcher::RequestPrefetch(const FName PackageName, const FString& AssetDumpFilePath, const int64 DumpFileSize) {
+	if (PendingDumps.Contains(PackageName)) {
+		return;
+	}
+
+	//Memory is reserved right away, so requests made before workers start reading the files are accounted for too
+	const int64 InitialReservedBytes = (DumpFileSize > 0 ? DumpFileSize : UNKNOWN_DUMP_FILE_SIZE_ESTIMATE) * PARSED_DUMP_FILE_MEMORY_FACTOR;
+	ReservedBytes.Add(InitialReservedBytes);
+
+	TFuture<FPrefetchedAssetDump> Future = Async(EAsyncExecution::ThreadPool, [this, PackageName, AssetDumpFilePath, InitialReservedBytes]() {
+		FPrefetchedAssetDump PrefetchedDump;
+		PrefetchedDump.ReservedBytes = InitialReservedBytes;
+		PrefetchedDump.AssetDumpFilePath = AssetDumpFilePath.IsEmpty() ? UAssetTypeGenerator::GetAssetFilePath(DumpRootDirectory, PackageName) : AssetDumpFilePath;
+
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		if (!PlatformFile.FileExists(*PrefetchedDump.AssetDumpFilePath)) {
+			return PrefetchedDump;
+		}
+
+		//Correct the reservation now that the actual file size is known
+		PrefetchedDump.FileSize = PlatformFile.FileSize(*PrefetchedDump.AssetDumpFilePath);
+		const int64 ActualReservedBytes = FMath::Max(PrefetchedDump.FileSize, (int64) 0) * PARSED_DUMP_FILE_MEMORY_FACTOR;
+		ReservedBytes.Add(ActualReservedBytes - PrefetchedDump.ReservedBytes);
+		PrefetchedDump.ReservedBytes = ActualReservedBytes;
+		PrefetchedDump.RootFileObject = UAssetTypeGenerator::LoadAssetDumpFile(PrefetchedDump.AssetDumpFilePath);
+		return PrefetchedDump;
+	});
+	this->PendingDumps.Add(PackageName, MoveTemp(Future));
+}
+
+bool FAssetDumpPrefetcher::ConsumePrefetchedDump(const FName PackageName, FPrefetchedAssetDump& OutPrefetchedDump) {
+	TFuture<FPrefetchedAssetDump>* Future = PendingDumps.Find(PackageName);
+	if (Future == NULL) {
+		return false;
+	}
+
+	//Package is needed right now, so wait for the worker to finish reading it instead of reading it second time
+	OutPrefetchedDump = Future->Get();
+	ReservedBytes.Subtract(OutPrefetchedDump.ReservedBytes);
+	this->PendingDumps.Remove(PackageName);
+	return true;
+}
+
+void FAssetDumpPrefetcher::DiscardPrefetchedDump(const FName PackageName) {
+	FPrefetchedAssetDump DiscardedDump;
+	ConsumePrefetchedDump(PackageName, DiscardedDump);
+}
@@ -1,6 +1,9 @@
 #include "Toolkit/AssetGeneration/AssetDumpViewWidget.h"
 #include "PackageTools.h"
 #include "Toolkit/AssetGeneration/AssetTypeGenerator.h"
+#include "Util/BinaryJsonSerializer.h"
+#include "Toolkit/AssetDumping/AssetDumpManifest.h"
+#include "Toolkit/AssetDumping/AssetDumpBlobStore.h"
 
 #define LOCTEXT_NAMESPACE "AssetGenerator"
 
@@ -36,6 +39,7 @@ TSharedPtr<FAssetDumpTreeNode> FAssetDumpTreeNode::MakeChildNode() {
 	TSharedRef<FAssetDumpTreeNode> NewNode = MakeShareable(new FAssetDumpTreeNode());
 	NewNode->ParentNode = SharedThis(this);
 	NewNode->RootDirectory = RootDirectory;
+	NewNode->DumpManifest = DumpManifest;
 	NewNode->bIsChecked = bIsChecked;
 	
 	Children.Add(NewNode);
@@ -46,6 +50,34 @@ FString FAssetDumpTreeNode::ComputeAssetClass() {
 	if (!bIsLeafNode) {
 		return TEXT("");
 	}
+
+	//Asset class is recorded in the manifest, so we do not need to open the file at all
+	if (DumpManifest.IsValid()) {
+		const FAssetDumpManifestEntry* ManifestEntry = DumpManifest->FindEntry(*PackageName);
+		if (ManifestEntry != NULL) {
+			return ManifestEntry->AssetClass.ToString();
+		}
+	}
+	
+	//Binary dump files always have AssetClass as the first field, so we can retrieve it without reading the whole file
+	if (FPaths::GetExtension(DiskPackagePath) == BINARY_JSON_FILE_EXTENSION) {
+		TArray<uint8> FileHeaderData;
+		const TUniquePtr<FArchive> FileReader(IFileManager::Get().CreateFileReader(*DiskPackagePath));
+		
+		if (FileReader.IsValid()) {
+			FileHeaderData.AddUninitialized(FMath::Min(FileReader->TotalSize(), (int64) 1024));
+			FileReader->Serialize(FileHeaderData.GetData(), FileHeaderData.Num());
+		}
+
+		FString ResultAssetClass;
+		if (FBinaryJsonReader::ReadRootStringField(FileHeaderData.GetData(), FileHeaderData.Num(), TEXT("AssetClass"), ResultAssetClass)) {
+			return ResultAssetClass;
+		}
+		
+		//Fallback to reading the whole dump file
+		const TSharedPtr<FJsonObject> RootFileObject = UAssetTypeGenerator::LoadAssetDumpFile(DiskPackagePath);
+		return RootFileObject.IsValid() ? RootFileObject->GetStringField(TEXT("AssetClass")) : TEXT("Unknown");
+	}
 	
 	FString FileContentsString;
 	if (!FFileHelper::LoadFileToString(FileContentsString, *DiskPackagePath)) {
@@ -73,7 +105,7 @@ FString FAssetDumpTreeNode::ComputeAssetClass() {
 }
 
 void FAssetDumpTreeNode::SetupPackageNameFromDiskPath() {
-	//Remove extension from the file path (all asset dump files are json files)
+	//Remove extension from the file path (asset dump files are either json or binary json files)
 	FString PackageNameNew = FPaths::ChangeExtension(DiskPackagePath, TEXT(""));
 	
 	//Make path relative to root directory (e.g D:\ProjectRoot\DumpRoot\Game\FactoryGame\Asset -> Game\FactoryGame\Asset)
@@ -105,20 +137,41 @@ void FAssetDumpTreeNode::RegenerateChildren() {
 	if (bIsLeafNode) {
 		return;
 	}
+	if (DumpManifest.IsValid()) {
+		RegenerateChildrenFromManifest();
+		return;
+	}
 	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
 	TArray<FString> ChildDirectoryNames;
 	TArray<FString> ChildFilenames;
 	
+	TSet<FString> BinaryDumpFilenames;
+	const FString BlobDirectoryPath = FPaths::Combine(RootDirectory, ASSET_DUMP_BLOB_DIRECTORY_NAME);
+	
 	PlatformFile.IterateDirectory(*DiskPackagePath, [&](const TCHAR* FilenameOrDirectory, bool bIsDirectory) {
 		if (bIsDirectory) {
+			//Blob store only contains side files referenced by the packages
+			if (FPaths::IsSamePath(FilenameOrDirectory, BlobDirectoryPath)) {
+				return true;
+			}
 			ChildDirectoryNames.Add(FilenameOrDirectory);
 		//TODO this should really use a better filtering mechanism than checking file extension, or maybe we could use some custom extension like .uassetdump
 		} else if (FPaths::GetExtension(FilenameOrDirectory) == TEXT("json")) {
 			ChildFilenames.Add(FilenameOrDirectory);
+		} else if (FPaths::GetExtension(FilenameOrDirectory) == BINARY_JSON_FILE_EXTENSION) {
+			ChildFilenames.Add(FilenameOrDirectory);
+			BinaryDumpFilenames.Add(FPaths::ChangeExtension(FilenameOrDirectory, TEXT("")));
 		}
 		return true;
 	});
 
+	//When package has been dumped in both formats, only keep binary file, same as UAssetTypeGenerator::GetAssetFilePath does
+	if (BinaryDumpFilenames.Num()) {
+		ChildFilenames.RemoveAll([&](const FString& Filename) {
+			return FPaths::GetExtension(Filename) == TEXT("json") && BinaryDumpFilenames.Contains(FPaths::ChangeExtension(Filename, TEXT("")));
+		});
+	}
+
 	//Append child directory nodes first, even if they are empty
 	for (const FString& ChildDirectoryName : ChildDirectoryNames) {
 		const TSharedPtr<FAssetDumpTreeNode> ChildNode = MakeChildNode();
@@ -136,6 +189,34 @@ void FAssetDumpTreeNode::RegenerateChildren() {
 	}
 }
 
+void FAssetDumpTreeNode::RegenerateChildrenFromManifest() {
+	//Root node represents the root package path
+	const FString ManifestPackagePath = DiskPackagePath == RootDirectory ? TEXT("/") : PackageName;
+	TArray<FString> ChildPackagePaths;
+	TArray<FName> ChildPackageNames;
+	DumpManifest->GetPathContents(ManifestPackagePath, ChildPackagePaths, ChildPackageNames);
+	ChildPackagePaths.Sort();
+
+	for (const FString& ChildPackagePath : ChildPackagePaths) {
+		const TSharedPtr<FAssetDumpTreeNode> ChildNode = MakeChildNode();
+		ChildNode->bIsLeafNode = false;
+		ChildNode->DiskPackagePath = FPaths::Combine(RootDirectory, ChildPackagePath.Mid(1));
+		ChildNode->PackageName = ChildPackagePath;
+		ChildNode->NodeName = FPackageName::GetShortName(ChildPackagePath);
+	}
+
+	for (const FName& ChildPackageName : ChildPackageNames) {
+		const FAssetDumpManifestEntry& ManifestEntry = *DumpManifest->FindEntry(ChildPackageName);
+		const TSharedPtr<FAssetDumpTreeNode> ChildNode = MakeChildNode();
+		ChildNode->bIsLeafNode = true;
+		ChildNode->DiskPackagePath = FAssetDumpManifest::GetDumpFilePath(RootDirectory, ManifestEntry);
+		ChildNode->PackageName = ChildPackageName.ToString();
+		ChildNode->NodeName = FPackageName::GetShortName(ChildPackageName);
+		ChildNode->AssetClass = ManifestEntry.AssetClass.ToString();
+		ChildNode->bAssetClassComputed = true;
+	}
+}
+
 void FAssetDumpTreeNode::GetChildrenNodes(TArray<TSharedPtr<FAssetDumpTreeNode>>& OutChildrenNodes) {
 	if (!bChildrenNodesInitialized) {
 		this->bChildrenNodesInitialized = true;
@@ -202,6 +283,7 @@ TSharedPtr<FAssetDumpTreeNode> FAssetDumpTreeNode::CreateRootTreeNode(const FStr
 	
 	RootNode->bIsLeafNode = false;
 	RootNode->RootDirectory = DumpDirectory;
+	RootNode->DumpManifest = FAssetDumpManifest::LoadFromDirectory(DumpDirectory);
 	RootNode->DiskPackagePath = RootNode->RootDirectory;
 	RootNode->SetupPackageNameFromDiskPath();
 	RootNode->UpdateSelectedState(true, false);
@@ -2,6 +2,10 @@
 #include "Framework/Notifications/NotificationManager.h"
 #include "Widgets/Notifications/SNotificationList.h"
 #include "UObject/UObjectBaseUtility.h"
+#include "Toolkit/AssetDumping/AssetDumpManifest.h"
+#include "HAL/FileManager.h"
+#include "Util/JsonFileWriter.h"
+#include "ShaderCompiler.h"
 
 #define LOCTEXT_NAMESPACE "AssetGenerator"
 
@@ -27,9 +31,8 @@ void FAssetGenerationProcessor::RefreshGeneratorDependencies(UAssetTypeGenerator
 		}
 	}
 
-	//Create shared dependency list and collect all dependencies
-	TSharedRef<FDependencyList> DependencyList = MakeShareable(new FDependencyList());
-	DependencyList->AssetTypeGenerator = Generator;
+	//Collect dependencies on the stages of generated packages that have not been completed yet
+	TMap<FName, EAssetGenerationStage> WaitingDependencies;
 	
 	for (const TPair<FName, EAssetGenerationStage>& AssetDependency : CompactedFlatDependencies) {
 		const FName DependencyPackageName = AssetDependency.Key;
@@ -43,8 +46,7 @@ void FAssetGenerationProcessor::RefreshGeneratorDependencies(UAssetTypeGenerator
 			//We only want to add dependency if required stage index is higher or equal to current stage index,
 			//e.g when we are waiting for the dependency stage advance to happen
 			if (DependencyStageIndex >= CurrentStageIndex) {
-				DependencyList->PackageDependencies.Add(AssetDependency.Key, AssetDependency.Value);
-				PendingDependencies.FindOrAdd(DependencyPackageName).Add(DependencyList);
+				WaitingDependencies.Add(AssetDependency.Key, AssetDependency.Value);
 
 				//Log verbose information about the dependency for easier debugging
 				UE_LOG(LogAssetGenerator, VeryVerbose, TEXT("Package %s depends on generated package %s (required Stage: %d, Current: %d)"),
@@ -59,8 +61,7 @@ void FAssetGenerationProcessor::RefreshGeneratorDependencies(UAssetTypeGenerator
 
 		//Only add dependency if package is going to be generated. We never wait for external packages.
 		if (AddPackageResult == EAddPackageResult::PACKAGE_WILL_BE_GENERATED) {
-			DependencyList->PackageDependencies.Add(AssetDependency.Key, AssetDependency.Value);
-			PendingDependencies.FindOrAdd(DependencyPackageName).Add(DependencyList);
+			WaitingDependencies.Add(AssetDependency.Key, AssetDependency.Value);
 
 			//Log verbose information about the dependency for easier debugging
 			UE_LOG(LogAssetGenerator, VeryVerbose, TEXT("Package %s depends on generated package %s (required Stage: %d)"),
@@ -73,12 +74,9 @@ void FAssetGenerationProcessor::RefreshGeneratorDependencies(UAssetTypeGenerator
 		}
 	}
 
-	//If we have no pending asset generator dependencies, add ourselves to the advance list instantly
+	//If we have no pending asset generator dependencies, scheduler will queue us for advancing instantly
 	//Otherwise we are waiting on dependencies to advance pretty much, nothing else to do here
-	if (DependencyList->PackageDependencies.Num() == 0) {
-		UE_LOG(LogAssetGenerator, VeryVerbose, TEXT("Dependencies satisfied for package %s (instantly)"), *PackageName.ToString());
-		this->GeneratorsReadyToAdvance.Add(Generator);
-	}
+	Scheduler.ScheduleGeneratorStage(Generator, WaitingDependencies);
 }
 
 void FAssetGenerationProcessor::OnGeneratorStageAdvanced(UAssetTypeGenerator* Generator) {
@@ -86,34 +84,9 @@ void FAssetGenerationProcessor::OnGeneratorStageAdvanced(UAssetTypeGenerator* Ge
 	const int32 CurrentStageIndex = (int32) Generator->GetCurrentStage();
 	UE_LOG(LogAssetGenerator, Verbose, TEXT("Asset generation advanced to stage %d for asset %s"), CurrentStageIndex, *PackageName.ToString());
 
-	//Notify all dependents that we have advanced by one state
-	TArray<TSharedPtr<FDependencyList>>* Dependents = PendingDependencies.Find(PackageName);
-	if (Dependents) {
-		for (int32 i = Dependents->Num() - 1; i >= 0; i--) {
-			const TSharedPtr<FDependencyList> DependencyList = (*Dependents)[i];
-			const FName DependentPackageName = DependencyList->AssetTypeGenerator->GetPackageName();
-			const int32 DependencyStageIndex = (int32) DependencyList->PackageDependencies.FindChecked(PackageName);
-			
-			if (CurrentStageIndex > DependencyStageIndex) {
-				DependencyList->PackageDependencies.Remove(PackageName);
-				(*Dependents).RemoveAt(i);
-				
-				UE_LOG(LogAssetGenerator, VeryVerbose, TEXT("Dependent package %s has satisfied dependency on %s (dependencies remaining: %d)"),
-					*DependentPackageName.ToString(), *PackageName.ToString(), DependencyList->PackageDependencies.Num());
-
-				//Advance dependent generator state if all dependencies have been satisfied
-				if (DependencyList->PackageDependencies.Num() == 0) {
-					UE_LOG(LogAssetGenerator, VeryVerbose, TEXT("Dependencies satisfied for package %s"), *DependentPackageName.ToString());
-					this->GeneratorsReadyToAdvance.Add(DependencyList->AssetTypeGenerator);
-				}
-			}
-		}
-
-		//Remove dependent entries if all dependents are finished now
-		if (Dependents->Num() == 0) {
-			this->PendingDependencies.Remove(PackageName);
-		}
-	}
+	//Notify all dependents that we have completed the previous stage
+	const EAssetGenerationStage CompletedStage = (EAssetGenerationStage) (CurrentStageIndex - 1);
+	Scheduler.OnGeneratorStageCompleted(Generator, CompletedStage);
 
 	//Schedule next stage for the current generator if we're not finished
 	if (Generator->GetCurrentStage() != EAssetGenerationStage::FINISHED) {
@@ -127,9 +100,15 @@ void FAssetGenerationProcessor::OnGeneratorStageAdvanced(UAssetTypeGenerator* Ge
 FAssetGeneratorConfiguration::FAssetGeneratorConfiguration() :
 		DumpRootDirectory(FPaths::ProjectDir() + TEXT("AssetDump/")),
 		MaxAssetsToAdvancePerTick(4),
+		MaxTickTimeSeconds(0.05f),
+		MaxPrefetchedDumpFiles(32),
+		MaxPrefetchedDumpBytes(512 * 1024 * 1024),
+		MaxPackagesPerSaveBatch(32),
 		bRefreshExistingAssets(true),
 		bGeneratePublicProject(false),
-		bTickOnTheSide(false) {
+		bTickOnTheSide(false),
+		DependencyCyclePolicy(EDependencyCyclePolicy::FATAL),
+		DependencyCycleReportPath(FPaths::ProjectSavedDir() + TEXT("AssetGenerator/DependencyCycles.json")) {
 }
 
 FAssetGenStatistics::FAssetGenStatistics() {
@@ -173,10 +152,10 @@ bool FAssetGenerationProcessor::ShouldSkipPackage(UAssetTypeGenerator* PackageGe
 
 void FAssetGenerationProcessor::CleanupAssetGenerator(UAssetTypeGenerator* Generator) {
 	//Make sure nobody is waiting for us
-	if (!ensureAlways(this->PendingDependencies.Find(Generator->GetPackageName()) == NULL)) {
+	if (!ensureAlways(!Scheduler.HasWaitingDependents(Generator->GetPackageName()))) {
 		PrintStateIntoTheLog();
-		this->PendingDependencies.Remove(Generator->GetPackageName());
 	}
+	Scheduler.RemovePackage(Generator->GetPackageName());
 	
 	UE_LOG(LogAssetGenerator, Log, TEXT("Finished asset generation: %s"), *Generator->GetPackageName().ToString());
 	
@@ -184,6 +163,9 @@ void FAssetGenerationProcessor::CleanupAssetGenerator(UAssetTypeGenerator* Gener
 	this->AssetGenerators.Remove(Generator->GetPackageName());
 	this->AlreadyGeneratedPackages.Add(Generator->GetPackageName());
 
+	//Hand changed packages over to the save coordinator, generator is not going to touch them anymore
+	QueueChangedPackagesForSaving(Generator);
+
 	//Add asset generator into our statistics
 	TrackAssetGeneratorStatistics(Generator);
 	
@@ -191,6 +173,18 @@ void FAssetGenerationProcessor::CleanupAssetGenerator(UAssetTypeGenerator* Gener
 	Generator->RemoveFromRoot();
 }
 
+void FAssetGenerationProcessor::QueueChangedPackagesForSaving(UAssetTypeGenerator* Generator) {
+	for (UPackage* Package : Generator->GetPackagesPendingSave()) {
+		//Package that is still being generated, e.g skeleton changed by the mesh, is saved once it's own generator is finished
+		UAssetTypeGenerator** OwnerGenerator = AssetGenerators.Find(Package->GetFName());
+		if (OwnerGenerator != NULL) {
+			(*OwnerGenerator)->AddPackagePendingSave(Package);
+			continue;
+		}
+		PackageSaveCoordinator->QueuePackage(Package);
+	}
+}
+
 EAddPackageResult FAssetGenerationProcessor::AddPackage(const FName PackageName) {
 	//Return PACKAGE_EXISTS if we have already processed this package before
 	if (ExternalPackagesResolved.Contains(PackageName) || AlreadyGeneratedPackages.Contains(PackageName)) {
@@ -206,8 +200,22 @@ EAddPackageResult FAssetGenerationProcessor::AddPackage(const FName PackageName)
 		return EAddPackageResult::PACKAGE_WILL_BE_GENERATED;
 	}
 	
-	//First, try to extract package from the dump
-	UAssetTypeGenerator* AssetTypeGenerator = UAssetTypeGenerator::InitializeFromFile(Configuration.DumpRootDirectory, PackageName, Configuration.bGeneratePublicProject);
+	//First, try to extract package from the dump, using dump file prefetched by the worker threads if there is one,
+	//and dump file path from the manifest when package is listed there
+	const FAssetDumpManifestEntry* ManifestEntry = DumpManifest.IsValid() ? DumpManifest->FindEntry(PackageName) : NULL;
+	UAssetTypeGenerator* AssetTypeGenerator = NULL;
+	FPrefetchedAssetDump PrefetchedDump;
+	
+	if (DumpPrefetcher->ConsumePrefetchedDump(PackageName, PrefetchedDump)) {
+		if (PrefetchedDump.RootFileObject.IsValid()) {
+			AssetTypeGenerator = UAssetTypeGenerator::InitializeFromJson(Configuration.DumpRootDirectory, PackageName, PrefetchedDump.AssetDumpFilePath, PrefetchedDump.RootFileObject, Configuration.bGeneratePublicProject);
+		}
+	} else if (ManifestEntry != NULL) {
+		const FString AssetDumpFilePath = FAssetDumpManifest::GetDumpFilePath(Configuration.DumpRootDirectory, *ManifestEntry);
+		AssetTypeGenerator = UAssetTypeGenerator::InitializeFromFile(Configuration.DumpRootDirectory, PackageName, AssetDumpFilePath, Configuration.bGeneratePublicProject);
+	} else {
+		AssetTypeGenerator = UAssetTypeGenerator::InitializeFromFile(Configuration.DumpRootDirectory, PackageName, Configuration.bGeneratePublicProject);
+	}
 	if (AssetTypeGenerator != NULL) {
 		FString OutSkipReason;
 		//Skip the package if it's not whitelisted by the configuration
@@ -235,6 +243,23 @@ EAddPackageResult FAssetGenerationProcessor::AddPackage(const FName PackageName)
 	return EAddPackageResult::PACKAGE_NOT_FOUND;
 }
 
+void FAssetGenerationProcessor::PrefetchUpcomingAssetDumps() {
+	this->NextPackageToPrefetchIndex = FMath::Max(NextPackageToPrefetchIndex, NextPackageToGenerateIndex);
+
+	while (PackagesToGenerate.IsValidIndex(NextPackageToPrefetchIndex) &&
+		NextPackageToPrefetchIndex - NextPackageToGenerateIndex < Configuration.MaxPrefetchedDumpFiles && DumpPrefetcher->CanPrefetchMore()) {
+		const FName PackageName = PackagesToGenerate[NextPackageToPrefetchIndex++];
+
+		//Packages pulled in as dependencies earlier have already been read
+		if (AlreadyGeneratedPackages.Contains(PackageName) || AssetGenerators.Contains(PackageName)) {
+			continue;
+		}
+		const FAssetDumpManifestEntry* ManifestEntry = DumpManifest.IsValid() ? DumpManifest->FindEntry(PackageName) : NULL;
+		const FString AssetDumpFilePath = ManifestEntry != NULL ? FAssetDumpManifest::GetDumpFilePath(Configuration.DumpRootDirectory, *ManifestEntry) : FString();
+		DumpPrefetcher->RequestPrefetch(PackageName, AssetDumpFilePath, ManifestEntry != NULL ? ManifestEntry->DumpFileSize : 0);
+	}
+}
+
 bool FAssetGenerationProcessor::GatherNewAssetsForGeneration() {
 	const int32 MaxAssetsToGatherThisTick = Configuration.MaxAssetsToAdvancePerTick * 2;
 	int32 AssetsAddedThisTick = 0;
@@ -243,10 +268,13 @@ bool FAssetGenerationProcessor::GatherNewAssetsForGeneration() {
 
 		//Skip package if it has been generated already before
 		if (AlreadyGeneratedPackages.Contains(PackageToGenerate)) {
+			DumpPrefetcher->DiscardPrefetchedDump(PackageToGenerate);
 			continue;
 		}
 
 		const EAddPackageResult Result = AddPackage(PackageToGenerate);
+		//Make sure prefetched dump does not linger around if package has not been generated from it
+		DumpPrefetcher->DiscardPrefetchedDump(PackageToGenerate);
 
 		//If asset is skipped, continue and try to add the other one
 		if (SkippedPackages.Contains(PackageToGenerate)) {
@@ -268,12 +296,13 @@ bool FAssetGenerationProcessor::GatherNewAssetsForGeneration() {
 
 void FAssetGenerationProcessor::TickAssetGeneration(int32& PackagesGeneratedThisTick) {
 	//If we have nothing to advance, but have asset generators waiting, we are definitely in a cyclic dependencies loop
-	//Log our full state for debugging purposes and crash
-	if (GeneratorsReadyToAdvance.Num() == 0 && AssetGenerators.Num() != 0) {
-		PrintStateIntoTheLog();
-		UE_LOG(LogAssetGenerator, Fatal, TEXT("Cyclic dependencies were encountered during asset generation"));
+	if (Scheduler.GetNumReadyGenerators() == 0 && AssetGenerators.Num() != 0) {
+		HandleDependencyCycles();
 	}
 
+	//Keep worker threads busy reading dump files while we are advancing the generators
+	PrefetchUpcomingAssetDumps();
+
 	//If asset generators are empty, try to gather some new assets for generation
 	if (AssetGenerators.Num() == 0) {
 		if (!GatherNewAssetsForGeneration()) {
@@ -283,30 +312,129 @@ void FAssetGenerationProcessor::TickAssetGeneration(int32& PackagesGeneratedThis
 		}
 	}
 
-	int32 MaxGeneratorsToAdvance = Configuration.MaxAssetsToAdvancePerTick;
+	const double TickStartTime = FPlatformTime::Seconds();
+	int32 MinGeneratorsToAdvance = Configuration.MaxAssetsToAdvancePerTick;
 	int32 GeneratorsActuallyProcessed = 0;
-	
-	for (int32 i = 0; i < FMath::Min(GeneratorsReadyToAdvance.Num(), MaxGeneratorsToAdvance); i++) {
-		UAssetTypeGenerator* Generator = GeneratorsReadyToAdvance[i];
-		UE_LOG(LogAssetGenerator, VeryVerbose, TEXT("Advancing asset generator %s at index %d"), *Generator->GetPackageName().ToString(), i);
+
+	//Advance at least the configured amount of generators, and then keep going while there is time left in this tick,
+	//so we never sit idle with generators ready. Generators that become ready while advancing are picked up in the same tick
+	while (Scheduler.GetNumReadyGenerators() > 0) {
+		if (GeneratorsActuallyProcessed >= MinGeneratorsToAdvance && FPlatformTime::Seconds() - TickStartTime >= Configuration.MaxTickTimeSeconds) {
+			break;
+		}
+		UAssetTypeGenerator* Generator = Scheduler.DequeueReadyGenerator();
+		UE_LOG(LogAssetGenerator, VeryVerbose, TEXT("Advancing asset generator %s at index %d"), *Generator->GetPackageName().ToString(), GeneratorsActuallyProcessed);
 
 		const FGeneratorStateAdvanceResult& AdvanceResult = Generator->AdvanceGenerationState();
 		OnGeneratorStageAdvanced(Generator);
 
 		//Try to compensate for generation stage not being utilized by advancing more generators this tick
 		if (AdvanceResult.bPreviousStageNotImplemented) {
-			MaxGeneratorsToAdvance++;
+			MinGeneratorsToAdvance++;
 		}
 		GeneratorsActuallyProcessed++;
 	}
-	//Remove generators that we have already advanced
-	GeneratorsReadyToAdvance.RemoveAt(0, GeneratorsActuallyProcessed);
 	PackagesGeneratedThisTick = GeneratorsActuallyProcessed;
 
+	//Write changed packages once there is enough of them to make a batch
+	if (PackageSaveCoordinator->ShouldFlush()) {
+		PackageSaveCoordinator->Flush(false);
+	}
+
 	//Update notification item if it's visible
 	UpdateNotificationItem();
 }
 
+void FAssetGenerationProcessor::HandleDependencyCycles() {
+	//Log our full state for debugging purposes first
+	PrintStateIntoTheLog();
+
+	//Only one cycle is extracted per strongly connected component, and component can contain multiple cycles,
+	//so keep breaking cycles until some generator is ready, or none of the remaining cycles can be broken
+	const bool bRelaxDependencies = Configuration.DependencyCyclePolicy == EDependencyCyclePolicy::RELAX_WEAKEST_DEPENDENCY;
+	bool bFoundAnyCycles = false;
+	
+	while (true) {
+		TArray<FAssetGenerationCycle> NewCycles;
+		Scheduler.FindDependencyCycles(NewCycles);
+		bFoundAnyCycles |= NewCycles.Num() > 0;
+		bool bRelaxedAnyDependency = false;
+
+		for (FAssetGenerationCycle& Cycle : NewCycles) {
+			FString CycleDescription;
+			for (const FAssetGenerationCycleEntry& Entry : Cycle.Entries) {
+				CycleDescription.Append(FString::Printf(TEXT("%s (Stage: %d) -> "), *Entry.PackageName.ToString(), Entry.Stage));
+			}
+			CycleDescription.Append(FString::Printf(TEXT("%s (Stage: %d)"), *Cycle.Entries[0].PackageName.ToString(), Cycle.Entries[0].Stage));
+			UE_LOG(LogAssetGenerator, Error, TEXT("Dependency cycle between %d package stages: %s"), Cycle.ComponentSize, *CycleDescription);
+
+			if (bRelaxDependencies && Scheduler.RelaxWeakestDependency(Cycle)) {
+				const FAssetGenerationCycleEntry& Dependent = Cycle.Entries[Cycle.RelaxedEntryIndex];
+				const FAssetGenerationCycleEntry& Dependency = Cycle.Entries[(Cycle.RelaxedEntryIndex + 1) % Cycle.Entries.Num()];
+
+				UE_LOG(LogAssetGenerator, Warning, TEXT("Dropped dependency of %s (Stage: %d) on %s (Stage: %d) to break the cycle. Resulting data might be incorrect or partially missing!"),
+					*Dependent.PackageName.ToString(), Dependent.Stage, *Dependency.PackageName.ToString(), Dependency.Stage);
+				bRelaxedAnyDependency = true;
+			}
+		}
+		this->DependencyCycles.Append(NewCycles);
+
+		if (!bRelaxedAnyDependency || Scheduler.GetNumReadyGenerators() != 0) {
+			break;
+		}
+	}
+
+	if (!bFoundAnyCycles) {
+		UE_LOG(LogAssetGenerator, Fatal, TEXT("Asset generators are waiting for package stages that will never be completed, but no dependency cycles were found"));
+		return;
+	}
+	WriteDependencyCycleReport();
+
+	if (Scheduler.GetNumReadyGenerators() == 0) {
+		UE_LOG(LogAssetGenerator, Fatal, TEXT("Cyclic dependencies were encountered during asset generation, see %s for details"), *Configuration.DependencyCycleReportPath);
+	}
+}
+
+void FAssetGenerationProcessor::WriteDependencyCycleReport() const {
+	const TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*Configuration.DependencyCycleReportPath));
+	if (!FileWriter.IsValid()) {
+		UE_LOG(LogAssetGenerator, Error, TEXT("Failed to open dependency cycle report %s for writing"), *Configuration.DependencyCycleReportPath);
+		return;
+	}
+
+	const TSharedRef<FJsonFileWriter> Writer = FJsonFileWriterFactory::Create(FileWriter.Get());
+	Writer->WriteObjectStart();
+	Writer->WriteArrayStart(TEXT("Cycles"));
+
+	for (const FAssetGenerationCycle& Cycle : DependencyCycles) {
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("ComponentSize"), Cycle.ComponentSize);
+		Writer->WriteArrayStart(TEXT("Stages"));
+
+		for (int32 i = 0; i < Cycle.Entries.Num(); i++) {
+			const FAssetGenerationCycleEntry& Entry = Cycle.Entries[i];
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("PackageName"), Entry.PackageName.ToString());
+			Writer->WriteValue(TEXT("Stage"), (int32) Entry.Stage);
+			Writer->WriteValue(TEXT("WaitsForOwnGenerator"), Entry.bWaitsForOwnGenerator);
+			Writer->WriteValue(TEXT("DependencyRelaxed"), i == Cycle.RelaxedEntryIndex);
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+		Writer->WriteObjectEnd();
+	}
+
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	if (!FileWriter->Close()) {
+		UE_LOG(LogAssetGenerator, Error, TEXT("Failed to write dependency cycle report %s"), *Configuration.DependencyCycleReportPath);
+		return;
+	}
+	UE_LOG(LogAssetGenerator, Display, TEXT("Written %d dependency cycles to %s"), DependencyCycles.Num(), *Configuration.DependencyCycleReportPath);
+}
+
 void FAssetGenerationProcessor::OnAssetGenerationStarted() {
 	UE_LOG(LogAssetGenerator, Log, TEXT("Starting asset generator for generating %d assets..."), PackagesToGenerate.Num());
 	UE_LOG(LogAssetGenerator, Log, TEXT("To view advanced information about asset generation process in the log, set LogAssetGenerator verbosity to VeryVerbose/Verbose"));
@@ -329,9 +457,28 @@ void FAssetGenerationProcessor::OnAssetGenerationStarted() {
 
 void FAssetGenerationProcessor::OnAssetGenerationFinished() {
 	this->bGenerationFinished = true;
+	//When ticked by the commandlet, packages with materials still compiling are saved by it as their shaders get ready
+	PackageSaveCoordinator->Flush(!Configuration.bTickOnTheSide);
+	
 	UE_LOG(LogAssetGenerator, Log, TEXT("Asset generation finished successfully, %d packages generated, %d packages refreshed, %d up-to-date"),
 		Statistics.AssetPackagesCreated, Statistics.AssetPackagesRefreshed, Statistics.AssetPackagesUpToDate);
 
+	const FAssetGenerationGraphStatistics& GraphStatistics = Scheduler.GetStatistics();
+	UE_LOG(LogAssetGenerator, Log, TEXT("Generation graph: %d package stages, %d stage dependencies, at most %d stages ready at once, longest chain of %d stages ending at %s"),
+		GraphStatistics.TotalNodes, GraphStatistics.TotalEdges, GraphStatistics.MaxReadyNodes, GraphStatistics.LongestChain, *GraphStatistics.LongestChainPackage.ToString());
+
+	//Commandlet keeps saving packages after generation is finished, so it reports the totals itself once it is done
+	if (!Configuration.bTickOnTheSide) {
+		const FAssetPackageSaveStatistics& SaveStatistics = PackageSaveCoordinator->GetStatistics();
+		UE_LOG(LogAssetGenerator, Log, TEXT("Saved %d packages in %d batches, %d packages had to be saved again, %.2f MB written"),
+			SaveStatistics.PackagesSaved, SaveStatistics.SaveBatches, SaveStatistics.PackagesResaved, SaveStatistics.BytesWritten / (1024.0 * 1024.0));
+	}
+
+	if (DependencyCycles.Num()) {
+		UE_LOG(LogAssetGenerator, Warning, TEXT("%d dependency cycles were broken by dropping %d dependencies, see %s for details"),
+			DependencyCycles.Num(), GraphStatistics.RelaxedDependencies, *Configuration.DependencyCycleReportPath);
+	}
+
 	if (NotificationItem.IsValid()) {
 		FFormatNamedArguments Arguments;
 		Arguments.Add(TEXT("TotalAssets"), Statistics.TotalAssetPackages);
@@ -354,7 +501,11 @@ void FAssetGenerationProcessor::UpdateNotificationItem() {
 	const int32 PackagesGenerated = Statistics.GetTotalPackagesHandled();
 	const int32 TotalPackages = Statistics.TotalAssetPackages;
 	
-	UE_LOG(LogAssetGenerator, Display, TEXT("Generated packages %d Packages UpToDate %d Total %d"), PackagesGenerated, Statistics.AssetPackagesUpToDate, TotalPackages);
+	const int32 ShaderJobsRemaining = GShaderCompilingManager != NULL ? GShaderCompilingManager->GetNumRemainingJobs() : 0;
+	const int32 PackagesWaitingForSave = PackageSaveCoordinator->GetNumPendingPackages();
+	
+	UE_LOG(LogAssetGenerator, Display, TEXT("Generated packages %d Packages UpToDate %d Total %d Shader jobs remaining %d Packages waiting to be saved %d"),
+		PackagesGenerated, Statistics.AssetPackagesUpToDate, TotalPackages, ShaderJobsRemaining, PackagesWaitingForSave);
 	if (NotificationItem.IsValid()) {
 		FFormatNamedArguments Arguments;
 		
@@ -363,10 +514,12 @@ void FAssetGenerationProcessor::UpdateNotificationItem() {
 		Arguments.Add(TEXT("PackagesUpToDate"), Statistics.AssetPackagesUpToDate);
 		Arguments.Add(TEXT("PackagesSkipped"), Statistics.AssetPackagesSkipped);
 		Arguments.Add(TEXT("PackagesInProgress"), AssetGenerators.Num());
+		Arguments.Add(TEXT("ShaderJobsRemaining"), ShaderJobsRemaining);
+		Arguments.Add(TEXT("PackagesWaitingForSave"), PackagesWaitingForSave);
 
 		NotificationItem->SetText(FText::Format(LOCTEXT("AssetGenerator_Progress",
 			"Asset Generation: {PackagesGenerated} Generated, {TotalPackages} Total, {PackagesUpToDate} UpToDate, {PackagesSkipped} Skipped, "
-			"{PackagesInProgress} Generating Currently"), Arguments));
+			"{PackagesInProgress} Generating Currently, {ShaderJobsRemaining} Shaders Compiling, {PackagesWaitingForSave} Waiting To Be Saved"), Arguments));
 	}
 }
 
@@ -392,22 +545,7 @@ void FAssetGenerationProcessor::PrintStateIntoTheLog() {
 		}
 	}
 
-	if (PendingDependencies.Num()) {
-		UE_LOG(LogAssetGenerator, Log, TEXT("Pending package dependencies: "));
-		for (const TPair<FName, TArray<TSharedPtr<FDependencyList>>>& Pair : PendingDependencies) {
-			UE_LOG(LogAssetGenerator, Log, TEXT(" - %s Dependents:"), *Pair.Key.ToString());
-			for (const TSharedPtr<FDependencyList>& DependentPtr : Pair.Value) {
-				UE_LOG(LogAssetGenerator, Log, TEXT("    - %s"), *DependentPtr->AssetTypeGenerator->GetPackageName().ToString());
-			}
-		}
-	}
-
-	if (GeneratorsReadyToAdvance.Num()) {
-		UE_LOG(LogAssetGenerator, Log, TEXT("Generators ready to advance: "));
-		for (UAssetTypeGenerator* Generator : GeneratorsReadyToAdvance) {
-			UE_LOG(LogAssetGenerator, Log, TEXT(" - %s"), *Generator->GetPackageName().ToString());
-		}
-	}
+	Scheduler.PrintStateIntoTheLog();
 
 	if (KnownMissingPackages.Num()) {
 		UE_LOG(LogAssetGenerator, Log, TEXT("Missing external packages: "));
@@ -438,9 +576,17 @@ FAssetGenerationProcessor::FAssetGenerationProcessor(const FAssetGeneratorConfig
 	this->Configuration = Configuration;
 	this->PackagesToGenerate = PackagesToGenerate;
 	this->NextPackageToGenerateIndex = 0;
+	this->NextPackageToPrefetchIndex = 0;
 	this->bGenerationFinished = false;
 	this->bIsFirstTick = true;
 	this->Statistics.TotalAssetPackages = PackagesToGenerate.Num();
+
+	this->DumpManifest = Configuration.DumpManifest;
+	if (!DumpManifest.IsValid()) {
+		this->DumpManifest = FAssetDumpManifest::LoadFromDirectory(Configuration.DumpRootDirectory);
+	}
+	this->DumpPrefetcher = MakeUnique<FAssetDumpPrefetcher>(Configuration.DumpRootDirectory, Configuration.MaxPrefetchedDumpBytes);
+	this->PackageSaveCoordinator = MakeUnique<FAssetPackageSaveCoordinator>(Configuration.MaxPackagesPerSaveBatch);
 }
 
 TSharedRef<FAssetGenerationProcessor> FAssetGenerationProcessor::CreateAssetGenerator(const FAssetGeneratorConfiguration& Configuration, const TArray<FName>& PackagesToGenerate) {
@@ -467,6 +613,10 @@ void FAssetGenerationProcessor::TickOnTheSide(int32& PackagesGeneratedThisTick)
 	}
 }
 
+void FAssetGenerationProcessor::FlushPendingPackageSaves(const bool bIncludeCompilingPackages) {
+	PackageSaveCoordinator->Flush(bIncludeCompilingPackages);
+}
+
 void FAssetGenerationProcessor::Tick(float DeltaTime) {
 	if (!Configuration.bTickOnTheSide) {
 		int32 PackagesGeneratedThisTick;
@@ -0,0 +1,408 @@
+#include "Toolkit/AssetGeneration/AssetGenerationScheduler.h"
+
+FAssetGenerationCycle::FAssetGenerationCycle() : ComponentSize(0), RelaxedEntryIndex(INDEX_NONE) {
+}
+
+FAssetGenerationGraphStatistics::FAssetGenerationGraphStatistics() {
+	this->TotalNodes = 0;
+	this->TotalEdges = 0;
+	this->MaxReadyNodes = 0;
+	this->LongestChain = 0;
+	this->LongestChainPackage = NAME_None;
+	this->RelaxedDependencies = 0;
+}
+
+FAssetGenerationScheduler::FAssetGenerationScheduler() {
+	for (FReadyBucket& Bucket : ReadyBuckets) {
+		Bucket.Head = 0;
+	}
+	this->HighestReadyPriority = INDEX_NONE;
+	this->NumReadyNodes = 0;
+}
+
+int32 FAssetGenerationScheduler::FindOrAddNode(const FName PackageName, const EAssetGenerationStage Stage) {
+	const FAssetGenerationNodeKey NodeKey(PackageName, Stage);
+	const int32* ExistingNodeIndex = NodeIndices.Find(NodeKey);
+	if (ExistingNodeIndex != NULL) {
+		return *ExistingNodeIndex;
+	}
+
+	const int32 NodeIndex = Nodes.AddDefaulted();
+	FNode& Node = Nodes[NodeIndex];
+	Node.PackageName = PackageName;
+	Node.Stage = Stage;
+	Node.Generator = NULL;
+	Node.UnresolvedDependencies = 0;
+	//Every stage is followed by the remaining stages of the same package
+	Node.CriticalPathLength = FMath::Max(0, (int32) EAssetGenerationStage::FINISHED - (int32) Stage - 1);
+	Node.ChainLength = 0;
+	Node.QueuedPriority = INDEX_NONE;
+	Node.bCompleted = false;
+
+	this->NodeIndices.Add(NodeKey, NodeIndex);
+	this->Statistics.TotalNodes++;
+	return NodeIndex;
+}
+
+void FAssetGenerationScheduler::EnqueueReadyNode(const int32 NodeIndex) {
+	FNode& Node = Nodes[NodeIndex];
+	const int32 Priority = FMath::Clamp(Node.CriticalPathLength, 0, ASSET_GENERATION_SCHEDULER_PRIORITY_LEVELS - 1);
+
+	if (Node.QueuedPriority == INDEX_NONE) {
+		this->NumReadyNodes++;
+		this->Statistics.MaxReadyNodes = FMath::Max(Statistics.MaxReadyNodes, NumReadyNodes);
+	}
+	//Entry left in the bucket of the previous priority becomes stale and will be skipped when dequeued
+	Node.QueuedPriority = Priority;
+	this->ReadyBuckets[Priority].Nodes.Add(NodeIndex);
+	this->HighestReadyPriority = FMath::Max(HighestReadyPriority, Priority);
+}
+
+void FAssetGenerationScheduler::RaiseCriticalPathLength(const int32 NodeIndex, const int32 NewCriticalPathLength) {
+	TArray<TPair<int32, int32>> PendingNodes;
+	PendingNodes.Add(TPair<int32, int32>(NodeIndex, NewCriticalPathLength));
+
+	while (PendingNodes.Num()) {
+		const TPair<int32, int32> Entry = PendingNodes.Pop(false);
+		//Clamping to the highest priority also guarantees propagation terminates on cyclic dependencies
+		const int32 CriticalPathLength = FMath::Min(Entry.Value, ASSET_GENERATION_SCHEDULER_PRIORITY_LEVELS - 1);
+		FNode& Node = Nodes[Entry.Key];
+
+		if (Node.bCompleted || CriticalPathLength <= Node.CriticalPathLength) {
+			continue;
+		}
+		Node.CriticalPathLength = CriticalPathLength;
+
+		if (Node.QueuedPriority != INDEX_NONE && Node.QueuedPriority != CriticalPathLength) {
+			EnqueueReadyNode(Entry.Key);
+		}
+		for (const int32 DependencyIndex : Node.Dependencies) {
+			PendingNodes.Add(TPair<int32, int32>(DependencyIndex, CriticalPathLength + 1));
+		}
+
+		//Stage generator has not reached yet can only be completed after the stage it is currently at
+		if (Node.Generator == NULL) {
+			const int32* ActiveNodeIndex = ActiveNodes.Find(Node.PackageName);
+			if (ActiveNodeIndex != NULL && *ActiveNodeIndex != Entry.Key) {
+				const int32 StagesInBetween = (int32) Node.Stage - (int32) Nodes[*ActiveNodeIndex].Stage;
+				PendingNodes.Add(TPair<int32, int32>(*ActiveNodeIndex, CriticalPathLength + StagesInBetween));
+			}
+		}
+	}
+}
+
+void FAssetGenerationScheduler::ScheduleGeneratorStage(UAssetTypeGenerator* Generator, const TMap<FName, EAssetGenerationStage>& WaitingDependencies) {
+	const FName PackageName = Generator->GetPackageName();
+	const int32 NodeIndex = FindOrAddNode(PackageName, Generator->GetCurrentStage());
+
+	//Stage always comes after the previous stage of the same package
+	const int32* PreviousNodeIndex = ActiveNodes.Find(PackageName);
+	const int32 PreviousChainLength = PreviousNodeIndex != NULL ? Nodes[*PreviousNodeIndex].ChainLength : 0;
+	this->ActiveNodes.Add(PackageName, NodeIndex);
+
+	Nodes[NodeIndex].Generator = Generator;
+	Nodes[NodeIndex].ChainLength = FMath::Max(Nodes[NodeIndex].ChainLength, PreviousChainLength + 1);
+
+	for (const TPair<FName, EAssetGenerationStage>& Dependency : WaitingDependencies) {
+		const int32 DependencyIndex = FindOrAddNode(Dependency.Key, Dependency.Value);
+		if (Nodes[DependencyIndex].bCompleted) {
+			continue;
+		}
+		Nodes[DependencyIndex].Dependents.Add(NodeIndex);
+		Nodes[NodeIndex].Dependencies.Add(DependencyIndex);
+		Nodes[NodeIndex].UnresolvedDependencies++;
+		this->Statistics.TotalEdges++;
+
+		//Dependency has to be completed before this stage and everything waiting for it
+		RaiseCriticalPathLength(DependencyIndex, Nodes[NodeIndex].CriticalPathLength + 1);
+	}
+
+	if (Nodes[NodeIndex].UnresolvedDependencies == 0) {
+		UE_LOG(LogAssetGenerator, VeryVerbose, TEXT("Dependencies satisfied for package %s (instantly)"), *PackageName.ToString());
+		EnqueueReadyNode(NodeIndex);
+	}
+}
+
+void FAssetGenerationScheduler::OnGeneratorStageCompleted(UAssetTypeGenerator* Generator, const EAssetGenerationStage CompletedStage) {
+	const FName PackageName = Generator->GetPackageName();
+	const int32* NodeIndexPtr = NodeIndices.Find(FAssetGenerationNodeKey(PackageName, CompletedStage));
+	if (NodeIndexPtr == NULL) {
+		return;
+	}
+	const int32 NodeIndex = *NodeIndexPtr;
+	FNode& Node = Nodes[NodeIndex];
+
+	Node.bCompleted = true;
+	Node.Dependencies.Empty();
+	const TArray<int32> Dependents = MoveTemp(Node.Dependents);
+	const int32 ChainLength = Node.ChainLength;
+
+	if (ChainLength > Statistics.LongestChain) {
+		this->Statistics.LongestChain = ChainLength;
+		this->Statistics.LongestChainPackage = PackageName;
+	}
+
+	for (const int32 DependentIndex : Dependents) {
+		FNode& Dependent = Nodes[DependentIndex];
+		Dependent.ChainLength = FMath::Max(Dependent.ChainLength, ChainLength + 1);
+		Dependent.UnresolvedDependencies--;
+
+		UE_LOG(LogAssetGenerator, VeryVerbose, TEXT("Dependent package %s has satisfied dependency on %s (dependencies remaining: %d)"),
+			*Dependent.PackageName.ToString(), *PackageName.ToString(), Dependent.UnresolvedDependencies);
+
+		//Queue dependent generator if all dependencies have been satisfied
+		if (Dependent.UnresolvedDependencies == 0) {
+			UE_LOG(LogAssetGenerator, VeryVerbose, TEXT("Dependencies satisfied for package %s"), *Dependent.PackageName.ToString());
+			EnqueueReadyNode(DependentIndex);
+		}
+	}
+}
+
+UAssetTypeGenerator* FAssetGenerationScheduler::DequeueReadyGenerator() {
+	while (HighestReadyPriority != INDEX_NONE) {
+		FReadyBucket& Bucket = ReadyBuckets[HighestReadyPriority];
+
+		if (Bucket.Head < Bucket.Nodes.Num()) {
+			const int32 NodeIndex = Bucket.Nodes[Bucket.Head++];
+			FNode& Node = Nodes[NodeIndex];
+
+			//Nodes re-queued with a higher priority leave stale entries behind, skip them
+			if (Node.QueuedPriority == HighestReadyPriority) {
+				Node.QueuedPriority = INDEX_NONE;
+				this->NumReadyNodes--;
+				return Node.Generator;
+			}
+			continue;
+		}
+		Bucket.Nodes.Reset();
+		Bucket.Head = 0;
+		this->HighestReadyPriority--;
+	}
+	return NULL;
+}
+
+bool FAssetGenerationScheduler::HasWaitingDependents(const FName PackageName) const {
+	for (int32 StageIndex = 0; StageIndex <= (int32) EAssetGenerationStage::FINISHED; StageIndex++) {
+		const int32* NodeIndex = NodeIndices.Find(FAssetGenerationNodeKey(PackageName, (EAssetGenerationStage) StageIndex));
+		if (NodeIndex != NULL && !Nodes[*NodeIndex].bCompleted && Nodes[*NodeIndex].Dependents.Num()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void FAssetGenerationScheduler::RemovePackage(const FName PackageName) {
+	for (int32 StageIndex = 0; StageIndex <= (int32) EAssetGenerationStage::FINISHED; StageIndex++) {
+		int32 NodeIndex;
+		if (NodeIndices.RemoveAndCopyValue(FAssetGenerationNodeKey(PackageName, (EAssetGenerationStage) StageIndex), NodeIndex)) {
+			FNode& Node = Nodes[NodeIndex];
+			Node.Generator = NULL;
+			Node.bCompleted = true;
+			Node.Dependents.Empty();
+			Node.Dependencies.Empty();
+		}
+	}
+	this->ActiveNodes.Remove(PackageName);
+}
+
+void FAssetGenerationScheduler::GetWaitedNodes(const int32 NodeIndex, TArray<int32>& OutNodeIndices) const {
+	const FNode& Node = Nodes[NodeIndex];
+	for (const int32 DependencyIndex : Node.Dependencies) {
+		if (!Nodes[DependencyIndex].bCompleted) {
+			OutNodeIndices.Add(DependencyIndex);
+		}
+	}
+
+	//Stage generator has not reached yet waits for the stage it is currently at
+	if (Node.Generator == NULL) {
+		const int32* ActiveNodeIndex = ActiveNodes.Find(Node.PackageName);
+		if (ActiveNodeIndex != NULL && *ActiveNodeIndex != NodeIndex && !Nodes[*ActiveNodeIndex].bCompleted) {
+			OutNodeIndices.Add(*ActiveNodeIndex);
+		}
+	}
+}
+
+void FAssetGenerationScheduler::FindDependencyCycles(TArray<FAssetGenerationCycle>& OutCycles) const {
+	//Iterative Tarjan's algorithm, recursion would overflow the stack on long dependency chains
+	struct FVisitFrame {
+		int32 NodeIndex;
+		TArray<int32> WaitedNodes;
+		int32 NextWaitedNode;
+	};
+
+	TArray<int32> VisitOrder;
+	VisitOrder.Init(INDEX_NONE, Nodes.Num());
+	TArray<int32> LowLinks;
+	LowLinks.Init(INDEX_NONE, Nodes.Num());
+	TBitArray<> IsOnComponentStack(false, Nodes.Num());
+	TArray<int32> ComponentStack;
+	TArray<FVisitFrame> VisitStack;
+	int32 NextVisitOrder = 0;
+
+	const auto BeginVisit = [&](const int32 NodeIndex) {
+		VisitOrder[NodeIndex] = NextVisitOrder;
+		LowLinks[NodeIndex] = NextVisitOrder;
+		NextVisitOrder++;
+		ComponentStack.Push(NodeIndex);
+		IsOnComponentStack[NodeIndex] = true;
+
+		FVisitFrame& Frame = VisitStack.AddDefaulted_GetRef();
+		Frame.NodeIndex = NodeIndex;
+		Frame.NextWaitedNode = 0;
+		GetWaitedNodes(NodeIndex, Frame.WaitedNodes);
+	};
+
+	for (const TPair<FAssetGenerationNodeKey, int32>& Pair : NodeIndices) {
+		if (Nodes[Pair.Value].bCompleted || VisitOrder[Pair.Value] != INDEX_NONE) {
+			continue;
+		}
+		BeginVisit(Pair.Value);
+
+		while (VisitStack.Num()) {
+			FVisitFrame& Frame = VisitStack.Last();
+			const int32 NodeIndex = Frame.NodeIndex;
+
+			if (Frame.NextWaitedNode < Frame.WaitedNodes.Num()) {
+				const int32 WaitedNodeIndex = Frame.WaitedNodes[Frame.NextWaitedNode++];
+				if (VisitOrder[WaitedNodeIndex] == INDEX_NONE) {
+					BeginVisit(WaitedNodeIndex);
+				} else if (IsOnComponentStack[WaitedNodeIndex]) {
+					LowLinks[NodeIndex] = FMath::Min(LowLinks[NodeIndex], VisitOrder[WaitedNodeIndex]);
+				}
+				continue;
+			}
+
+			const bool bWaitsForItself = Frame.WaitedNodes.Contains(NodeIndex);
+			VisitStack.Pop(false);
+			if (VisitStack.Num()) {
+				const int32 ParentNodeIndex = VisitStack.Last().NodeIndex;
+				LowLinks[ParentNodeIndex] = FMath::Min(LowLinks[ParentNodeIndex], LowLinks[NodeIndex]);
+			}
+
+			//Node is the root of the strongly connected component, pop the whole component from the stack
+			if (LowLinks[NodeIndex] == VisitOrder[NodeIndex]) {
+				TArray<int32> ComponentNodes;
+				int32 ComponentNodeIndex;
+				do {
+					ComponentNodeIndex = ComponentStack.Pop(false);
+					IsOnComponentStack[ComponentNodeIndex] = false;
+					ComponentNodes.Add(ComponentNodeIndex);
+				} while (ComponentNodeIndex != NodeIndex);
+
+				if (ComponentNodes.Num() > 1 || bWaitsForItself) {
+					ExtractCycleFromComponent(ComponentNodes, OutCycles.AddDefaulted_GetRef());
+				}
+			}
+		}
+	}
+}
+
+void FAssetGenerationScheduler::ExtractCycleFromComponent(const TArray<int32>& ComponentNodes, FAssetGenerationCycle& OutCycle) const {
+	const TSet<int32> ComponentNodeSet(ComponentNodes);
+	TArray<int32> Path;
+	TMap<int32, int32> PathPositions;
+	TArray<int32> WaitedNodes;
+
+	//Every node of the component waits for another node of the same component, so walking them always comes back to the visited node
+	int32 CurrentNodeIndex = ComponentNodes[0];
+	while (!PathPositions.Contains(CurrentNodeIndex)) {
+		PathPositions.Add(CurrentNodeIndex, Path.Add(CurrentNodeIndex));
+
+		WaitedNodes.Reset();
+		GetWaitedNodes(CurrentNodeIndex, WaitedNodes);
+		for (const int32 WaitedNodeIndex : WaitedNodes) {
+			if (ComponentNodeSet.Contains(WaitedNodeIndex)) {
+				CurrentNodeIndex = WaitedNodeIndex;
+				break;
+			}
+		}
+	}
+
+	const int32 CycleStart = PathPositions.FindChecked(CurrentNodeIndex);
+	for (int32 i = CycleStart; i < Path.Num(); i++) {
+		const FNode& Node = Nodes[Path[i]];
+		const int32 NextNodeIndex = Path.IsValidIndex(i + 1) ? Path[i + 1] : Path[CycleStart];
+
+		FAssetGenerationCycleEntry& Entry = OutCycle.Entries.AddDefaulted_GetRef();
+		Entry.PackageName = Node.PackageName;
+		Entry.Stage = Node.Stage;
+		Entry.bWaitsForOwnGenerator = !Node.Dependencies.Contains(NextNodeIndex);
+	}
+	OutCycle.ComponentSize = ComponentNodes.Num();
+}
+
+bool FAssetGenerationScheduler::RelaxWeakestDependency(FAssetGenerationCycle& Cycle) {
+	const int32 NumEntries = Cycle.Entries.Num();
+	int32 WeakestEntryIndex = INDEX_NONE;
+
+	//Generator always has to complete it's own stages in order, so only dependencies between packages can be dropped
+	for (int32 i = 0; i < NumEntries; i++) {
+		if (Cycle.Entries[i].bWaitsForOwnGenerator) {
+			continue;
+		}
+		const EAssetGenerationStage RequiredStage = Cycle.Entries[(i + 1) % NumEntries].Stage;
+		if (WeakestEntryIndex == INDEX_NONE || RequiredStage < Cycle.Entries[(WeakestEntryIndex + 1) % NumEntries].Stage) {
+			WeakestEntryIndex = i;
+		}
+	}
+	if (WeakestEntryIndex == INDEX_NONE) {
+		return false;
+	}
+
+	const FAssetGenerationCycleEntry& DependentEntry = Cycle.Entries[WeakestEntryIndex];
+	const FAssetGenerationCycleEntry& DependencyEntry = Cycle.Entries[(WeakestEntryIndex + 1) % NumEntries];
+	const int32* DependentIndex = NodeIndices.Find(FAssetGenerationNodeKey(DependentEntry.PackageName, DependentEntry.Stage));
+	const int32* DependencyIndex = NodeIndices.Find(FAssetGenerationNodeKey(DependencyEntry.PackageName, DependencyEntry.Stage));
+	if (DependentIndex == NULL || DependencyIndex == NULL) {
+		return false;
+	}
+
+	FNode& DependentNode = Nodes[*DependentIndex];
+	if (DependentNode.Dependencies.Remove(*DependencyIndex) == 0) {
+		return false;
+	}
+	Nodes[*DependencyIndex].Dependents.Remove(*DependentIndex);
+	DependentNode.UnresolvedDependencies--;
+
+	Cycle.RelaxedEntryIndex = WeakestEntryIndex;
+	this->Statistics.RelaxedDependencies++;
+
+	if (DependentNode.UnresolvedDependencies == 0) {
+		EnqueueReadyNode(*DependentIndex);
+	}
+	return true;
+}
+
+void FAssetGenerationScheduler::PrintStateIntoTheLog() const {
+	if (NumReadyNodes) {
+		UE_LOG(LogAssetGenerator, Log, TEXT("Generators ready to advance: "));
+		for (int32 Priority = HighestReadyPriority; Priority >= 0; Priority--) {
+			const FReadyBucket& Bucket = ReadyBuckets[Priority];
+			for (int32 i = Bucket.Head; i < Bucket.Nodes.Num(); i++) {
+				const FNode& Node = Nodes[Bucket.Nodes[i]];
+				if (Node.QueuedPriority == Priority) {
+					UE_LOG(LogAssetGenerator, Log, TEXT(" - %s (Stage: %d, Priority: %d)"), *Node.PackageName.ToString(), Node.Stage, Priority);
+				}
+			}
+		}
+	}
+
+	bool bPrintedHeader = false;
+	for (const TPair<FAssetGenerationNodeKey, int32>& Pair : NodeIndices) {
+		const FNode& Node = Nodes[Pair.Value];
+		if (Node.bCompleted || Node.UnresolvedDependencies == 0) {
+			continue;
+		}
+		if (!bPrintedHeader) {
+			UE_LOG(LogAssetGenerator, Log, TEXT("Pending package dependencies: "));
+			bPrintedHeader = true;
+		}
+		UE_LOG(LogAssetGenerator, Log, TEXT(" - %s (Stage: %d) Waiting for:"), *Node.PackageName.ToString(), Node.Stage);
+		for (const int32 DependencyIndex : Node.Dependencies) {
+			const FNode& Dependency = Nodes[DependencyIndex];
+			if (!Dependency.bCompleted) {
+				UE_LOG(LogAssetGenerator, Log, TEXT("    - %s (Stage: %d)"), *Dependency.PackageName.ToString(), Dependency.Stage);
+			}
+		}
+	}
+}
@@ -10,6 +10,11 @@
 
 DEFINE_LOG_CATEGORY(LogAssetGeneratorCommandlet)
 
+/** Default amount of shader jobs allowed to be queued before generation stops to let shader compilation catch up */
+#define DEFAULT_MAX_PENDING_SHADER_JOBS 4096
+/** Interval between the progress reports printed while waiting for the remaining shader compilation */
+#define SHADER_COMPILATION_PROGRESS_INTERVAL_SECONDS 5.0
+
 struct FAssetGeneratorGCController {
 private:
 	int32 PackagesCookedSinceLastGC;
@@ -18,6 +23,9 @@ private:
 	float MaxSecondsBetweenGC;
 	int32 MaxPackagesBetweenGC;
 public:
+	/** Called right before garbage is collected, e.g to write pending packages to disk so they can be collected */
+	TFunction<void()> OnPreCollectGarbage;
+
 	explicit FAssetGeneratorGCController(float MaxSecondsBetweenGC = 20.0f, int32 MaxPackagesBetweenGC = 32) {
 		this->PackagesCookedSinceLastGC = 0;
 		this->LastGCTimestamp = 0.0f;
@@ -39,6 +47,9 @@ public:
 			bShouldGC = true;
 		}
 		if (bShouldGC) {
+			if (OnPreCollectGarbage) {
+				OnPreCollectGarbage();
+			}
 			UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Collecting garbage"));
 			CollectGarbage(RF_Standalone);
 
@@ -50,7 +61,7 @@ public:
 
 UAssetGeneratorCommandlet::UAssetGeneratorCommandlet() {
 	HelpDescription = TEXT("Generates assets from the dump located in the provided folder using the provided settings");
-	HelpUsage = TEXT("assetgenerator -DumpDirectory=Path/To/Directory [-ForceGeneratePackageNames=ForceGeneratePackageNames.txt] [-BlacklistPackageNames=BlacklistPackageNames.txt] [-AssetClassWhitelist=Class1,Class2] [-NoRefresh] [-PublicProject]");
+	HelpUsage = TEXT("assetgenerator -DumpDirectory=Path/To/Directory [-ForceGeneratePackageNames=ForceGeneratePackageNames.txt] [-BlacklistPackageNames=BlacklistPackageNames.txt] [-AssetClassWhitelist=Class1,Class2] [-NoRefresh] [-PublicProject] [-BreakDependencyCycles] [-DependencyCycleReport=Path/To/DependencyCycles.json] [-MaxPendingShaderJobs=4096]");
 	ShowErrorCount = false;
 }
 
@@ -181,6 +192,16 @@ int32 UAssetGeneratorCommandlet::Main(const FString& Params) {
 	Configuration.bRefreshExistingAssets = bRefreshExistingAssets;
 	Configuration.bGeneratePublicProject = bGeneratePublicProject;
 
+	//Keep generating when dependency cycles are encountered if requested, instead of stopping the commandlet
+	if (Switches.Contains(TEXT("BreakDependencyCycles"))) {
+		Configuration.DependencyCyclePolicy = EDependencyCyclePolicy::RELAX_WEAKEST_DEPENDENCY;
+	}
+	FParse::Value(*Params, TEXT("DependencyCycleReport="), Configuration.DependencyCycleReportPath);
+
+	//Shaders compile in the background while generation goes on, until that many jobs pile up
+	int32 MaxPendingShaderJobs = DEFAULT_MAX_PENDING_SHADER_JOBS;
+	FParse::Value(*Params, TEXT("MaxPendingShaderJobs="), MaxPendingShaderJobs);
+
 	//Populate the initial list of the packages with asset category filters applied
 	TArray<FName> ResultPackagesToGenerate;
 	{
@@ -188,6 +209,9 @@ int32 UAssetGeneratorCommandlet::Main(const FString& Params) {
 		const TSharedPtr<FAssetDumpTreeNode> RootNode = FAssetDumpTreeNode::CreateRootTreeNode(DumpDirectory);
 		RootNode->PopulateGeneratedPackages(GeneratedPackageNames, WhitelstedAssetClasses.Get());
 
+		//Reuse the manifest loaded by the tree so asset generator does not have to load it again
+		Configuration.DumpManifest = RootNode->DumpManifest;
+
 		if (GeneratedPackageNames.Num() == 0) {
 			UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("No assets matching the specified category whitelist found"));
 			return 0;
@@ -232,6 +256,11 @@ int32 UAssetGeneratorCommandlet::Main(const FString& Params) {
 	//We always want to tick the generator manually, even though without engine ticking game objects will not be processed anyway
 	Configuration.bTickOnTheSide = true;
 	TSharedPtr<FAssetGenerationProcessor> GenerationProcessor = FAssetGenerationProcessor::CreateAssetGenerator(Configuration, ResultPackagesToGenerate);
+
+	//Garbage collection is a safe point to write packages changed so far, so they do not have to be kept in memory anymore
+	AssetGeneratorGCController.OnPreCollectGarbage = [GenerationProcessor]() {
+		GenerationProcessor->FlushPendingPackageSaves(false);
+	};
 	
 	while (!GenerationProcessor->HasFinishedAssetGeneration() && !IsEngineExitRequested()) {
 		int32 GeneratedPkgCount = 0;
@@ -246,17 +275,41 @@ int32 UAssetGeneratorCommandlet::Main(const FString& Params) {
 		//process deferred commands
 		ProcessDeferredCommands();
 
-		//Tick shader compilation if we have any pending async shader jobs
-		while (GShaderCompilingManager->HasShaderJobs() && !IsEngineExitRequested()) {
-			
-			// force at least a tick shader compilation even if we are requesting stuff
+		//Pick up the results of the shader jobs finished so far without waiting for the rest of them,
+		//so materials keep compiling in the background while we generate the next packages
+		GShaderCompilingManager->ProcessAsyncResults(true, false);
+
+		//Only wait for shader compilation to catch up when too many jobs pile up
+		while (GShaderCompilingManager->GetNumRemainingJobs() > MaxPendingShaderJobs && !IsEngineExitRequested()) {
 			GShaderCompilingManager->ProcessAsyncResults(true, false);
-			
 			ProcessDeferredCommands();
-			AssetGeneratorGCController.ConditionallyCollectGarbage();
+			FPlatformProcess::Sleep(0.01f);
 		}
 	}
 
+	//Wait for the remaining shader compilation, saving packages as soon as their materials are compiled
+	double LastProgressReportTime = 0.0;
+	
+	while (GShaderCompilingManager->HasShaderJobs() && !IsEngineExitRequested()) {
+		GShaderCompilingManager->ProcessAsyncResults(true, false);
+		GenerationProcessor->FlushPendingPackageSaves(false);
+		
+		ProcessDeferredCommands();
+		AssetGeneratorGCController.ConditionallyCollectGarbage();
+
+		if (FPlatformTime::Seconds() - LastProgressReportTime >= SHADER_COMPILATION_PROGRESS_INTERVAL_SECONDS) {
+			UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Waiting for shader compilation: %d shader jobs remaining, %d packages waiting to be saved"),
+				GShaderCompilingManager->GetNumRemainingJobs(), GenerationProcessor->GetNumPendingPackageSaves());
+			LastProgressReportTime = FPlatformTime::Seconds();
+		}
+		FPlatformProcess::Sleep(0.01f);
+	}
+	GenerationProcessor->FlushPendingPackageSaves(true);
+
+	const FAssetPackageSaveStatistics& SaveStatistics = GenerationProcessor->GetSaveStatistics();
+	UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Saved %d generated packages in %d batches, %d packages had to be saved again, %.2f MB written"),
+		SaveStatistics.PackagesSaved, SaveStatistics.SaveBatches, SaveStatistics.PackagesResaved, SaveStatistics.BytesWritten / (1024.0 * 1024.0));
+
 	//Save any packages that are still in memory and have dirty flag
 	TArray<UPackage*> InMemoryDirtyPackages;
 
@@ -271,10 +324,7 @@ int32 UAssetGeneratorCommandlet::Main(const FString& Params) {
 	if (InMemoryDirtyPackages.Num()) {
 		UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Saving %d in-memory dirty packages after the asset generation is done"), InMemoryDirtyPackages.Num());
 
-		for (UPackage* Package : InMemoryDirtyPackages) {
-			UE_LOG(LogAssetGeneratorCommandlet, Display, TEXT("Saving dirty package %s"), *Package->GetName());
-			UEditorLoadingAndSavingUtils::SavePackages({Package}, true);
-		}
+		UEditorLoadingAndSavingUtils::SavePackages(InMemoryDirtyPackages, true);
 		AssetGeneratorGCController.ConditionallyCollectGarbage();
 	}
 	
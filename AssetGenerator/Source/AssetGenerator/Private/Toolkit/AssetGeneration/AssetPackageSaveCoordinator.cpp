@@ -0,0 +1,140 @@
+#include "Toolkit/AssetGeneration/AssetPackageSaveCoordinator.h"
+#include "FileHelpers.h"
+#include "HAL/FileManager.h"
+#include "MaterialShared.h"
+#include "Misc/PackageName.h"
+#include "Materials/MaterialInterface.h"
+#include "Toolkit/AssetGeneration/AssetTypeGenerator.h"
+
+int64 GetSavedPackageFileSize(UPackage* Package) {
+	const FString& PackageExtension = Package->ContainsMap() ? FPackageName::GetMapPackageExtension() : FPackageName::GetAssetPackageExtension();
+	const FString PackageFilename = FPackageName::LongPackageNameToFilename(Package->GetName(), PackageExtension);
+	return FMath::Max(IFileManager::Get().FileSize(*PackageFilename), (int64) 0);
+}
+
+bool IsMaterialCompilingShaders(UMaterialInterface* Material) {
+	//Package is saved with the shaders of every feature and quality level, so all of the material resources need to be ready
+	for (int32 FeatureLevel = 0; FeatureLevel < ERHIFeatureLevel::Num; FeatureLevel++) {
+		for (int32 QualityLevel = 0; QualityLevel < EMaterialQualityLevel::Num; QualityLevel++) {
+			const FMaterialResource* MaterialResource = Material->GetMaterialResource((ERHIFeatureLevel::Type) FeatureLevel, (EMaterialQualityLevel::Type) QualityLevel);
+			if (MaterialResource != NULL && !MaterialResource->IsCompilationFinished()) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+FAssetPackageSaveStatistics::FAssetPackageSaveStatistics() {
+	this->PackagesSaved = 0;
+	this->PackagesResaved = 0;
+	this->SaveBatches = 0;
+	this->BytesWritten = 0;
+}
+
+FAssetPackageSaveCoordinator::FAssetPackageSaveCoordinator(const int32 MaxPackagesPerBatch) {
+	this->MaxPackagesPerBatch = FMath::Max(MaxPackagesPerBatch, 1);
+}
+
+void FAssetPackageSaveCoordinator::QueuePackage(UPackage* Package) {
+	bool bIsAlreadyInSet = false;
+	this->PendingPackageSet.Add(Package, &bIsAlreadyInSet);
+
+	if (!bIsAlreadyInSet) {
+		this->PendingPackages.Add(Package);
+
+		//Materials are collected once when package is queued, so held back packages can be checked without scanning their objects again
+		TArray<UObject*> PackageObjects;
+		GetObjectsWithOuter(Package, PackageObjects, false);
+		
+		TArray<UMaterialInterface*> PackageMaterials;
+		for (UObject* Object : PackageObjects) {
+			UMaterialInterface* Material = Cast<UMaterialInterface>(Object);
+			if (Material != NULL) {
+				PackageMaterials.Add(Material);
+			}
+		}
+		if (PackageMaterials.Num()) {
+			this->CompilingPackageMaterials.Add(Package, MoveTemp(PackageMaterials));
+		}
+	}
+}
+
+void FAssetPackageSaveCoordinator::UpdateCompilingPackages() {
+	for (auto It = CompilingPackageMaterials.CreateIterator(); It; ++It) {
+		TArray<UMaterialInterface*>& Materials = It.Value();
+		
+		//Materials that have finished compiling are dropped, so each one of them is only checked until it is ready
+		Materials.RemoveAll([](UMaterialInterface* Material) { return !IsMaterialCompilingShaders(Material); });
+		if (Materials.Num() == 0) {
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool FAssetPackageSaveCoordinator::ShouldFlush() {
+	if (PendingPackages.Num() < MaxPackagesPerBatch) {
+		return false;
+	}
+	//Only held back packages need to be checked again, and only when the rest of them are not enough for a batch
+	if (PendingPackages.Num() - CompilingPackageMaterials.Num() < MaxPackagesPerBatch) {
+		UpdateCompilingPackages();
+	}
+	return PendingPackages.Num() - CompilingPackageMaterials.Num() >= MaxPackagesPerBatch;
+}
+
+void FAssetPackageSaveCoordinator::Flush(const bool bIncludeCompilingPackages) {
+	TArray<UPackage*> PackagesToSave;
+	TArray<UPackage*> CompilingPackages;
+	UpdateCompilingPackages();
+
+	for (UPackage* Package : PendingPackages) {
+		if (!bIncludeCompilingPackages && CompilingPackageMaterials.Contains(Package)) {
+			CompilingPackages.Add(Package);
+		} else {
+			PackagesToSave.Add(Package);
+		}
+	}
+
+	//Packages with materials still compiling stay queued, so they are saved once their shaders are ready
+	this->PendingPackages = MoveTemp(CompilingPackages);
+	this->PendingPackageSet.Reset();
+	this->PendingPackageSet.Append(PendingPackages);
+	if (bIncludeCompilingPackages) {
+		this->CompilingPackageMaterials.Reset();
+	}
+
+	if (PackagesToSave.Num() == 0) {
+		return;
+	}
+	UE_LOG(LogAssetGenerator, Verbose, TEXT("Saving batch of %d changed packages, %d packages are waiting for shader compilation"), PackagesToSave.Num(), PendingPackages.Num());
+
+	if (!UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, false)) {
+		UE_LOG(LogAssetGenerator, Error, TEXT("Failed to save some of the %d packages in the batch, see the log above for details"), PackagesToSave.Num());
+	}
+	this->Statistics.SaveBatches++;
+
+	for (UPackage* Package : PackagesToSave) {
+		bool bIsAlreadyInSet = false;
+		this->SavedPackageNames.Add(Package->GetFName(), &bIsAlreadyInSet);
+
+		if (bIsAlreadyInSet) {
+			UE_LOG(LogAssetGenerator, Verbose, TEXT("Package %s has been changed after it has been saved, writing it again"), *Package->GetName());
+			this->Statistics.PackagesResaved++;
+		} else {
+			this->Statistics.PackagesSaved++;
+		}
+		this->Statistics.BytesWritten += GetSavedPackageFileSize(Package);
+	}
+}
+
+void FAssetPackageSaveCoordinator::AddReferencedObjects(FReferenceCollector& Collector) {
+	Collector.AddReferencedObjects(PendingPackages);
+	for (TPair<UPackage*, TArray<UMaterialInterface*>>& Pair : CompilingPackageMaterials) {
+		Collector.AddReferencedObjects(Pair.Value);
+	}
+}
+
+FString FAssetPackageSaveCoordinator::GetReferencerName() const {
+	return TEXT("FAssetPackageSaveCoordinator");
+}
@@ -1,8 +1,8 @@
 #include "Toolkit/AssetGeneration/AssetTypeGenerator.h"
-#include "FileHelpers.h"
 #include "Toolkit/ObjectHierarchySerializer.h"
 #include "Toolkit/PropertySerializer.h"
 #include "Toolkit/AssetGeneration/AssetGenerationUtil.h"
+#include "Util/BinaryJsonSerializer.h"
 
 DEFINE_LOG_CATEGORY(LogAssetGenerator)
 
@@ -17,6 +17,12 @@ FString UAssetTypeGenerator::GetAdditionalDumpFilePath(const FString& Postfix, c
 			Filename.AppendChar('.');
 		Filename.Append(Extension);
 	}
+
+	//Side files with content shared between multiple assets are located in the blob store instead of the package directory
+	const FString* BlobFileName = BlobFiles.Find(Filename);
+	if (BlobFileName != NULL) {
+		return FPaths::Combine(DumpRootDirectory, *BlobFileName);
+	}
 	return FPaths::Combine(PackageBaseDirectory, Filename);
 }
 
@@ -50,6 +56,7 @@ UAssetTypeGenerator::UAssetTypeGenerator() {
 	this->bAssetChanged = false;
 	this->bHasAssetEverBeenChanged = false;
 	this->bIsGeneratingPublicProject = false;
+	this->PayloadHashAlgorithm = EPayloadHashAlgorithm::MD5;
 }
 
 void UAssetTypeGenerator::InitializeInternal(const FString& DumpRootDirectory, const FString& InPackageBaseDirectory, const FName InPackageName, const TSharedPtr<FJsonObject> RootFileObject, bool bGeneratePublicProject) {
@@ -63,6 +70,20 @@ void UAssetTypeGenerator::InitializeInternal(const FString& DumpRootDirectory, c
 	const TArray<TSharedPtr<FJsonValue>> ObjectHierarchy = RootFileObject->GetArrayField(TEXT("ObjectHierarchy"));
 	this->ObjectSerializer->InitializeForDeserialization(ObjectHierarchy);
 	this->AssetData = RootFileObject->GetObjectField(TEXT("AssetSerializedData"));
+
+	const TSharedPtr<FJsonObject>* BlobFilesObject;
+	if (RootFileObject->TryGetObjectField(TEXT("BlobFiles"), BlobFilesObject)) {
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*BlobFilesObject)->Values) {
+			this->BlobFiles.Add(Pair.Key, Pair.Value->AsString());
+		}
+	}
+
+	//Dumps written before the payload hash algorithm has been recorded always use MD5
+	FString PayloadHashAlgorithmName;
+	if (RootFileObject->TryGetStringField(TEXT("PayloadHashAlgorithm"), PayloadHashAlgorithmName)) {
+		checkf(FPayloadHasher::FindAlgorithmByName(PayloadHashAlgorithmName, this->PayloadHashAlgorithm),
+			TEXT("Asset dump of package %s uses unknown payload hash algorithm %s"), *PackageName.ToString(), *PayloadHashAlgorithmName);
+	}
 	this->bIsGeneratingPublicProject = bGeneratePublicProject;
 	PostInitializeAssetGenerator();
 }
@@ -158,13 +179,16 @@ FGeneratorStateAdvanceResult UAssetTypeGenerator::AdvanceGenerationState() {
 	//Increment current generation stage
 	this->CurrentStage = (EAssetGenerationStage) ((int32) CurrentStage + 1);
 	
-	//Force package to be saved to disk if it has been marked as changed, which should have also marked it as dirty
+	//Remember packages that need to be saved if asset has been marked as changed, which should have also marked it as dirty
+	//They are written to disk by the asset generation processor once generation is finished, so they are only saved once
 	if (bAssetChanged) {
 		TArray<UPackage*> PackagesToSave;
 		PackagesToSave.Add(AssetPackage);
 		GetAdditionalPackagesToSave(PackagesToSave);
-		UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, false);
 		
+		for (UPackage* Package : PackagesToSave) {
+			AddPackagePendingSave(Package);
+		}
 		this->bAssetChanged = false;
 		this->bHasAssetEverBeenChanged = true;
 	}
@@ -177,32 +201,69 @@ FString UAssetTypeGenerator::GetAssetFilePath(const FString& RootDirectory, FNam
 	PackagePath.RemoveAt(0);
 
 	const FString PackageBaseDirectory = FPaths::Combine(RootDirectory, PackagePath);
-	
-	const FString AssetDumpFilename = FPaths::SetExtension(ShortPackageName, TEXT("json"));
-	return FPaths::Combine(PackageBaseDirectory, AssetDumpFilename);
-}
 
-UAssetTypeGenerator* UAssetTypeGenerator::InitializeFromFile(const FString& RootDirectory, const FName PackageName, bool bGeneratePublicProject) {
-	const FString AssetDumpFilePath = GetAssetFilePath(RootDirectory, PackageName);
-	const FString PackageBaseDirectory = FPaths::GetPath(AssetDumpFilePath);
+	const FString BinaryAssetDumpFilePath = FPaths::Combine(PackageBaseDirectory, FPaths::SetExtension(ShortPackageName, BINARY_JSON_FILE_EXTENSION));
+	const FString JsonAssetDumpFilePath = FPaths::Combine(PackageBaseDirectory, FPaths::SetExtension(ShortPackageName, TEXT("json")));
 
-	//Return early if dump file is not found for this asset
-	if (!FPlatformFileManager::Get().GetPlatformFile().FileExists(*AssetDumpFilePath)) {
-		return NULL;
+	//Use binary dump file if it is present, unless json one has been written after it by the dump in the other format
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FDateTime BinaryTimeStamp = PlatformFile.GetTimeStamp(*BinaryAssetDumpFilePath);
+	if (BinaryTimeStamp == FDateTime::MinValue()) {
+		return JsonAssetDumpFilePath;
 	}
+	const FDateTime JsonTimeStamp = PlatformFile.GetTimeStamp(*JsonAssetDumpFilePath);
+	return JsonTimeStamp > BinaryTimeStamp ? JsonAssetDumpFilePath : BinaryAssetDumpFilePath;
+}
 
-	FString DumpFileStringContents;
-	if (!FFileHelper::LoadFileToString(DumpFileStringContents, *AssetDumpFilePath)) {
+TSharedPtr<FJsonObject> UAssetTypeGenerator::LoadAssetDumpFile(const FString& AssetDumpFilePath) {
+	TArray<uint8> DumpFileContents;
+	if (!FFileHelper::LoadFileToArray(DumpFileContents, *AssetDumpFilePath)) {
 		UE_LOG(LogAssetGenerator, Error, TEXT("Failed to load asset dump file %s"), *AssetDumpFilePath);
 		return NULL;
 	}
 
+	//Binary dump files are read directly into the json object, without going through the text representation
+	if (FBinaryJsonReader::IsBinaryJsonData(DumpFileContents)) {
+		FString ErrorMessage;
+		const TSharedPtr<FJsonObject> RootFileObject = FBinaryJsonReader::ReadObject(DumpFileContents, &ErrorMessage);
+		if (!RootFileObject.IsValid()) {
+			UE_LOG(LogAssetGenerator, Error, TEXT("Failed to read binary asset dump file %s: %s"), *AssetDumpFilePath, *ErrorMessage);
+		}
+		return RootFileObject;
+	}
+
+	FString DumpFileStringContents;
+	FFileHelper::BufferToString(DumpFileStringContents, DumpFileContents.GetData(), DumpFileContents.Num());
+	DumpFileContents.Empty();
+
 	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(DumpFileStringContents);
 	TSharedPtr<FJsonObject> RootFileObject;
 	if (!FJsonSerializer::Deserialize(Reader, RootFileObject)) {
 		UE_LOG(LogAssetGenerator, Error, TEXT("Failed to parse asset dump file %s: invalid json"), *AssetDumpFilePath);
 		return NULL;
 	}
+	return RootFileObject;
+}
+
+UAssetTypeGenerator* UAssetTypeGenerator::InitializeFromFile(const FString& RootDirectory, const FName PackageName, bool bGeneratePublicProject) {
+	return InitializeFromFile(RootDirectory, PackageName, GetAssetFilePath(RootDirectory, PackageName), bGeneratePublicProject);
+}
+
+UAssetTypeGenerator* UAssetTypeGenerator::InitializeFromFile(const FString& RootDirectory, const FName PackageName, const FString& AssetDumpFilePath, bool bGeneratePublicProject) {
+	//Return early if dump file is not found for this asset
+	if (!FPlatformFileManager::Get().GetPlatformFile().FileExists(*AssetDumpFilePath)) {
+		return NULL;
+	}
+
+	const TSharedPtr<FJsonObject> RootFileObject = LoadAssetDumpFile(AssetDumpFilePath);
+	if (!RootFileObject.IsValid()) {
+		return NULL;
+	}
+	return InitializeFromJson(RootDirectory, PackageName, AssetDumpFilePath, RootFileObject, bGeneratePublicProject);
+}
+
+UAssetTypeGenerator* UAssetTypeGenerator::InitializeFromJson(const FString& RootDirectory, const FName PackageName, const FString& AssetDumpFilePath, TSharedPtr<FJsonObject> RootFileObject, bool bGeneratePublicProject) {
+	const FString PackageBaseDirectory = FPaths::GetPath(AssetDumpFilePath);
 
 	const FName AssetClass = FName(*RootFileObject->GetStringField(TEXT("AssetClass")));
 	UClass* AssetTypeGenerator = FindGeneratorForClass(AssetClass);
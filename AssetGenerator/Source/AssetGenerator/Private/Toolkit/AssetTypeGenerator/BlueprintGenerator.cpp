@@ -1,4 +1,5 @@
 ﻿#include "Toolkit/AssetTypeGenerator/BlueprintGenerator.h"
+#include "Toolkit/PropertySerializer.h"
 #include "K2Node_FunctionEntry.h"
 #include "Dom/JsonObject.h"
 #include "Kismet2/BlueprintEditorUtils.h"
@@ -80,6 +81,8 @@ void UBlueprintGenerator::OnExistingPackageLoaded() {
 		FBlueprintGeneratorUtils::EnsureBlueprintUpToDate(Blueprint);
 		
 		FBlueprintCompilationManager::CompileSynchronously(FBPCompileRequest(Blueprint, EBlueprintCompileOptions::None, NULL));
+		//Class has been recompiled in place, so cached serialization plans of it and it's children are no longer valid
+		FStructSerializationPlanCache::Get().InvalidatePlans(Blueprint->GeneratedClass);
 		MarkAssetChanged();
 	}
 	
@@ -230,6 +233,8 @@ void UBlueprintGenerator::UpdateDeserializerBlueprintClassObject(bool bRecompile
 	UBlueprint* Blueprint = GetAsset<UBlueprint>();
 	if (bRecompileBlueprint) {
 		FBlueprintCompilationManager::CompileSynchronously(FBPCompileRequest(Blueprint, EBlueprintCompileOptions::None, NULL));
+		//Class has been recompiled in place, so cached serialization plans of it and it's children are no longer valid
+		FStructSerializationPlanCache::Get().InvalidatePlans(Blueprint->GeneratedClass);
 	}
 
 	UClass* BlueprintGeneratedClass = Blueprint->GeneratedClass;
@@ -244,9 +249,11 @@ void UBlueprintGenerator::PopulateStageDependencies(TArray<FPackageDependency>&
 	if (GetCurrentStage() == EAssetGenerationStage::CONSTRUCTION) {
 		//For construction we want parent class to be FULLY generated
 		TArray<FString> ReferencedPackages;
+		TSet<FString> ReferencedPackageSet;
+		TSet<int32> ObjectsAlreadySerialized;
 		
 		const int32 SuperStructIndex = GetAssetData()->GetIntegerField(TEXT("SuperStruct"));
-		GetObjectSerializer()->CollectObjectPackages(SuperStructIndex, ReferencedPackages);
+		GetObjectSerializer()->CollectObjectPackages(SuperStructIndex, ReferencedPackages, ReferencedPackageSet, ObjectsAlreadySerialized);
 
 		//Same applies to interfaces, we want them ready by that time too
 		TArray<TSharedPtr<FJsonValue>> ImplementedInterfaces = GetAssetData()->GetArrayField(TEXT("Interfaces"));
@@ -254,7 +261,7 @@ void UBlueprintGenerator::PopulateStageDependencies(TArray<FPackageDependency>&
 		for (int32 i = 0; i < ImplementedInterfaces.Num(); i++) {
 			const TSharedPtr<FJsonObject> InterfaceObject = ImplementedInterfaces[i]->AsObject();
 			const int32 ClassObjectIndex = InterfaceObject->GetIntegerField(TEXT("Class"));
-			GetObjectSerializer()->CollectObjectPackages(ClassObjectIndex, ReferencedPackages);
+			GetObjectSerializer()->CollectObjectPackages(ClassObjectIndex, ReferencedPackages, ReferencedPackageSet, ObjectsAlreadySerialized);
 		}
 
 		for (const FString& PackageName : ReferencedPackages) {
@@ -302,8 +309,10 @@ void UBlueprintGenerator::PopulateStageDependencies(TArray<FPackageDependency>&
 		const int32 SCSIndex = GetAssetData()->GetObjectField(TEXT("AssetObjectData"))->GetIntegerField(TEXT("SimpleConstructionScript"));
 
 		TArray<FString> AllDependencyNames;
-		GetObjectSerializer()->CollectObjectPackages(CDOIndex, AllDependencyNames);
-		GetObjectSerializer()->CollectObjectPackages(SCSIndex, AllDependencyNames);
+		TSet<FString> AllDependencyNameSet;
+		TSet<int32> ObjectsAlreadySerialized;
+		GetObjectSerializer()->CollectObjectPackages(CDOIndex, AllDependencyNames, AllDependencyNameSet, ObjectsAlreadySerialized);
+		GetObjectSerializer()->CollectObjectPackages(SCSIndex, AllDependencyNames, AllDependencyNameSet, ObjectsAlreadySerialized);
 		
 		for (const FString& PackageName : AllDependencyNames) {
         	OutDependencies.Add(FPackageDependency{*PackageName, EAssetGenerationStage::CONSTRUCTION});
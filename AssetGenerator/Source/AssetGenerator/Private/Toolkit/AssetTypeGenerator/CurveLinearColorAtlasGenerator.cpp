@@ -32,7 +32,7 @@ void UCurveLinearColorAtlasGenerator::PopulateAtlasAssetWithData(UCurveLinearCol
 }
 
 bool UCurveLinearColorAtlasGenerator::IsAtlasUpToDate(UCurveLinearColorAtlas* Asset) const {
-	return UTexture2DGenerator::IsTextureUpToDate(Asset, GetObjectSerializer(), GetAssetData());
+	return UTexture2DGenerator::IsTextureUpToDate(Asset, GetObjectSerializer(), GetAssetData(), GetPayloadHashAlgorithm());
 }
 
 FName UCurveLinearColorAtlasGenerator::GetAssetClass() {
@@ -2,7 +2,6 @@
 #include "Dom/JsonObject.h"
 #include "Engine/FontFace.h"
 #include "Toolkit/ObjectHierarchySerializer.h"
-#include "Toolkit/AssetTypes/AssetHelper.h"
 
 void UFontFaceGenerator::CreateAssetPackage() {
 	UPackage* NewPackage = CreatePackage(
@@ -43,7 +42,7 @@ bool UFontFaceGenerator::IsFontFaceUpToDate(UFontFace* FontFace) const {
 	const TSharedPtr<FJsonObject> AssetData = GetAssetData();
 	const FString FontPayloadHash = AssetData->GetStringField(TEXT("FontPayloadHash"));
 
-	const FString ExistingDataHash = FAssetHelper::ComputePayloadHash(FontFace->FontFaceData->GetData());
+	const FString ExistingDataHash = FPayloadHasher::HashPayload(FontFace->FontFaceData->GetData(), GetPayloadHashAlgorithm());
 	if (ExistingDataHash != FontPayloadHash) {
 		return false;
 	}
@@ -168,7 +168,7 @@ bool UFontGenerator::IsFontUpToDate(UFont* Font, const FFontGlyphData& GlyphData
 			}
 
 			//Perform standard texture comparison using Texture2DGenerator methods
-			if (!UTexture2DGenerator::IsTextureUpToDate(Texture2D, ObjectSerializer, TextureData)) {
+			if (!UTexture2DGenerator::IsTextureUpToDate(Texture2D, ObjectSerializer, TextureData, GetPayloadHashAlgorithm())) {
 				return false;
 			}
 		}
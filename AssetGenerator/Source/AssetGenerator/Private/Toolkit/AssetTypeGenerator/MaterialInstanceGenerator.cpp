@@ -64,11 +64,13 @@ void UMaterialInstanceGenerator::PopulateStageDependencies(TArray<FPackageDepend
 		}
 		
 		TArray<FString> ReferencedPackages;
+		TSet<FString> ReferencedPackageSet;
+		TSet<int32> ObjectsAlreadySerialized;
 		for (const TSharedPtr<FJsonValue>& ObjectIndexValue : ReferencedObjects) {
 			const int32 ObjectIndex = (int32) ObjectIndexValue->AsNumber();
 
 			if (!AssetUserDataObjectIndices.Contains(ObjectIndex)) {
-				GetObjectSerializer()->CollectObjectPackages(ObjectIndex, ReferencedPackages);
+				GetObjectSerializer()->CollectObjectPackages(ObjectIndex, ReferencedPackages, ReferencedPackageSet, ObjectsAlreadySerialized);
 			}
 		}
 
@@ -79,6 +81,8 @@ void UMaterialInstanceGenerator::PopulateStageDependencies(TArray<FPackageDepend
 	
 	if (GetCurrentStage() == EAssetGenerationStage::PRE_FINSHED) {
 		TArray<FString> ReferencedPackages;
+		TSet<FString> ReferencedPackageSet;
+		TSet<int32> ObjectsAlreadySerialized;
 		const TSharedPtr<FJsonObject> AssetData = GetAssetData();
 		const TSharedPtr<FJsonObject> AssetObjectProperties = AssetData->GetObjectField(TEXT("AssetObjectData"));
 
@@ -86,7 +90,7 @@ void UMaterialInstanceGenerator::PopulateStageDependencies(TArray<FPackageDepend
 
 		for (const TSharedPtr<FJsonValue>& AssetObjectValue : AssetUserDataObjects) {
 			const int32 ObjectIndex = (int32) AssetObjectValue->AsNumber();
-			GetObjectSerializer()->CollectObjectPackages(ObjectIndex, ReferencedPackages);
+			GetObjectSerializer()->CollectObjectPackages(ObjectIndex, ReferencedPackages, ReferencedPackageSet, ObjectsAlreadySerialized);
 		}
 		for (const FString& PackageName : ReferencedPackages) {
 			AssetDependencies.Add(FPackageDependency{*PackageName, EAssetGenerationStage::CDO_FINALIZATION});	
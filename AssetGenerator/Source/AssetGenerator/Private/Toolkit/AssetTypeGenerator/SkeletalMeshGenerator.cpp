@@ -204,17 +204,19 @@ void USkeletalMeshGenerator::PopulateStageDependencies(TArray<FPackageDependency
 		const TArray<TSharedPtr<FJsonValue>>& Materials = AssetData->GetArrayField(TEXT("Materials"));
 	
 		TArray<FString> OutReferencedPackages;
-		GetObjectSerializer()->CollectReferencedPackages(ReferencedObjects, OutReferencedPackages);
+		TSet<FString> ReferencedPackageSet;
+		TSet<int32> ObjectsAlreadySerialized;
+		GetObjectSerializer()->CollectReferencedPackages(ReferencedObjects, OutReferencedPackages, ReferencedPackageSet, ObjectsAlreadySerialized);
 
 		if (AssetData->HasField(TEXT("BodySetup"))) {
 			const int32 BodySetupObjectIndex = AssetData->GetIntegerField(TEXT("BodySetup"));
-			GetObjectSerializer()->CollectObjectPackages(BodySetupObjectIndex, OutReferencedPackages);
+			GetObjectSerializer()->CollectObjectPackages(BodySetupObjectIndex, OutReferencedPackages, ReferencedPackageSet, ObjectsAlreadySerialized);
 		}
 
 		for (int32 i = 0; i < Materials.Num(); i++) {
 			const TSharedPtr<FJsonObject> MaterialObject = Materials[i]->AsObject();
 			const int32 MaterialInterface = MaterialObject->GetIntegerField(TEXT("MaterialInterface"));
-			GetObjectSerializer()->CollectObjectPackages(MaterialInterface, OutReferencedPackages);
+			GetObjectSerializer()->CollectObjectPackages(MaterialInterface, OutReferencedPackages, ReferencedPackageSet, ObjectsAlreadySerialized);
 		}
 		
 		for (const FString& DependencyPackageName : OutReferencedPackages) {
@@ -213,14 +213,16 @@ void UStaticMeshGenerator::PopulateStageDependencies(TArray<FPackageDependency>&
 		const int32 BodySetupObjectIndex = AssetData->GetIntegerField(TEXT("BodySetup"));
 		
 		TArray<FString> OutReferencedPackages;
-		GetObjectSerializer()->CollectReferencedPackages(ReferencedObjects, OutReferencedPackages);
-		GetObjectSerializer()->CollectObjectPackages(NavCollisionObjectIndex, OutReferencedPackages);
-		GetObjectSerializer()->CollectObjectPackages(BodySetupObjectIndex, OutReferencedPackages);
+		TSet<FString> ReferencedPackageSet;
+		TSet<int32> ObjectsAlreadySerialized;
+		GetObjectSerializer()->CollectReferencedPackages(ReferencedObjects, OutReferencedPackages, ReferencedPackageSet, ObjectsAlreadySerialized);
+		GetObjectSerializer()->CollectObjectPackages(NavCollisionObjectIndex, OutReferencedPackages, ReferencedPackageSet, ObjectsAlreadySerialized);
+		GetObjectSerializer()->CollectObjectPackages(BodySetupObjectIndex, OutReferencedPackages, ReferencedPackageSet, ObjectsAlreadySerialized);
 
 		for (int32 i = 0; i < Materials.Num(); i++) {
 			const TSharedPtr<FJsonObject> MaterialObject = Materials[i]->AsObject();
 			const int32 MaterialInterface = MaterialObject->GetIntegerField(TEXT("MaterialInterface"));
-			GetObjectSerializer()->CollectObjectPackages(MaterialInterface, OutReferencedPackages);
+			GetObjectSerializer()->CollectObjectPackages(MaterialInterface, OutReferencedPackages, ReferencedPackageSet, ObjectsAlreadySerialized);
 		}
 		
 		for (const FString& DependencyPackageName : OutReferencedPackages) {
@@ -22,7 +22,7 @@ void UTexture2DGenerator::OnExistingPackageLoaded() {
 	UObjectHierarchySerializer* InObjectSerializer = GetObjectSerializer();
 	UTexture2D* ExistingTexture = GetAsset<UTexture2D>();
 
-	if (!IsTextureUpToDate(ExistingTexture, InObjectSerializer, GetAssetData(), IsGeneratingPublicProject())) {
+	if (!IsTextureUpToDate(ExistingTexture, InObjectSerializer, GetAssetData(), GetPayloadHashAlgorithm(), IsGeneratingPublicProject())) {
 		UE_LOG(LogAssetGenerator, Log, TEXT("Refreshing source art data for Texture2D %s, signature or properties changed"), *ExistingTexture->GetPathName());
 		RebuildTextureData(ExistingTexture);
 	}
@@ -36,30 +36,27 @@ void UTexture2DGenerator::RebuildTextureData(UTexture2D* Texture) {
 }
 
 
-FString UTexture2DGenerator::ComputeTextureHash(UTexture2D* Texture) {
+FString UTexture2DGenerator::ComputeTextureHash(UTexture2D* Texture, EPayloadHashAlgorithm PayloadHashAlgorithm) {
 	TArray64<uint8> OutSourceMipMapData;
 	check(Texture->Source.GetMipData(OutSourceMipMapData, 0));
 
-	FString TextureHash = FMD5::HashBytes(OutSourceMipMapData.GetData(), OutSourceMipMapData.Num() * sizeof(uint8));
-	TextureHash.Append(FString::Printf(TEXT("%llx"), OutSourceMipMapData.Num()));
-	return TextureHash;
+	return FPayloadHasher::HashPayload(OutSourceMipMapData, PayloadHashAlgorithm);
 }
 
-FString ComputeBlankTextureHash(const int64 TextureSize) {
-	static TMap<int64, FString> PrecomputedCaches;
+FString ComputeBlankTextureHash(const int64 TextureSize, EPayloadHashAlgorithm PayloadHashAlgorithm) {
+	static TMap<TPair<int64, uint8>, FString> PrecomputedCaches;
+	const TPair<int64, uint8> CacheKey(TextureSize, (uint8) PayloadHashAlgorithm);
 
-	if (!PrecomputedCaches.Contains(TextureSize)) {
+	if (!PrecomputedCaches.Contains(CacheKey)) {
 		TArray64<uint8> BlankDataArray;
 		BlankDataArray.AddUninitialized(TextureSize);
 		FMemory::Memset(BlankDataArray.GetData(), 0xFF, TextureSize);
 
-		FString TextureHash = FMD5::HashBytes(BlankDataArray.GetData(), BlankDataArray.Num() * sizeof(uint8));
-		TextureHash.Append(FString::Printf(TEXT("%llx"), BlankDataArray.Num()));
-
-		PrecomputedCaches.Add(TextureSize, TextureHash);
+		const FString TextureHash = FPayloadHasher::HashPayload(BlankDataArray, PayloadHashAlgorithm);
+		PrecomputedCaches.Add(CacheKey, TextureHash);
 		return TextureHash;
 	}
-	return PrecomputedCaches.FindChecked(TextureSize);	
+	return PrecomputedCaches.FindChecked(CacheKey);	
 }
 
 void FillBlankTextureData(UTexture2D* Texture) {
@@ -133,15 +130,15 @@ void UTexture2DGenerator::RebuildTextureData(UTexture2D* Texture, const FString&
 	Texture->UpdateResource();
 }
 
-bool UTexture2DGenerator::IsTextureUpToDate(UTexture2D* ExistingTexture, UObjectHierarchySerializer* ObjectSerializer, const TSharedPtr<FJsonObject> AssetData, const bool bIsPublicProject) {
+bool UTexture2DGenerator::IsTextureUpToDate(UTexture2D* ExistingTexture, UObjectHierarchySerializer* ObjectSerializer, const TSharedPtr<FJsonObject> AssetData, EPayloadHashAlgorithm PayloadHashAlgorithm, const bool bIsPublicProject) {
 	const TSharedRef<FJsonObject> TextureProperties = AssetData->GetObjectField(TEXT("AssetObjectData")).ToSharedRef();
 	FString SourceFileHash = AssetData->GetStringField(TEXT("SourceImageHash"));
-	const FString CurrentFileHash = ComputeTextureHash(ExistingTexture);
+	const FString CurrentFileHash = ComputeTextureHash(ExistingTexture, PayloadHashAlgorithm);
 
 	//Override source file hash with blank texture hash if we're doing public project build
 	if (bIsPublicProject) {
 		const int64 MipMapSize = ExistingTexture->Source.CalcMipSize(0);
-		SourceFileHash = ComputeBlankTextureHash(MipMapSize);
+		SourceFileHash = ComputeBlankTextureHash(MipMapSize, PayloadHashAlgorithm);
 	}
 
 	//Return false if texture source art data does not match
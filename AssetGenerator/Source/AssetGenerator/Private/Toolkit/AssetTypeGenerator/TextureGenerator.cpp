@@ -27,7 +27,7 @@ void UTextureGenerator::OnExistingPackageLoaded() {
 		UpdateTextureInfo(Asset);
 	}
 
-	const FString ExistingTextureHash = ComputeTextureHash(Asset);
+	const FString ExistingTextureHash = ComputeTextureHash(Asset, GetPayloadHashAlgorithm());
 
 	const int32 TextureWidth = GetAssetData()->GetIntegerField(TEXT("TextureWidth"));
 	const int32 TextureHeight = GetAssetData()->GetIntegerField(TEXT("TextureHeight"));
@@ -37,7 +37,7 @@ void UTextureGenerator::OnExistingPackageLoaded() {
 	if (!IsGeneratingPublicProject()) {
 		NewTextureHash = GetAssetData()->GetStringField(TEXT("SourceImageHash"));
 	} else {
-		NewTextureHash = ComputeBlankTextureHash(TextureWidth, TextureHeight, NumSlices);
+		NewTextureHash = ComputeBlankTextureHash(TextureWidth, TextureHeight, NumSlices, GetPayloadHashAlgorithm());
 	}
 
 	if (ExistingTextureHash != NewTextureHash) {
@@ -90,13 +90,11 @@ void UTextureGenerator::SetTextureSourceToDumpFile(UTexture* Texture) {
 	Texture->Source.UnlockMip(0);
 }
 
-FString UTextureGenerator::ComputeTextureHash(UTexture* Texture) {
+FString UTextureGenerator::ComputeTextureHash(UTexture* Texture, EPayloadHashAlgorithm PayloadHashAlgorithm) {
 	TArray64<uint8> OutSourceMipMapData;
 	check(Texture->Source.GetMipData(OutSourceMipMapData, 0));
 
-	FString TextureHash = FMD5::HashBytes(OutSourceMipMapData.GetData(), OutSourceMipMapData.Num() * sizeof(uint8));
-	TextureHash.Append(FString::Printf(TEXT("%llx"), OutSourceMipMapData.Num()));
-	return TextureHash;
+	return FPayloadHasher::HashPayload(OutSourceMipMapData, PayloadHashAlgorithm);
 }
 
 void UTextureGenerator::SetTextureSourceToWhite(UTexture* Texture) {
@@ -107,22 +105,21 @@ void UTextureGenerator::SetTextureSourceToWhite(UTexture* Texture) {
 	Texture->Source.UnlockMip(0);
 }
 
-FString UTextureGenerator::ComputeBlankTextureHash(int32 Width, int32 Height, int32 NumTextures) {
-	static TMap<int64, FString> PrecomputedCaches;
+FString UTextureGenerator::ComputeBlankTextureHash(int32 Width, int32 Height, int32 NumTextures, EPayloadHashAlgorithm PayloadHashAlgorithm) {
+	static TMap<TPair<int64, uint8>, FString> PrecomputedCaches;
 	const int64 TextureSize = Width * Height * NumTextures;
+	const TPair<int64, uint8> CacheKey(TextureSize, (uint8) PayloadHashAlgorithm);
 
-	if (!PrecomputedCaches.Contains(TextureSize)) {
+	if (!PrecomputedCaches.Contains(CacheKey)) {
 		TArray64<uint8> BlankDataArray;
 		BlankDataArray.AddUninitialized(TextureSize);
 		FMemory::Memset(BlankDataArray.GetData(), 0xFF, TextureSize);
 
-		FString TextureHash = FMD5::HashBytes(BlankDataArray.GetData(), BlankDataArray.Num() * sizeof(uint8));
-		TextureHash.Append(FString::Printf(TEXT("%llx"), BlankDataArray.Num()));
-
-		PrecomputedCaches.Add(TextureSize, TextureHash);
+		const FString TextureHash = FPayloadHasher::HashPayload(BlankDataArray, PayloadHashAlgorithm);
+		PrecomputedCaches.Add(CacheKey, TextureHash);
 		return TextureHash;
 	}
-	return PrecomputedCaches.FindChecked(TextureSize);	
+	return PrecomputedCaches.FindChecked(CacheKey);	
 }
 
 
@@ -68,6 +68,8 @@ void UUserDefinedStructGenerator::PopulateStructWithData(UUserDefinedStruct* Str
 	//Force struct recompilation
 	Struct->Status = EUserDefinedStructureStatus::UDSS_Dirty;
     FStructureEditorUtils::CompileStructure(Struct);
+    //Struct layout changes are propagated into everything using the struct, so drop all of the cached serialization plans
+    FStructSerializationPlanCache::Get().InvalidateAllPlans();
 	check(Struct->Status == EUserDefinedStructureStatus::UDSS_UpToDate);
 	
 	MarkAssetChanged();
@@ -154,6 +156,8 @@ void UUserDefinedStructGenerator::FinalizeAssetCDO() {
 		UE_LOG(LogAssetGenerator, Log, TEXT("Refreshed defaults values of UserDefinedStruct %s"), *Struct->GetPathName());
 		Struct->Status = EUserDefinedStructureStatus::UDSS_Dirty;
 		FStructureEditorUtils::CompileStructure(Struct);
+		//Struct layout changes are propagated into everything using the struct, so drop all of the cached serialization plans
+		FStructSerializationPlanCache::Get().InvalidateAllPlans();
 		
 		check(Struct->Status == EUserDefinedStructureStatus::UDSS_UpToDate);
 		MarkAssetChanged();
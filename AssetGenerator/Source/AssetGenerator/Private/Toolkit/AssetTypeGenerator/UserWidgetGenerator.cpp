@@ -119,14 +119,16 @@ void UUserWidgetGenerator::PopulateStageDependencies(TArray<FPackageDependency>&
 
 	if (GetCurrentStage() == EAssetGenerationStage::CDO_FINALIZATION) {
 		TArray<FString> AdditionalWidgetDependencies;
+		TSet<FString> AdditionalWidgetDependencySet;
+		TSet<int32> ObjectsAlreadySerialized;
 		const TSharedPtr<FJsonObject> AssetObjectData = GetAssetData()->GetObjectField(TEXT("AssetObjectData"));
 
 		const int32 WidgetTreeObject = AssetObjectData->GetIntegerField(TEXT("WidgetTree"));
-		GetObjectSerializer()->CollectObjectPackages(WidgetTreeObject, AdditionalWidgetDependencies);
+		GetObjectSerializer()->CollectObjectPackages(WidgetTreeObject, AdditionalWidgetDependencies, AdditionalWidgetDependencySet, ObjectsAlreadySerialized);
 
 		const TArray<TSharedPtr<FJsonValue>> Animations = AssetObjectData->GetArrayField(TEXT("Animations"));
 		for (const TSharedPtr<FJsonValue>& AnimationValue : Animations) {
-			GetObjectSerializer()->CollectObjectPackages((int32) AnimationValue->AsNumber(), AdditionalWidgetDependencies);
+			GetObjectSerializer()->CollectObjectPackages((int32) AnimationValue->AsNumber(), AdditionalWidgetDependencies, AdditionalWidgetDependencySet, ObjectsAlreadySerialized);
 		}
 
 		for (const FString& PackageName : AdditionalWidgetDependencies) {
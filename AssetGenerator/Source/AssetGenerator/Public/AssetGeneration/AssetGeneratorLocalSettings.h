@@ -25,7 +25,7 @@ public:
 	UPROPERTY(VisibleAnywhere, Config, Category = "Asset Generator")
 	TSet<FName> WhitelistedAssetCategories;
 
-	/** Maximum amount of asset generators to advance in one tick */
+	/** Minimum amount of asset generators to advance in one tick, more are advanced if there is time left in the tick */
 	UPROPERTY(EditAnywhere, Config, Category = "Asset Generator")
 	int32 MaxAssetsToAdvancePerTick;
 	
@@ -0,0 +1,59 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Dom/JsonObject.h"
+#include "HAL/ThreadSafeCounter64.h"
+
+/** Asset dump file read and parsed ahead of time by the worker thread */
+struct ASSETGENERATOR_API FPrefetchedAssetDump {
+public:
+	/** Path to the asset dump file, resolved on the worker thread when it has not been known in advance */
+	FString AssetDumpFilePath;
+	/** Parsed contents of the asset dump file, invalid if the file does not exist or cannot be read */
+	TSharedPtr<FJsonObject> RootFileObject;
+	/** Size of the asset dump file, in bytes */
+	int64 FileSize;
+	/** Estimated memory occupied by the parsed dump file, reserved from the prefetcher memory budget until it is consumed */
+	int64 ReservedBytes;
+
+	FPrefetchedAssetDump();
+};
+
+/**
+ * Reads and parses asset dump files of the packages that are going to be generated soon on the worker threads
+ * Only the construction of the asset generator itself remains on the game thread, since it creates UObjects
+ * Estimated amount of memory occupied by the prefetched files is bounded, so prefetching never runs too far ahead of the generation
+ */
+class ASSETGENERATOR_API FAssetDumpPrefetcher {
+private:
+	FString DumpRootDirectory;
+	/** Maximum estimated memory occupied by the parsed dump files requested and not consumed yet */
+	int64 MaxPrefetchedBytes;
+	/** Dump files requested for prefetching and not consumed yet */
+	TMap<FName, TFuture<FPrefetchedAssetDump>> PendingDumps;
+	/** Estimated memory reserved by the dump files requested and not consumed yet, based on the parsed size of the dump files */
+	FThreadSafeCounter64 ReservedBytes;
+public:
+	FAssetDumpPrefetcher(const FString& DumpRootDirectory, int64 MaxPrefetchedBytes);
+	~FAssetDumpPrefetcher();
+
+	/** Returns true if there is enough memory budget left to prefetch more dump files */
+	bool CanPrefetchMore() const;
+
+	/**
+	 * Starts reading the dump file of the provided package on the worker thread. Empty dump file path means it is resolved by the worker
+	 * Dump file size, if known, is used to reserve memory budget for the parsed file before the worker starts reading it
+	 */
+	void RequestPrefetch(FName PackageName, const FString& AssetDumpFilePath, int64 DumpFileSize);
+
+	/**
+	 * Retrieves prefetched dump file of the provided package, waiting for the worker to finish reading it if it is still in progress
+	 * Returns false if the package has not been requested for prefetching, in which case it should be read directly
+	 */
+	bool ConsumePrefetchedDump(FName PackageName, FPrefetchedAssetDump& OutPrefetchedDump);
+
+	/** Drops prefetched dump file of the package if it has not been consumed, e.g because package has been skipped */
+	void DiscardPrefetchedDump(FName PackageName);
+
+	FORCEINLINE int32 GetNumPendingDumps() const { return PendingDumps.Num(); }
+};
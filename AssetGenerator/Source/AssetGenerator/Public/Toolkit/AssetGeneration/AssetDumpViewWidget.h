@@ -1,6 +1,8 @@
 #pragma once
 #include "Slate.h"
 
+class FAssetDumpManifest;
+
 struct ASSETGENERATOR_API FAssetDumpTreeNode : TSharedFromThis<FAssetDumpTreeNode> {
 public:
 	/** Root directory path */
@@ -13,6 +15,8 @@ public:
 	FString PackageName;
 	/** Last fragment of the path, representing package short name */
 	FString NodeName;
+	/** Manifest of the asset dump, if it has one. Used to list packages and retrieve their classes without reading the files */
+	TSharedPtr<FAssetDumpManifest> DumpManifest;
 	
 	FAssetDumpTreeNode();
 private:
@@ -31,6 +35,7 @@ private:
 	TArray<TSharedPtr<FAssetDumpTreeNode>> Children;
 	
     void RegenerateChildren();
+	void RegenerateChildrenFromManifest();
 	TSharedPtr<FAssetDumpTreeNode> MakeChildNode();
 	FString ComputeAssetClass();
 public:
@@ -1,13 +1,12 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "Toolkit/AssetGeneration/AssetTypeGenerator.h"
+#include "Toolkit/AssetGeneration/AssetGenerationScheduler.h"
+#include "Toolkit/AssetGeneration/AssetDumpPrefetcher.h"
+#include "Toolkit/AssetGeneration/AssetPackageSaveCoordinator.h"
 
 class SNotificationItem;
-
-struct FDependencyList {
-	UAssetTypeGenerator* AssetTypeGenerator;
-	TMap<FName, EAssetGenerationStage> PackageDependencies;
-};
+class FAssetDumpManifest;
 
 enum class EAddPackageResult {
 	PACKAGE_EXISTS,
@@ -15,19 +14,41 @@ enum class EAddPackageResult {
 	PACKAGE_NOT_FOUND
 };
 
+/** Determines what asset generator does when all of the remaining generators are waiting for each other */
+enum class EDependencyCyclePolicy : uint8 {
+	/** Report the cycles and stop the generation */
+	FATAL,
+	/** Report the cycles and drop the dependency requiring the earliest stage in each one of them, so generation can continue */
+	RELAX_WEAKEST_DEPENDENCY
+};
+
 /** Describes configuration for the asset generator */
 struct ASSETGENERATOR_API FAssetGeneratorConfiguration {
 public:
 	/** Root directory for the source asset dump */
 	FString DumpRootDirectory;
-	/** Maximum amount of asset generators to advance in one tick */
+	/** Minimum amount of asset generators to advance in one tick, if there are enough of them ready */
 	int32 MaxAssetsToAdvancePerTick;
+	/** Once MaxAssetsToAdvancePerTick generators have been advanced, ready generators keep being advanced until this amount of seconds is spent in the tick */
+	float MaxTickTimeSeconds;
+	/** Maximum amount of upcoming packages which dump files are read and parsed ahead of time on the worker threads */
+	int32 MaxPrefetchedDumpFiles;
+	/** Maximum estimated memory occupied by the parsed dump files read ahead of time and not used yet, in bytes */
+	int64 MaxPrefetchedDumpBytes;
+	/** Amount of changed packages written to disk together, packages are also written before garbage collection and when generation is finished */
+	int32 MaxPackagesPerSaveBatch;
 	/** True to refresh existing assets, false to completely ignore assets already present */
 	bool bRefreshExistingAssets;
 	/** True to generate public project, with all of the non-redistributable asset files replaced with stubs */
 	bool bGeneratePublicProject;
 	/** If true, ticking will be performed manually by the external code like commandlet, and tickable game object logic will be fully ignored */
 	bool bTickOnTheSide;
+	/** What to do when generation cannot continue because of the dependency cycles */
+	EDependencyCyclePolicy DependencyCyclePolicy;
+	/** Path to the file dependency cycles are written into when they are encountered */
+	FString DependencyCycleReportPath;
+	/** Manifest of the asset dump if it has already been loaded. Otherwise it will be loaded from the dump root directory */
+	TSharedPtr<FAssetDumpManifest> DumpManifest;
 
 	FAssetGeneratorConfiguration();
 };
@@ -69,12 +90,12 @@ private:
 	
 	/** Configuration for the asset generator */
 	FAssetGeneratorConfiguration Configuration;
+	/** Manifest of the asset dump, used to locate dump files without probing the disk. Can be invalid for dumps without manifest */
+	TSharedPtr<FAssetDumpManifest> DumpManifest;
 	/** Package name mapping to it's active asset generator */
 	TMap<FName, UAssetTypeGenerator*> AssetGenerators;
-	/** Maps package name to the list of dependencies waiting for it's generation */
-	TMap<FName, TArray<TSharedPtr<FDependencyList>>> PendingDependencies;
-	/** Generators which dependencies have been fully satisfied are added here, they will be advanced next tick */
-	TArray<UAssetTypeGenerator*> GeneratorsReadyToAdvance;
+	/** Tracks dependencies between generator stages and decides which generators are advanced next */
+	FAssetGenerationScheduler Scheduler;
 	/** External packages checked to exist are added here and checked quickly */
 	TSet<FName> ExternalPackagesResolved;
 	/** Packages that have been generated before are listed here */
@@ -87,12 +108,20 @@ private:
 	TArray<FName> PackagesToGenerate;
 	/** Index of the next package to generate */
 	int32 NextPackageToGenerateIndex;
+	/** Reads dump files of the packages to generate ahead of time */
+	TUniquePtr<FAssetDumpPrefetcher> DumpPrefetcher;
+	/** Index of the next package to request dump file prefetch for */
+	int32 NextPackageToPrefetchIndex;
+	/** Writes packages changed by the finished generators to disk in batches */
+	TUniquePtr<FAssetPackageSaveCoordinator> PackageSaveCoordinator;
 	/** True when generation has been finished */
 	bool bGenerationFinished;
 	/** True if next tick is gonna be first one */
 	bool bIsFirstTick;
 	/** Statics for current asset generation process */
 	FAssetGenStatistics Statistics;
+	/** Dependency cycles encountered during generation so far, written into the cycle report */
+	TArray<FAssetGenerationCycle> DependencyCycles;
 	/** Notification shown to indicate asset generation progress */
 	TSharedPtr<SNotificationItem> NotificationItem;
 
@@ -113,12 +142,20 @@ private:
 	void OnGeneratorStageAdvanced(UAssetTypeGenerator* Generator);
 	/** Cleans up asset generator for the provided asset and then removes it */
 	void CleanupAssetGenerator(UAssetTypeGenerator* Generator);
+	/** Queues packages changed by the finished generator for saving */
+	void QueueChangedPackagesForSaving(UAssetTypeGenerator* Generator);
 	/** Adds new package to asset generator */
 	EAddPackageResult AddPackage(FName PackageName);
+	/** Requests prefetching of the dump files for the packages that will be generated next */
+	void PrefetchUpcomingAssetDumps();
 	/** Called to find new packages for asset generation */
 	bool GatherNewAssetsForGeneration();
 	/** Called when asset generation is finished */
 	void OnAssetGenerationFinished();
+	/** Called when no generator can be advanced while some are still waiting. Reports dependency cycles and breaks them if configuration allows it */
+	void HandleDependencyCycles();
+	/** Writes all dependency cycles encountered so far into the cycle report file */
+	void WriteDependencyCycleReport() const;
 	/** Prints current state of the asset generator into the log */
 	void PrintStateIntoTheLog();
 	/** Ticks asset generation and optionally terminates it when finished */
@@ -135,6 +172,8 @@ private:
 public:
 	FORCEINLINE bool HasFinishedAssetGeneration() const { return bGenerationFinished; }
 	FORCEINLINE const FAssetGenStatistics& GetStatistics() const { return Statistics; } 
+	FORCEINLINE const FAssetGenerationGraphStatistics& GetGraphStatistics() const { return Scheduler.GetStatistics(); }
+	FORCEINLINE const FAssetPackageSaveStatistics& GetSaveStatistics() const { return PackageSaveCoordinator->GetStatistics(); }
 	
 	/** Returns currently active instance of the asset generator */
 	FORCEINLINE static TSharedPtr<FAssetGenerationProcessor> GetActiveAssetGenerator() {
@@ -146,6 +185,15 @@ public:
 
 	/** Called manually from the commandlet, gives back some information */
 	void TickOnTheSide(int32& PackagesGeneratedThisTick);
+
+	/**
+	 * Writes changed packages of the finished generators to disk, e.g before garbage collection
+	 * Packages with materials still compiling are only written if requested, otherwise they are kept until their shaders are ready
+	 */
+	void FlushPendingPackageSaves(bool bIncludeCompilingPackages);
+
+	/** Returns amount of changed packages that have not been written to disk yet */
+	FORCEINLINE int32 GetNumPendingPackageSaves() const { return PackageSaveCoordinator->GetNumPendingPackages(); }
 	
 	//Begin FTickableGameObject
 	virtual void Tick(float DeltaTime) override;
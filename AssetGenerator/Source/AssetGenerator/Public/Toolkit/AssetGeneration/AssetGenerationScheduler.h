@@ -0,0 +1,159 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Toolkit/AssetGeneration/AssetTypeGenerator.h"
+
+/** Amount of distinct priorities in the ready queue, critical path lengths above that share the highest priority */
+#define ASSET_GENERATION_SCHEDULER_PRIORITY_LEVELS 128
+
+/** Identifies a single generation stage of the package in the generation graph */
+struct ASSETGENERATOR_API FAssetGenerationNodeKey {
+public:
+	FName PackageName;
+	EAssetGenerationStage Stage;
+
+	FORCEINLINE FAssetGenerationNodeKey(FName PackageName, EAssetGenerationStage Stage) : PackageName(PackageName), Stage(Stage) {}
+
+	FORCEINLINE bool operator==(const FAssetGenerationNodeKey& Other) const {
+		return PackageName == Other.PackageName && Stage == Other.Stage;
+	}
+};
+
+FORCEINLINE uint32 GetTypeHash(const FAssetGenerationNodeKey& Key) {
+	return HashCombine(GetTypeHash(Key.PackageName), (uint32) Key.Stage);
+}
+
+/** Single stage taking part in the dependency cycle, waiting for the stage following it in the cycle */
+struct ASSETGENERATOR_API FAssetGenerationCycleEntry {
+public:
+	FName PackageName;
+	EAssetGenerationStage Stage;
+	/** True if the stage has not been reached yet, and it waits for the generator of the same package to advance rather than for the other package */
+	bool bWaitsForOwnGenerator;
+};
+
+/** Dependency cycle found in the generation graph */
+struct ASSETGENERATOR_API FAssetGenerationCycle {
+public:
+	/** Stages forming the cycle, every one waiting for the next one, and the last one waiting for the first one */
+	TArray<FAssetGenerationCycleEntry> Entries;
+	/** Amount of stages in the strongly connected component of the graph the cycle has been found in */
+	int32 ComponentSize;
+	/** Index of the entry which dependency on the next entry has been relaxed to break the cycle, or INDEX_NONE */
+	int32 RelaxedEntryIndex;
+
+	FAssetGenerationCycle();
+};
+
+/** Describes shape of the generation graph, used to tune asset generation on large asset dumps */
+struct ASSETGENERATOR_API FAssetGenerationGraphStatistics {
+public:
+	/** Amount of package stages scheduled, including the ones that have only been depended on */
+	int32 TotalNodes;
+	/** Amount of dependencies between package stages that had to be waited for */
+	int32 TotalEdges;
+	/** Maximum amount of package stages that were ready to be advanced at the same time */
+	int32 MaxReadyNodes;
+	/** Amount of package stages in the longest chain of stages that had to be completed one after another */
+	int32 LongestChain;
+	/** Package which stage ends the longest chain */
+	FName LongestChainPackage;
+	/** Amount of dependencies dropped to break dependency cycles */
+	int32 RelaxedDependencies;
+
+	FAssetGenerationGraphStatistics();
+};
+
+/**
+ * Schedules asset generator stages according to the dependencies between them
+ * Every node of the graph is a single stage of the package generation, which depends on the stages of the other packages
+ * Dependencies of the stage are only known once generator enters it, so the graph is built incrementally as generation goes
+ * Stages with all of the dependencies completed are put into the ready queue, ordered by the length of the chain of stages
+ * waiting for them, so stages blocking most of the remaining work are advanced first
+ */
+class ASSETGENERATOR_API FAssetGenerationScheduler {
+private:
+	struct FNode {
+		FName PackageName;
+		EAssetGenerationStage Stage;
+		/** Generator that entered this stage, NULL while the stage is only depended on by the other stages */
+		UAssetTypeGenerator* Generator;
+		/** Nodes waiting for this stage to be completed */
+		TArray<int32> Dependents;
+		/** Nodes this stage has been waiting for, including already completed ones */
+		TArray<int32> Dependencies;
+		/** Amount of dependencies that have not been completed yet */
+		int32 UnresolvedDependencies;
+		/** Estimated amount of stages that can only be completed after this one, used as the priority */
+		int32 CriticalPathLength;
+		/** Amount of stages in the longest chain of completed dependencies ending with this stage */
+		int32 ChainLength;
+		/** Priority this node has been queued with, or INDEX_NONE if it is not in the ready queue */
+		int32 QueuedPriority;
+		bool bCompleted;
+	};
+
+	/** Queue of the ready nodes with the same priority, consumed from the head */
+	struct FReadyBucket {
+		TArray<int32> Nodes;
+		int32 Head;
+	};
+
+	TArray<FNode> Nodes;
+	/** Maps package stage to the node representing it */
+	TMap<FAssetGenerationNodeKey, int32> NodeIndices;
+	/** Maps package to the node of the stage it's generator is currently at */
+	TMap<FName, int32> ActiveNodes;
+	FReadyBucket ReadyBuckets[ASSET_GENERATION_SCHEDULER_PRIORITY_LEVELS];
+	/** Highest priority that can have ready nodes, or INDEX_NONE if the ready queue is empty */
+	int32 HighestReadyPriority;
+	int32 NumReadyNodes;
+	FAssetGenerationGraphStatistics Statistics;
+
+	int32 FindOrAddNode(FName PackageName, EAssetGenerationStage Stage);
+	void EnqueueReadyNode(int32 NodeIndex);
+	/** Raises critical path length of the node and propagates it to everything the node is waiting for */
+	void RaiseCriticalPathLength(int32 NodeIndex, int32 NewCriticalPathLength);
+	/** Appends nodes that have to be completed before the provided node can be advanced */
+	void GetWaitedNodes(int32 NodeIndex, TArray<int32>& OutNodeIndices) const;
+	/** Finds a cycle going through the nodes of the provided strongly connected component */
+	void ExtractCycleFromComponent(const TArray<int32>& ComponentNodes, FAssetGenerationCycle& OutCycle) const;
+public:
+	FAssetGenerationScheduler();
+
+	/**
+	 * Adds node for the stage generator is currently at, waiting for the provided stages of the other packages to be completed
+	 * Only dependencies on stages that have not been completed yet should be provided
+	 * Generator is queued for advancing instantly if there is nothing to wait for
+	 */
+	void ScheduleGeneratorStage(UAssetTypeGenerator* Generator, const TMap<FName, EAssetGenerationStage>& WaitingDependencies);
+
+	/** Marks the provided stage of the generator completed, queueing dependents which have no other dependencies left */
+	void OnGeneratorStageCompleted(UAssetTypeGenerator* Generator, EAssetGenerationStage CompletedStage);
+
+	/** Removes generator with the highest priority from the ready queue and returns it, or returns NULL if queue is empty */
+	UAssetTypeGenerator* DequeueReadyGenerator();
+
+	/** Returns true if there are any stages waiting for the provided package */
+	bool HasWaitingDependents(FName PackageName) const;
+
+	/** Drops all nodes of the finished package, stages still waiting for it will never be completed */
+	void RemovePackage(FName PackageName);
+
+	/**
+	 * Finds strongly connected components of the stages waiting for each other, and appends one cycle for each of them
+	 * Should be called when there are no ready generators left, because every component found is a deadlock
+	 */
+	void FindDependencyCycles(TArray<FAssetGenerationCycle>& OutCycles) const;
+
+	/**
+	 * Drops the weakest dependency between the packages in the cycle, e.g the one requiring the earliest stage of the dependency
+	 * Dependent stage is queued for advancing if it has nothing else to wait for. Returns false if there is no dependency that can be dropped
+	 */
+	bool RelaxWeakestDependency(FAssetGenerationCycle& Cycle);
+
+	/** Prints ready and waiting stages into the log */
+	void PrintStateIntoTheLog() const;
+
+	FORCEINLINE int32 GetNumReadyGenerators() const { return NumReadyNodes; }
+	FORCEINLINE const FAssetGenerationGraphStatistics& GetStatistics() const { return Statistics; }
+};
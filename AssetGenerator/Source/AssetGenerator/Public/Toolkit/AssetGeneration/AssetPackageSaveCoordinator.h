@@ -0,0 +1,65 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+
+class UMaterialInterface;
+
+/** Describes how the packages changed during asset generation have been written to disk */
+struct ASSETGENERATOR_API FAssetPackageSaveStatistics {
+public:
+	/** Amount of distinct packages written to disk */
+	int32 PackagesSaved;
+	/** Amount of times a package had to be written again after it has already been saved, e.g skeleton shared by multiple meshes */
+	int32 PackagesResaved;
+	/** Amount of batches the packages have been written in */
+	int32 SaveBatches;
+	/** Total size of the package files written, in bytes */
+	int64 BytesWritten;
+
+	FAssetPackageSaveStatistics();
+};
+
+/**
+ * Collects packages changed by the asset generators and writes them to disk in batches
+ * Generators no longer save their packages after every stage, instead packages are queued once generator is finished,
+ * so each package is normally written only once per run. Queued packages are kept alive through garbage collection
+ * until they are saved, which happens once enough of them are queued, or when the owner decides it is a good time to do so
+ * Packages containing materials which shaders are still being compiled are held back until compilation is finished,
+ * so generation can go on while shaders compile in the background
+ */
+class ASSETGENERATOR_API FAssetPackageSaveCoordinator : public FGCObject {
+private:
+	/** Amount of queued packages that triggers writing a batch */
+	int32 MaxPackagesPerBatch;
+	/** Packages waiting to be saved, in the order they have been queued */
+	TArray<UPackage*> PendingPackages;
+	/** Same packages as above, used to quickly discard packages queued multiple times */
+	TSet<UPackage*> PendingPackageSet;
+	/** Queued packages which materials are still compiling shaders, along with the materials that are not ready yet */
+	TMap<UPackage*, TArray<UMaterialInterface*>> CompilingPackageMaterials;
+	/** Names of the packages that have already been written during this run */
+	TSet<FName> SavedPackageNames;
+	FAssetPackageSaveStatistics Statistics;
+
+	/** Re-checks materials of the packages held back for shader compilation, releasing packages which shaders are ready */
+	void UpdateCompilingPackages();
+public:
+	explicit FAssetPackageSaveCoordinator(int32 MaxPackagesPerBatch);
+
+	/** Queues package for saving. Package queued multiple times before the next flush is only written once */
+	void QueuePackage(UPackage* Package);
+
+	/** Returns true if enough packages ready to be saved have been queued to write a full batch */
+	bool ShouldFlush();
+
+	/** Writes queued packages to disk in a single batch. Packages with materials still compiling are only written if requested */
+	void Flush(bool bIncludeCompilingPackages);
+
+	FORCEINLINE int32 GetNumPendingPackages() const { return PendingPackages.Num(); }
+	FORCEINLINE const FAssetPackageSaveStatistics& GetStatistics() const { return Statistics; }
+
+	//Begin FGCObject
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override;
+	//End FGCObject
+};
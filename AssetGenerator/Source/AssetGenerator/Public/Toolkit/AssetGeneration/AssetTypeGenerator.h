@@ -1,6 +1,7 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "Dom/JsonObject.h"
+#include "Util/PayloadHasher.h"
 #include "AssetTypeGenerator.generated.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogAssetGenerator, Log, All);
@@ -35,6 +36,10 @@ class ASSETGENERATOR_API UAssetTypeGenerator : public UObject {
 private:
 	FString DumpRootDirectory;
 	FString PackageBaseDirectory;
+	/** Maps names of the side files stored in the dump blob store to their paths relative to the dump root */
+	TMap<FString, FString> BlobFiles;
+	/** Algorithm used by the asset dumper to hash asset payloads, like texture source data */
+	EPayloadHashAlgorithm PayloadHashAlgorithm;
     FName PackageName;
 	FName AssetName;
     TSharedPtr<FJsonObject> AssetData;
@@ -53,6 +58,9 @@ private:
 	UPackage* AssetPackage;
 	UPROPERTY()
 	UObject* AssetObject;
+	/** Packages changed by this generator that have not been saved yet */
+	UPROPERTY()
+	TArray<UPackage*> PackagesPendingSave;
 
 	/** Initializes this asset generator instance with the file data */
 	void InitializeInternal(const FString& DumpRootDirectory, const FString& PackageBaseDirectory, FName PackageName, TSharedPtr<FJsonObject> RootFileObject, bool bGeneratePublicProject);
@@ -85,6 +93,9 @@ protected:
 
 	FORCEINLINE const FString& GetRootDumpDirectory() const { return DumpRootDirectory; }
 
+	/** Returns algorithm that should be used for computing payload hashes comparable with the ones in the asset dump */
+	FORCEINLINE EPayloadHashAlgorithm GetPayloadHashAlgorithm() const { return PayloadHashAlgorithm; }
+
 	/** Adds assets referenced by the asset object through referenced objects */
 	void PopulateReferencedObjectsDependencies(TArray<FPackageDependency>& OutDependencies) const;
 
@@ -126,6 +137,12 @@ public:
 	/** Returns asset package created by CreateAssetPackage or loaded from the disk */
 	FORCEINLINE UPackage* GetAssetPackage() const { return AssetPackage; }
 
+	/** Returns packages changed during the generation, which should be saved once generation is finished */
+	FORCEINLINE const TArray<UPackage*>& GetPackagesPendingSave() const { return PackagesPendingSave; }
+
+	/** Schedules package to be saved together with the packages of this generator once generation is finished */
+	FORCEINLINE void AddPackagePendingSave(UPackage* Package) { this->PackagesPendingSave.AddUnique(Package); }
+
 	template<typename T>
 	FORCEINLINE T* GetAsset() const { return CastChecked<T>(AssetObject); }
 
@@ -141,12 +158,21 @@ public:
 	/** Determines class of the asset this generator is capable of generating. Will be called on CDO, do not access any state here! */
 	virtual FName GetAssetClass() PURE_VIRTUAL(GetAssetClass, return NAME_None;);
 
-	/** Returns file path corresponding to the provided package in the root directory */
+	/** Returns file path corresponding to the provided package in the root directory. Binary dump files take priority over json ones */
 	static FString GetAssetFilePath(const FString& RootDirectory, FName PackageName);
 
+	/** Loads asset dump file into json object, handling both json and binary dump files. Returns invalid pointer on failure */
+	static TSharedPtr<FJsonObject> LoadAssetDumpFile(const FString& AssetDumpFilePath);
+
 	/** Tries to load asset generator state from the asset dump located under the provided root directory and having given package name */
 	static UAssetTypeGenerator* InitializeFromFile(const FString& RootDirectory, FName PackageName, bool bGeneratePublicProject);
 
+	/** Same as above, but with the path to the asset dump file already known, e.g retrieved from the dump manifest */
+	static UAssetTypeGenerator* InitializeFromFile(const FString& RootDirectory, FName PackageName, const FString& AssetDumpFilePath, bool bGeneratePublicProject);
+
+	/** Creates generator from the asset dump file that has already been loaded, e.g by the asset dump prefetcher. Must be called on the game thread */
+	static UAssetTypeGenerator* InitializeFromJson(const FString& RootDirectory, FName PackageName, const FString& AssetDumpFilePath, TSharedPtr<FJsonObject> RootFileObject, bool bGeneratePublicProject);
+
 	static TArray<TSubclassOf<UAssetTypeGenerator>> GetAllGenerators();
 
 	/** Finds generator capable of generating asset of the given class */
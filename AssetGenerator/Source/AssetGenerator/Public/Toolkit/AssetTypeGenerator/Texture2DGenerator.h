@@ -9,12 +9,13 @@ protected:
 	virtual void CreateAssetPackage() override;
 	virtual void OnExistingPackageLoaded() override;
 	void RebuildTextureData(class UTexture2D* Texture);
-	static FString ComputeTextureHash(UTexture2D* Texture);
+	static FString ComputeTextureHash(UTexture2D* Texture, EPayloadHashAlgorithm PayloadHashAlgorithm);
 public:
 	/** Checks whenever texture is up-to-date. Exposed to public because other assets often embed textures inside themselves */
 	static bool IsTextureUpToDate(UTexture2D* ExistingTexture,
 		UObjectHierarchySerializer* ObjectSerializer,
 		const TSharedPtr<FJsonObject> AssetData,
+		EPayloadHashAlgorithm PayloadHashAlgorithm,
 		bool bIsGeneratingPublicProject = false);
 
 	/** Rebuilds texture data for the provided texture using provided image file and asset data */
@@ -14,8 +14,8 @@ protected:
 	virtual void UpdateTextureSource(UTexture* Texture);
 	virtual void UpdateTextureInfo(UTexture* Texture);
 	
-	static FString ComputeTextureHash(UTexture* Texture);
-	static FString ComputeBlankTextureHash(int32 Width, int32 Height, int32 NumTextures);
+	static FString ComputeTextureHash(UTexture* Texture, EPayloadHashAlgorithm PayloadHashAlgorithm);
+	static FString ComputeBlankTextureHash(int32 Width, int32 Height, int32 NumTextures, EPayloadHashAlgorithm PayloadHashAlgorithm);
 
 	void SetTextureSourceToDumpFile(UTexture* Texture);
 	static void SetTextureSourceToWhite(UTexture* Texture);